@@ -24,10 +24,13 @@ in the source distribution for its full text.
 #include "Hashtable.h"
 #include "IncSet.h"
 #include "InfoScreen.h"
+#include "InstrumentScreen.h"
 #include "ListItem.h"
 #include "Macros.h"
 #include "MainPanel.h"
+#include "Meter.h"
 #include "OpenFilesScreen.h"
+#include "Platform.h"
 #include "Process.h"
 #include "ProcessLocksScreen.h"
 #include "ProvideCurses.h"
@@ -294,6 +297,11 @@ static Htop_Reaction actionToggleHideMeters(State* st) {
    return HTOP_RESIZE | HTOP_KEEP_FOLLOWING;
 }
 
+static Htop_Reaction actionCycleGraphResolution(ATTR_UNUSED State* st) {
+   Meter_cycleGraphResolution();
+   return HTOP_KEEP_FOLLOWING;
+}
+
 static Htop_Reaction actionExpandOrCollapseAllBranches(State* st) {
    Machine* host = st->host;
    ScreenSettings* ss = host->settings->ss;
@@ -312,7 +320,7 @@ static Htop_Reaction actionIncFilter(State* st) {
    Machine* host = st->host;
    IncSet* inc = (st->mainPanel)->inc;
    IncSet_activate(inc, INC_FILTER, (Panel*)st->mainPanel);
-   host->activeTable->incFilter = IncSet_filter(inc);
+   Table_setIncFilter(host->activeTable, IncSet_filter(inc));
    return HTOP_REFRESH | HTOP_KEEP_FOLLOWING;
 }
 
@@ -370,6 +378,14 @@ static inline void setActiveScreen(Settings* settings, State* st, unsigned int s
    Machine* host = st->host;
 
    settings->ss = settings->screens[ssIdx];
+   if (!settings->ss->table && settings->ss->dynamic) {
+      /* dynamic screen added in setup, start scanning its table */
+      Platform_addDynamicScreen(settings->ss);
+      if (settings->ss->table) {
+         Machine_addTable(host, settings->ss->table);
+         Table_setPanel(settings->ss->table, (Panel*) st->mainPanel);
+      }
+   }
    if (!settings->ss->table)
       settings->ss->table = host->processTable;
    host->activeTable = settings->ss->table;
@@ -643,6 +659,7 @@ static const struct {
    const char* info;
 } helpLeft[] = {
    { .key = "      #: ",  .roInactive = false, .info = "hide/show header meters" },
+   { .key = "      g: ",  .roInactive = false, .info = "cycle graph meter time resolution" },
    { .key = "    Tab: ",  .roInactive = false, .info = "switch to next screen tab" },
    { .key = " Arrows: ",  .roInactive = false, .info = "scroll process list" },
    { .key = " Digits: ",  .roInactive = false, .info = "incremental PID search" },
@@ -685,6 +702,7 @@ static const struct {
    { .key = "      x: ", .roInactive = false, .info = "list file locks of process" },
    { .key = "      s: ", .roInactive = true,  .info = "trace syscalls with strace" },
    { .key = "      w: ", .roInactive = false, .info = "wrap process command in multiple lines" },
+   { .key = "      D: ", .roInactive = false, .info = "show timings of htop's own refreshes" },
 #ifdef SCHEDULER_SUPPORT
    { .key = "      Y: ", .roInactive = true,  .info = "set scheduling policy" },
 #endif
@@ -887,6 +905,15 @@ static Htop_Reaction actionShowCommandScreen(State* st) {
    return HTOP_REFRESH | HTOP_REDRAW_BAR;
 }
 
+static Htop_Reaction actionShowInstrumentScreen(ATTR_UNUSED State* st) {
+   InstrumentScreen* is = InstrumentScreen_new();
+   InfoScreen_run((InfoScreen*)is);
+   InstrumentScreen_delete((Object*)is);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
 void Action_setBindings(Htop_Action* keys) {
    keys[' '] = actionTag;
    keys['#'] = actionToggleHideMeters;
@@ -901,6 +928,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['>'] = actionSetSortColumn;
    keys['?'] = actionHelp;
    keys['C'] = actionSetup;
+   keys['D'] = actionShowInstrumentScreen;
    keys['F'] = Action_follow;
    keys['H'] = actionToggleUserlandThreads;
    keys['I'] = actionInvertSortOrder;
@@ -924,6 +952,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['a'] = actionSetAffinity;
    keys['c'] = actionTagAllChildren;
    keys['e'] = actionShowEnvScreen;
+   keys['g'] = actionCycleGraphResolution;
    keys['h'] = actionHelp;
    keys['k'] = actionKill;
    keys['l'] = actionLsof;
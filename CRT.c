@@ -829,6 +829,8 @@ int CRT_scrollHAmount = 5;
 
 int CRT_scrollWheelVAmount = 10;
 
+uint64_t CRT_frameCount = 0;
+
 ColorScheme CRT_colorScheme = COLORSCHEME_DEFAULT;
 
 ATTR_NORETURN
@@ -1148,6 +1150,27 @@ IGNORE_WCASTQUAL_END
    CRT_degreeSign = initDegreeSign();
 }
 
+/* Set up what drawing rows needs, without taking over the terminal */
+void CRT_initHeadless(const Settings* settings, bool allowUnicode) {
+   CRT_settings = settings;
+   CRT_colorScheme = COLORSCHEME_MONOCHROME;
+   CRT_colors = CRT_colorSchemes[COLORSCHEME_MONOCHROME];
+
+#ifdef HAVE_LIBNCURSESW
+   CRT_utf8 = allowUnicode && String_eq(nl_langinfo(CODESET), "UTF-8");
+#else
+   (void) allowUnicode;
+#endif
+
+   CRT_treeStr =
+#ifdef HAVE_LIBNCURSESW
+      CRT_utf8 ? CRT_treeStrUtf8 :
+#endif
+      CRT_treeStrAscii;
+
+   CRT_degreeSign = initDegreeSign();
+}
+
 void CRT_done(void) {
    int resetColor = CRT_colors ? CRT_colors[RESET_COLOR] : CRT_colorSchemes[COLORSCHEME_DEFAULT][RESET_COLOR];
 
@@ -8,6 +8,7 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "Macros.h"
 #include "ProvideCurses.h"
@@ -198,6 +199,9 @@ extern int CRT_scrollHAmount;
 
 extern int CRT_scrollWheelVAmount;
 
+/* Number of screen updates, counted to measure what a single one costs */
+extern uint64_t CRT_frameCount;
+
 extern ColorScheme CRT_colorScheme;
 
 #ifdef HAVE_GETMOUSE
@@ -208,6 +212,8 @@ void CRT_setMouse(bool enabled);
 
 void CRT_init(const Settings* settings, bool allowUnicode, bool retainScreenOnExit);
 
+void CRT_initHeadless(const Settings* settings, bool allowUnicode);
+
 void CRT_done(void);
 
 void CRT_resetSignalHandlers(void);
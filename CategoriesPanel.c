@@ -74,7 +74,7 @@ static void CategoriesPanel_makeColorsPage(CategoriesPanel* this) {
    ScreenManager_add(this->scr, colors, -1);
 }
 
-#if defined(HTOP_PCP)   /* all platforms supporting dynamic screens */
+#if defined(HTOP_PCP) || defined(HTOP_LINUX)   /* all platforms supporting dynamic screens */
 static void CategoriesPanel_makeScreenTabsPage(CategoriesPanel* this) {
    Settings* settings = this->host->settings;
    Panel* screenTabs = (Panel*) ScreenTabsPanel_new(settings);
@@ -110,7 +110,7 @@ static CategoriesPanelPage categoriesPanelPages[] = {
    { .name = "Display options", .ctor = CategoriesPanel_makeDisplayOptionsPage },
    { .name = "Header layout", .ctor = CategoriesPanel_makeHeaderOptionsPage },
    { .name = "Meters", .ctor = CategoriesPanel_makeMetersPage },
-#if defined(HTOP_PCP)   /* all platforms supporting dynamic screens */
+#if defined(HTOP_PCP) || defined(HTOP_LINUX)   /* all platforms supporting dynamic screens */
    { .name = "Screen tabs", .ctor = CategoriesPanel_makeScreenTabsPage },
 #endif
    { .name = "Screens", .ctor = CategoriesPanel_makeScreensPage },
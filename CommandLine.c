@@ -15,6 +15,7 @@ in the source distribution for its full text.
 #include <getopt.h>
 #include <locale.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,9 +30,11 @@ in the source distribution for its full text.
 #include "Hashtable.h"
 #include "Header.h"
 #include "IncSet.h"
+#include "Instrument.h"
 #include "Machine.h"
 #include "MainPanel.h"
 #include "MetersPanel.h"
+#include "OutputWriter.h"
 #include "Panel.h"
 #include "Platform.h"
 #include "Process.h"
@@ -60,10 +63,15 @@ static void printHelpFlag(const char* name) {
    printf("-M --no-mouse                   Disable the mouse\n");
 #endif
    printf("-n --max-iterations=NUMBER      Exit htop after NUMBER iterations/frame updates\n"
+          "   --output=FORMAT              Print the processes to stdout as FORMAT (json or csv) instead of the interface\n"
           "-p --pid=PID[,PID,PID...]       Show only the given PIDs\n"
-          "   --readonly                   Disable all system and process changing features\n"
-          "-s --sort-key=COLUMN            Sort by COLUMN in list view (try --sort-key=help for a list)\n"
+          "   --readonly                   Disable all system and process changing features\n");
+#ifdef HAVE_SCAN_THREADS
+   printf("   --scan-threads=NUMBER        Read process data with NUMBER threads (1 reads serially)\n");
+#endif
+   printf("-s --sort-key=COLUMN            Sort by COLUMN in list view (try --sort-key=help for a list)\n"
           "-t --tree                       Show the tree view (can be combined with -s)\n"
+          "   --timings                    With --output, print the time htop spent per refresh phase to stderr when done\n"
           "-u --user[=USERNAME]            Show only processes for a given user (or $USER)\n"
           "-U --no-unicode                 Do not use unicode but plain ASCII\n"
           "-V --version                    Print version info\n");
@@ -91,6 +99,11 @@ typedef struct CommandLineSettings_ {
    bool highlightChanges;
    int highlightDelaySecs;
    bool readonly;
+#ifdef HAVE_SCAN_THREADS
+   int scanThreads;
+#endif
+   OutputFormat outputFormat;
+   bool timings;
 } CommandLineSettings;
 
 static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettings* flags) {
@@ -111,6 +124,11 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       .highlightChanges = false,
       .highlightDelaySecs = -1,
       .readonly = false,
+#ifdef HAVE_SCAN_THREADS
+      .scanThreads = -1,
+#endif
+      .outputFormat = OUTPUT_FORMAT_NONE,
+      .timings = false,
    };
 
    const struct option long_opts[] =
@@ -130,6 +148,11 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       {"filter",     required_argument,   0, 'F'},
       {"highlight-changes", optional_argument, 0, 'H'},
       {"readonly",   no_argument,         0, 128},
+#ifdef HAVE_SCAN_THREADS
+      {"scan-threads", required_argument, 0, 129},
+#endif
+      {"output",     required_argument,   0, 130},
+      {"timings",    no_argument,         0, 131},
       PLATFORM_LONG_OPTIONS
       {0, 0, 0, 0}
    };
@@ -272,6 +295,29 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
          case 128:
             flags->readonly = true;
             break;
+#ifdef HAVE_SCAN_THREADS
+         case 129:
+            if (sscanf(optarg, "%16d", &(flags->scanThreads)) == 1) {
+               if (flags->scanThreads < 1)
+                  flags->scanThreads = 1;
+               if (flags->scanThreads > MAX_SCAN_THREADS)
+                  flags->scanThreads = MAX_SCAN_THREADS;
+            } else {
+               fprintf(stderr, "Error: invalid scan thread count \"%s\".\n", optarg);
+               return STATUS_ERROR_EXIT;
+            }
+            break;
+#endif
+         case 130:
+            flags->outputFormat = OutputFormat_fromName(optarg);
+            if (flags->outputFormat == OUTPUT_FORMAT_NONE) {
+               fprintf(stderr, "Error: invalid output format \"%s\".\n", optarg);
+               return STATUS_ERROR_EXIT;
+            }
+            break;
+         case 131:
+            flags->timings = true;
+            break;
 
          default: {
             CommandLineStatus status;
@@ -282,6 +328,11 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       }
    }
 
+   if (flags->timings && flags->outputFormat == OUTPUT_FORMAT_NONE) {
+      fprintf(stderr, "Error: --timings requires --output.\n");
+      return STATUS_ERROR_EXIT;
+   }
+
    if (optind < argc) {
       fprintf(stderr, "Error: unsupported non-option ARGV-elements:");
       while (optind < argc)
@@ -295,8 +346,8 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
 
 static void CommandLine_delay(Machine* host, unsigned long millisec) {
    struct timespec req = {
-      .tv_sec = 0,
-      .tv_nsec = millisec * 1000000L
+      .tv_sec = millisec / 1000,
+      .tv_nsec = (millisec % 1000) * 1000000L
    };
    while (nanosleep(&req, &req) == -1)
       continue;
@@ -308,12 +359,74 @@ static void setCommFilter(State* state, char** commFilter) {
    IncSet* inc = state->mainPanel->inc;
 
    IncSet_setFilter(inc, *commFilter);
-   table->incFilter = IncSet_filter(inc);
+   Table_setIncFilter(table, IncSet_filter(inc));
 
    free(*commFilter);
    *commFilter = NULL;
 }
 
+static void CommandLine_printTimings(void) {
+   fprintf(stderr, "%s\n", INSTRUMENT_REPORT_HEADER);
+
+   char line[128];
+   for (unsigned int i = 0; Instrument_reportLine(i, line, sizeof(line)); i++)
+      fprintf(stderr, "%s\n", line);
+}
+
+/*
+ * Print every sample of the active table instead of running the interface,
+ * until the iteration count runs out or stdout can no longer be written.
+ * With timings, each sample is measured like a refresh of the interface.
+ */
+static int CommandLine_runHeadless(Machine* host, const char* commFilter, OutputFormat format, bool timings) {
+   Table* table = host->activeTable;
+   Table_setIncFilter(table, commFilter);
+
+   OutputWriter* writer = OutputWriter_new(STDOUT_FILENO, format);
+   unsigned int sample = 0;
+   int result = 0;
+
+   /* Two scans for meaningful CPU usage, like the interactive start-up */
+   Machine_scan(host);
+   Machine_scanTables(host);
+   CommandLine_delay(host, 75);
+
+   if (timings)
+      Instrument_enable();
+
+   for (;;) {
+      Instrument_cycle();
+
+      uint64_t start = Instrument_start();
+      Machine_scan(host);
+      Instrument_stop(INSTRUMENT_MACHINE_SCAN, start);
+      Machine_scanTables(host);
+
+      table->needsSort = true;
+      Table_updateDisplayList(table);
+
+      if (!OutputWriter_writeTable(writer, table, ++sample)) {
+         result = 1;
+         break;
+      }
+
+      if (host->iterationsRemaining != -1 && --host->iterationsRemaining == 0)
+         break;
+
+      CommandLine_delay(host, 100UL * (unsigned long)host->settings->delay);
+   }
+
+   if (timings) {
+      Instrument_cycle();
+      Instrument_disable();
+      CommandLine_printTimings();
+   }
+
+   OutputWriter_delete(writer);
+   Table_setIncFilter(table, NULL);
+   return result;
+}
+
 int CommandLine_run(int argc, char** argv) {
 
    /* initialize locale */
@@ -362,6 +475,10 @@ int CommandLine_run(int argc, char** argv) {
       settings->highlightChanges = true;
    if (flags.highlightDelaySecs != -1)
       settings->highlightDelaySecs = flags.highlightDelaySecs;
+#ifdef HAVE_SCAN_THREADS
+   if (flags.scanThreads != -1)
+      settings->scanThreads = flags.scanThreads;
+#endif
    if (flags.sortKey > 0) {
       // -t -s <key> means "tree sorted by key"
       // -s <key> means "list sorted by key" (previous existing behavior)
@@ -372,6 +489,29 @@ int CommandLine_run(int argc, char** argv) {
    }
 
    host->iterationsRemaining = flags.iterationsRemaining;
+
+   if (flags.outputFormat != OUTPUT_FORMAT_NONE) {
+      CRT_initHeadless(settings, flags.allowUnicode);
+      int result = CommandLine_runHeadless(host, flags.commFilter, flags.outputFormat, flags.timings);
+
+      Platform_done();
+
+      Header_delete(header);
+      Machine_delete(host);
+      UsersTable_delete(ut);
+
+      free(flags.commFilter);
+      if (flags.pidMatchList)
+         Hashtable_delete(flags.pidMatchList);
+
+      Settings_delete(settings);
+      DynamicColumns_delete(dc);
+      DynamicMeters_delete(dm);
+      DynamicScreens_delete(ds);
+
+      return result;
+   }
+
    CRT_init(settings, flags.allowUnicode, flags.iterationsRemaining != -1);
 
    MainPanel* panel = MainPanel_new();
@@ -168,6 +168,10 @@ DisplayOptionsPanel* DisplayOptionsPanel_new(Settings* settings, ScreenManager*
    Panel_add(super, (Object*) CheckItem_newByRef("Detailed CPU time (System/IO-Wait/Hard-IRQ/Soft-IRQ/Steal/Guest)", &(settings->detailedCPUTime)));
    Panel_add(super, (Object*) CheckItem_newByRef("Count CPUs from 1 instead of 0", &(settings->countCPUsFromOne)));
    Panel_add(super, (Object*) CheckItem_newByRef("Update process names on every refresh", &(settings->updateProcessNames)));
+   #ifdef HTOP_LINUX
+   Panel_add(super, (Object*) CheckItem_newByRef("Refresh costly columns only for processes on screen (blank until read)", &(settings->lazyProcessFields)));
+   Panel_add(super, (Object*) CheckItem_newByRef("Re-read idle processes less often", &(settings->tieredProcessSampling)));
+   #endif
    Panel_add(super, (Object*) CheckItem_newByRef("Add guest time in CPU meter percentage", &(settings->accountGuestInCPUMeter)));
    Panel_add(super, (Object*) CheckItem_newByRef("Also show CPU percentage numerically", &(settings->showCPUUsage)));
    Panel_add(super, (Object*) CheckItem_newByRef("Also show CPU frequency", &(settings->showCPUFrequency)));
@@ -191,6 +195,12 @@ DisplayOptionsPanel* DisplayOptionsPanel_new(Settings* settings, ScreenManager*
    Panel_add(super, (Object*) CheckItem_newByRef("Highlight new and old processes", &(settings->highlightChanges)));
    Panel_add(super, (Object*) NumberItem_newByRef("- Highlight time (in seconds)", &(settings->highlightDelaySecs), 0, 1, 24 * 60 * 60));
    Panel_add(super, (Object*) NumberItem_newByRef("Hide main function bar (0 - off, 1 - on ESC until next input, 2 - permanently)", &(settings->hideFunctionBar), 0, 0, 2));
+   #ifdef HAVE_SCAN_THREADS
+   Panel_add(super, (Object*) NumberItem_newByRef("Threads for reading process data (1 - serial)", &(settings->scanThreads), 0, 1, MAX_SCAN_THREADS));
+   #endif
+   #ifdef HAVE_PROC_CONNECTOR
+   Panel_add(super, (Object*) CheckItem_newByRef("Track process creation and exit via the proc connector (needs CAP_NET_ADMIN)", &(settings->trackProcessEvents)));
+   #endif
    #ifdef HAVE_LIBHWLOC
    Panel_add(super, (Object*) CheckItem_newByRef("Show topology when selecting affinity by default", &(settings->topologyAffinity)));
    #endif
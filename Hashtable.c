@@ -23,20 +23,26 @@ in the source distribution for its full text.
 #endif
 
 
+/*
+ * Open addressing with Robin Hood linear probing over a flat array with a
+ * power-of-two number of buckets. An item's probe is its distance from its
+ * home bucket; NULL values mark empty buckets.
+ */
 typedef struct HashtableItem_ {
    ht_key_t key;
-   size_t probe;
+   uint32_t probe;
    void* value;
 } HashtableItem;
 
 struct Hashtable_ {
    size_t size;
+   size_t mask;
+   unsigned int shift;
    HashtableItem* buckets;
    size_t items;
    bool owner;
 };
 
-
 #ifndef NDEBUG
 
 static void Hashtable_dump(const Hashtable* this) {
@@ -48,7 +54,7 @@ static void Hashtable_dump(const Hashtable* this) {
 
    size_t items = 0;
    for (size_t i = 0; i < this->size; i++) {
-      fprintf(stderr, "  item %5zu: key = %5u probe = %2zu value = %p\n",
+      fprintf(stderr, "  item %5zu: key = %5u probe = %2u value = %p\n",
               i,
               this->buckets[i].key,
               this->buckets[i].probe,
@@ -88,36 +94,52 @@ size_t Hashtable_count(const Hashtable* this) {
 
 #endif /* NDEBUG */
 
-/* https://oeis.org/A014234 */
-static const uint64_t OEISprimes[] = {
-   7, 13, 31, 61, 127, 251, 509, 1021, 2039, 4093, 8191,
-   16381, 32749, 65521, 131071, 262139, 524287, 1048573,
-   2097143, 4194301, 8388593, 16777213, 33554393,
-   67108859, 134217689, 268435399, 536870909, 1073741789,
-   2147483647, 4294967291, 8589934583, 17179869143,
-   34359738337, 68719476731, 137438953447
-};
+#define HASHTABLE_MIN_SIZE 8
 
-static size_t nextPrime(size_t n) {
-   /* on 32-bit make sure we do not return primes not fitting in size_t */
-   for (size_t i = 0; i < ARRAYSIZE(OEISprimes) && OEISprimes[i] < SIZE_MAX; i++) {
-      if (n <= OEISprimes[i])
-         return OEISprimes[i];
+static size_t nextPowerOfTwo(size_t n) {
+   size_t size = HASHTABLE_MIN_SIZE;
+
+   while (size < n) {
+      if (size > SIZE_MAX / 2)
+         CRT_fatalError("Hashtable: size overflow");
+      size *= 2;
    }
 
-   CRT_fatalError("Hashtable: no prime found");
+   return size;
 }
 
-Hashtable* Hashtable_new(size_t size, bool owner) {
-   size = size ? nextPrime(size) : 13;
+static void Hashtable_allocate(Hashtable* this, size_t size) {
+   assert((size & (size - 1)) == 0);
+
+   unsigned int bits = 0;
+   while (((size_t)1 << bits) < size)
+      bits++;
+
+   /* More buckets than distinct keys are of no use */
+   if (bits > 32)
+      CRT_fatalError("Hashtable: size overflow");
+
+   this->size = size;
+   this->mask = size - 1;
+   this->shift = 32 - bits;
+   this->buckets = xCalloc(size, sizeof(HashtableItem));
+   this->items = 0;
+}
+
+/*
+ * Fibonacci hashing: the top bits of the key times 2^32 / phi. This spreads
+ * runs of PIDs and UIDs, as well as keys sharing their low bits, across
+ * the whole table without a division.
+ */
+static inline size_t Hashtable_home(const Hashtable* this, ht_key_t key) {
+   return (uint32_t)(key * UINT32_C(2654435769)) >> this->shift;
+}
 
+Hashtable* Hashtable_new(size_t size, bool owner) {
    Hashtable* this = xMalloc(sizeof(Hashtable));
-   *this = (Hashtable) {
-      .items = 0,
-      .size = size,
-      .buckets = xCalloc(size, sizeof(HashtableItem)),
-      .owner = owner,
-   };
+   this->owner = owner;
+
+   Hashtable_allocate(this, nextPowerOfTwo(size));
 
    assert(Hashtable_isConsistent(this));
    return this;
@@ -144,42 +166,46 @@ void Hashtable_clear(Hashtable* this) {
 }
 
 static void insert(Hashtable* this, ht_key_t key, void* value) {
-   size_t index = key % this->size;
-   size_t probe = 0;
+   HashtableItem* buckets = this->buckets;
+   size_t mask = this->mask;
+   size_t index = Hashtable_home(this, key);
+   uint32_t probe = 0;
 #ifndef NDEBUG
    size_t origIndex = index;
 #endif
 
    for (;;) {
-      if (!this->buckets[index].value) {
+      HashtableItem* item = &buckets[index];
+
+      if (!item->value) {
          this->items++;
-         this->buckets[index].key = key;
-         this->buckets[index].probe = probe;
-         this->buckets[index].value = value;
+         item->key = key;
+         item->probe = probe;
+         item->value = value;
          return;
       }
 
-      if (this->buckets[index].key == key) {
-         if (this->owner && this->buckets[index].value != value)
-            free(this->buckets[index].value);
-         this->buckets[index].value = value;
+      if (item->key == key) {
+         if (this->owner && item->value != value)
+            free(item->value);
+         item->value = value;
          return;
       }
 
       /* Robin Hood swap */
-      if (probe > this->buckets[index].probe) {
-         HashtableItem tmp = this->buckets[index];
+      if (probe > item->probe) {
+         HashtableItem tmp = *item;
 
-         this->buckets[index].key = key;
-         this->buckets[index].probe = probe;
-         this->buckets[index].value = value;
+         item->key = key;
+         item->probe = probe;
+         item->value = value;
 
          key = tmp.key;
          probe = tmp.probe;
          value = tmp.value;
       }
 
-      index = (index + 1) % this->size;
+      index = (index + 1) & mask;
       probe++;
 
       assert(index != origIndex);
@@ -193,16 +219,14 @@ void Hashtable_setSize(Hashtable* this, size_t size) {
    if (size <= this->items)
       return;
 
-   size_t newSize = nextPrime(size);
+   size_t newSize = nextPowerOfTwo(size);
    if (newSize == this->size)
       return;
 
    HashtableItem* oldBuckets = this->buckets;
    size_t oldSize = this->size;
 
-   this->size = newSize;
-   this->buckets = (HashtableItem*) xCalloc(this->size, sizeof(HashtableItem));
-   this->items = 0;
+   Hashtable_allocate(this, newSize);
 
    /* rehash */
    for (size_t i = 0; i < oldSize; i++) {
@@ -239,8 +263,10 @@ void Hashtable_put(Hashtable* this, ht_key_t key, void* value) {
 }
 
 void* Hashtable_remove(Hashtable* this, ht_key_t key) {
-   size_t index = key % this->size;
-   size_t probe = 0;
+   HashtableItem* buckets = this->buckets;
+   size_t mask = this->mask;
+   size_t index = Hashtable_home(this, key);
+   uint32_t probe = 0;
 #ifndef NDEBUG
    size_t origIndex = index;
 #endif
@@ -249,35 +275,35 @@ void* Hashtable_remove(Hashtable* this, ht_key_t key) {
 
    void* res = NULL;
 
-   while (this->buckets[index].value) {
-      if (this->buckets[index].key == key) {
+   while (buckets[index].value) {
+      if (buckets[index].key == key) {
          if (this->owner) {
-            free(this->buckets[index].value);
+            free(buckets[index].value);
          } else {
-            res = this->buckets[index].value;
+            res = buckets[index].value;
          }
 
-         size_t next = (index + 1) % this->size;
+         size_t next = (index + 1) & mask;
 
-         while (this->buckets[next].value && this->buckets[next].probe > 0) {
-            this->buckets[index] = this->buckets[next];
-            this->buckets[index].probe -= 1;
+         while (buckets[next].value && buckets[next].probe > 0) {
+            buckets[index] = buckets[next];
+            buckets[index].probe -= 1;
 
             index = next;
-            next = (index + 1) % this->size;
+            next = (index + 1) & mask;
          }
 
          /* set empty after backward shifting */
-         this->buckets[index].value = NULL;
+         buckets[index].value = NULL;
          this->items--;
 
          break;
       }
 
-      if (this->buckets[index].probe < probe)
+      if (buckets[index].probe < probe)
          break;
 
-      index = (index + 1) % this->size;
+      index = (index + 1) & mask;
       probe++;
 
       assert(index != origIndex);
@@ -288,14 +314,16 @@ void* Hashtable_remove(Hashtable* this, ht_key_t key) {
 
    /* shrink on load-factor < 0.125 */
    if (8 * this->items < this->size)
-      Hashtable_setSize(this, this->size / 3); /* account for nextPrime rounding up */
+      Hashtable_setSize(this, this->size / 4);
 
    return res;
 }
 
 void* Hashtable_get(Hashtable* this, ht_key_t key) {
-   size_t index = key % this->size;
-   size_t probe = 0;
+   const HashtableItem* buckets = this->buckets;
+   size_t mask = this->mask;
+   size_t index = Hashtable_home(this, key);
+   uint32_t probe = 0;
    void* res = NULL;
 #ifndef NDEBUG
    size_t origIndex = index;
@@ -303,16 +331,16 @@ void* Hashtable_get(Hashtable* this, ht_key_t key) {
 
    assert(Hashtable_isConsistent(this));
 
-   while (this->buckets[index].value) {
-      if (this->buckets[index].key == key) {
-         res = this->buckets[index].value;
+   while (buckets[index].value) {
+      if (buckets[index].key == key) {
+         res = buckets[index].value;
          break;
       }
 
-      if (this->buckets[index].probe < probe)
+      if (buckets[index].probe < probe)
          break;
 
-      index = (index + 1) != this->size ? (index + 1) : 0;
+      index = (index + 1) & mask;
       probe++;
 
       assert(index != origIndex);
@@ -0,0 +1,285 @@
+/*
+htop - Instrument.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Instrument.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+/* Refreshes kept for the percentiles */
+#define INSTRUMENT_HISTORY 128
+
+/* Slab allocators reported at most */
+#define INSTRUMENT_SLABS 4
+
+/* The counts are kept as more series after the phases */
+#define INSTRUMENT_SYSCALLS    INSTRUMENT_PHASE_COUNT
+#define INSTRUMENT_ALLOCATIONS (INSTRUMENT_PHASE_COUNT + 1)
+#define INSTRUMENT_SERIES      (INSTRUMENT_PHASE_COUNT + 2)
+
+typedef struct InstrumentSeries_ {
+   uint64_t values[INSTRUMENT_HISTORY];
+   unsigned int calls;
+   unsigned int skips;
+} InstrumentSeries;
+
+static const struct {
+   const char* name;
+   bool nested;
+} Instrument_phases[INSTRUMENT_PHASE_COUNT] = {
+   [INSTRUMENT_MACHINE_SCAN]  = { "Machine scan",  false },
+   [INSTRUMENT_TABLE_SCAN]    = { "Table scan",    false },
+   [INSTRUMENT_PROC_STAT]     = { "stat",          true },
+   [INSTRUMENT_PROC_STATM]    = { "statm",         true },
+   [INSTRUMENT_PROC_STATUS]   = { "status",        true },
+   [INSTRUMENT_PROC_CMDLINE]  = { "cmdline",       true },
+   [INSTRUMENT_PROC_MAPS]     = { "maps",          true },
+   [INSTRUMENT_PROC_SMAPS]    = { "smaps",         true },
+   [INSTRUMENT_PROC_CGROUP]   = { "cgroup",        true },
+   [INSTRUMENT_PROC_IO]       = { "io",            true },
+   [INSTRUMENT_PROC_GPU]      = { "GPU",           true },
+   [INSTRUMENT_SORT]          = { "Sort",          false },
+   [INSTRUMENT_HEADER]        = { "Header meters", false },
+   [INSTRUMENT_DRAW]          = { "Panel draw",    false },
+};
+
+unsigned int Instrument_users;
+
+uint64_t Instrument_allocations;
+
+static uint64_t Instrument_pending[INSTRUMENT_PHASE_COUNT];
+static unsigned int Instrument_pendingCalls[INSTRUMENT_PHASE_COUNT];
+static unsigned int Instrument_pendingSkips[INSTRUMENT_PHASE_COUNT];
+static InstrumentSeries Instrument_series[INSTRUMENT_SERIES];
+static unsigned int Instrument_head;
+static unsigned int Instrument_count;
+static bool Instrument_measuring;
+
+static uint64_t Instrument_syscallBase;
+static bool Instrument_haveSyscalls;
+static uint64_t Instrument_allocationBase;
+
+static struct {
+   const char* name;
+   const SlabStats* stats;
+} Instrument_slabs[INSTRUMENT_SLABS];
+static size_t Instrument_slabCount;
+
+void Instrument_enable(void) {
+   Instrument_users++;
+}
+
+void Instrument_disable(void) {
+   assert(Instrument_users > 0);
+   Instrument_users--;
+}
+
+uint64_t Instrument_now(void) {
+#if defined(HAVE_CLOCK_GETTIME)
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+      return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#else
+   struct timeval tv;
+   if (gettimeofday(&tv, NULL) == 0)
+      return (uint64_t)tv.tv_sec * 1000000000 + (uint64_t)tv.tv_usec * 1000;
+#endif
+   return 0;
+}
+
+void Instrument_record(InstrumentPhase phase, uint64_t start) {
+   assert(phase < INSTRUMENT_PHASE_COUNT);
+
+   uint64_t now = Instrument_now();
+   Instrument_pending[phase] += now > start ? now - start : 0;
+   Instrument_pendingCalls[phase]++;
+}
+
+void Instrument_recordSkip(InstrumentPhase phase) {
+   assert(phase < INSTRUMENT_PHASE_COUNT);
+
+   Instrument_pendingSkips[phase]++;
+}
+
+/* Read and write system calls of the process so far, as accounted by the kernel */
+static bool Instrument_readSyscalls(uint64_t* count) {
+#ifdef HTOP_LINUX
+   char buffer[512];
+   ssize_t r = xReadfile("/proc/self/io", buffer, sizeof(buffer));
+   if (r <= 0)
+      return false;
+
+   const char* syscr = strstr(buffer, "syscr: ");
+   const char* syscw = strstr(buffer, "syscw: ");
+   if (!syscr || !syscw)
+      return false;
+
+   *count = strtoull(syscr + strlen("syscr: "), NULL, 10) + strtoull(syscw + strlen("syscw: "), NULL, 10);
+   return true;
+#else
+   (void) count;
+   return false;
+#endif
+}
+
+void Instrument_cycle(void) {
+   uint64_t syscalls = 0;
+   bool haveSyscalls = Instrument_users && Instrument_readSyscalls(&syscalls);
+
+   /* Keep only refreshes measured from start to end */
+   if (Instrument_measuring && Instrument_users) {
+      for (size_t i = 0; i < INSTRUMENT_PHASE_COUNT; i++) {
+         Instrument_series[i].values[Instrument_head] = Instrument_pending[i];
+         Instrument_series[i].calls = Instrument_pendingCalls[i];
+         Instrument_series[i].skips = Instrument_pendingSkips[i];
+      }
+
+      InstrumentSeries* series = &Instrument_series[INSTRUMENT_SYSCALLS];
+      series->values[Instrument_head] = haveSyscalls && Instrument_haveSyscalls ? syscalls - Instrument_syscallBase : 0;
+      series->calls = 0;
+
+      series = &Instrument_series[INSTRUMENT_ALLOCATIONS];
+      series->values[Instrument_head] = Instrument_allocations - Instrument_allocationBase;
+      series->calls = 0;
+
+      Instrument_head = (Instrument_head + 1) % INSTRUMENT_HISTORY;
+      Instrument_count = MINIMUM(Instrument_count + 1, INSTRUMENT_HISTORY);
+   }
+
+   memset(Instrument_pending, 0, sizeof(Instrument_pending));
+   memset(Instrument_pendingCalls, 0, sizeof(Instrument_pendingCalls));
+   memset(Instrument_pendingSkips, 0, sizeof(Instrument_pendingSkips));
+   Instrument_measuring = Instrument_users > 0;
+   Instrument_syscallBase = syscalls;
+   Instrument_haveSyscalls = haveSyscalls;
+   Instrument_allocationBase = Instrument_allocations;
+}
+
+static int Instrument_compareValues(const void* v1, const void* v2) {
+   uint64_t a = *(const uint64_t*)v1;
+   uint64_t b = *(const uint64_t*)v2;
+   return SPACESHIP_NUMBER(a, b);
+}
+
+static bool Instrument_seriesStats(const InstrumentSeries* series, InstrumentStats* stats) {
+   if (!Instrument_count)
+      return false;
+
+   uint64_t sorted[INSTRUMENT_HISTORY];
+   unsigned int n = Instrument_count;
+   unsigned int first = (Instrument_head + INSTRUMENT_HISTORY - n) % INSTRUMENT_HISTORY;
+   for (unsigned int i = 0; i < n; i++)
+      sorted[i] = series->values[(first + i) % INSTRUMENT_HISTORY];
+   qsort(sorted, n, sizeof(*sorted), Instrument_compareValues);
+
+   stats->last = series->values[(Instrument_head + INSTRUMENT_HISTORY - 1) % INSTRUMENT_HISTORY];
+   stats->p50 = sorted[(n - 1) / 2];
+   stats->p99 = sorted[(n - 1) * 99 / 100];
+   stats->calls = series->calls;
+   stats->skips = series->skips;
+   return true;
+}
+
+bool Instrument_stats(InstrumentPhase phase, InstrumentStats* stats) {
+   assert(phase < INSTRUMENT_PHASE_COUNT);
+   return Instrument_seriesStats(&Instrument_series[phase], stats);
+}
+
+bool Instrument_syscallStats(InstrumentStats* stats) {
+   if (!Instrument_haveSyscalls)
+      return false;
+
+   return Instrument_seriesStats(&Instrument_series[INSTRUMENT_SYSCALLS], stats);
+}
+
+bool Instrument_allocationStats(InstrumentStats* stats) {
+   return Instrument_seriesStats(&Instrument_series[INSTRUMENT_ALLOCATIONS], stats);
+}
+
+void Instrument_watchSlab(const char* name, const SlabStats* stats) {
+   for (size_t i = 0; i < Instrument_slabCount; i++)
+      if (Instrument_slabs[i].stats == stats)
+         return;
+
+   assert(Instrument_slabCount < INSTRUMENT_SLABS);
+   if (Instrument_slabCount == INSTRUMENT_SLABS)
+      return;
+
+   Instrument_slabs[Instrument_slabCount].name = name;
+   Instrument_slabs[Instrument_slabCount].stats = stats;
+   Instrument_slabCount++;
+}
+
+unsigned int Instrument_cycles(void) {
+   return Instrument_count;
+}
+
+const char* Instrument_phaseName(InstrumentPhase phase) {
+   assert(phase < INSTRUMENT_PHASE_COUNT);
+   return Instrument_phases[phase].name;
+}
+
+bool Instrument_isNested(InstrumentPhase phase) {
+   assert(phase < INSTRUMENT_PHASE_COUNT);
+   return Instrument_phases[phase].nested;
+}
+
+bool Instrument_reportLine(unsigned int i, char* line, size_t size) {
+   InstrumentStats stats;
+
+   if (i < INSTRUMENT_PHASE_COUNT) {
+      if (!Instrument_stats(i, &stats))
+         return false;
+
+      bool nested = Instrument_isNested(i);
+      int len = xSnprintf(line, size, "%s%-*s %11.2f %11.2f %11.2f %8u",
+                          nested ? "  " : "", nested ? 18 : 20, Instrument_phaseName(i),
+                          stats.last / 1e6, stats.p50 / 1e6, stats.p99 / 1e6, stats.calls);
+      if (stats.skips && (size_t)len < size)
+         xSnprintf(line + len, size - len, " %7.1f%%", 100.0 * stats.skips / (stats.calls + stats.skips));
+      return true;
+   }
+
+   switch (i - INSTRUMENT_PHASE_COUNT) {
+      case 0:
+         if (!Instrument_syscallStats(&stats)) {
+            xSnprintf(line, size, "%-20s %11s", "Read/write syscalls", "-");
+            return true;
+         }
+         xSnprintf(line, size, "%-20s %11" PRIu64 " %11" PRIu64 " %11" PRIu64,
+                   "Read/write syscalls", stats.last, stats.p50, stats.p99);
+         return true;
+      case 1:
+         if (!Instrument_allocationStats(&stats))
+            return false;
+         xSnprintf(line, size, "%-20s %11" PRIu64 " %11" PRIu64 " %11" PRIu64,
+                   "Allocations", stats.last, stats.p50, stats.p99);
+         return true;
+      default:
+         break;
+   }
+
+   /* The slabs as of now, not per refresh */
+   size_t slab = i - INSTRUMENT_PHASE_COUNT - 2;
+   if (slab >= Instrument_slabCount)
+      return false;
+
+   const SlabStats* slabStats = Instrument_slabs[slab].stats;
+   xSnprintf(line, size, "%-20s %11zu in use, %zu free in %zu chunks, %" PRIu64 " allocated so far",
+             Instrument_slabs[slab].name, slabStats->inUse, slabStats->available, slabStats->chunks, slabStats->allocations);
+   return true;
+}
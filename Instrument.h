@@ -0,0 +1,123 @@
+#ifndef HEADER_Instrument
+#define HEADER_Instrument
+/*
+htop - Instrument.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Slab.h"
+
+
+/*
+ * Timings of htop's own work, per refresh. The phases add up the time
+ * spent between Instrument_start and Instrument_stop over one refresh,
+ * which Instrument_cycle closes. Nothing is measured unless some user,
+ * like the htop self meter, enabled the instrumentation; disabled, a
+ * measured section only costs a test of Instrument_users.
+ */
+
+typedef enum InstrumentPhase_ {
+   INSTRUMENT_MACHINE_SCAN,
+   INSTRUMENT_TABLE_SCAN,
+   /* Readers of per-process data, run as part of the table scan */
+   INSTRUMENT_PROC_STAT,
+   INSTRUMENT_PROC_STATM,
+   INSTRUMENT_PROC_STATUS,
+   INSTRUMENT_PROC_CMDLINE,
+   INSTRUMENT_PROC_MAPS,
+   INSTRUMENT_PROC_SMAPS,
+   INSTRUMENT_PROC_CGROUP,
+   INSTRUMENT_PROC_IO,
+   INSTRUMENT_PROC_GPU,
+   INSTRUMENT_SORT,
+   INSTRUMENT_HEADER,
+   INSTRUMENT_DRAW,
+   INSTRUMENT_PHASE_COUNT
+} InstrumentPhase;
+
+typedef struct InstrumentStats_ {
+   uint64_t last;             /* value of the last refresh */
+   uint64_t p50;              /* median over the recent refreshes */
+   uint64_t p99;
+   unsigned int calls;        /* measured sections in the last refresh */
+   unsigned int skips;        /* sections left out in the last refresh */
+} InstrumentStats;
+
+extern unsigned int Instrument_users;
+
+extern uint64_t Instrument_allocations;
+
+void Instrument_enable(void);
+
+void Instrument_disable(void);
+
+uint64_t Instrument_now(void);
+
+void Instrument_record(InstrumentPhase phase, uint64_t start);
+
+/* Returns the start of a measured section, 0 if not measuring */
+static inline uint64_t Instrument_start(void) {
+   return Instrument_users ? Instrument_now() : 0;
+}
+
+static inline void Instrument_stop(InstrumentPhase phase, uint64_t start) {
+   if (start)
+      Instrument_record(phase, start);
+}
+
+void Instrument_recordSkip(InstrumentPhase phase);
+
+/* Count a section not run in this refresh, like a read of unchanged data */
+static inline void Instrument_skip(InstrumentPhase phase) {
+   if (Instrument_users)
+      Instrument_recordSkip(phase);
+}
+
+/* Called by the allocation wrappers, possibly from several threads at once */
+static inline void Instrument_countAllocation(void) {
+   if (!Instrument_users)
+      return;
+
+#ifdef __GNUC__
+   __atomic_fetch_add(&Instrument_allocations, 1, __ATOMIC_RELAXED);
+#else
+   Instrument_allocations++;
+#endif
+}
+
+/* Close the refresh measured so far; called before each scan */
+void Instrument_cycle(void);
+
+/* Times in nanoseconds; false if no refresh was measured yet */
+bool Instrument_stats(InstrumentPhase phase, InstrumentStats* stats);
+
+/* Read and write system calls per refresh, false where they are not known */
+bool Instrument_syscallStats(InstrumentStats* stats);
+
+/* Memory allocations per refresh through the allocation wrappers of XUtils */
+bool Instrument_allocationStats(InstrumentStats* stats);
+
+/* Report the objects of a slab allocator after the counts, under the name */
+void Instrument_watchSlab(const char* name, const SlabStats* stats);
+
+/* Number of refreshes the percentiles are taken over */
+unsigned int Instrument_cycles(void);
+
+const char* Instrument_phaseName(InstrumentPhase phase);
+
+/* Whether the time of the phase is also counted in INSTRUMENT_TABLE_SCAN */
+bool Instrument_isNested(InstrumentPhase phase);
+
+#define INSTRUMENT_REPORT_HEADER "PHASE                    LAST MS   MEDIAN MS      P99 MS    CALLS  SKIPPED"
+
+/* Format line i of a report of all phases and counts in columns under
+   INSTRUMENT_REPORT_HEADER; false past the last line */
+bool Instrument_reportLine(unsigned int i, char* line, size_t size);
+
+#endif /* HEADER_Instrument */
@@ -0,0 +1,67 @@
+/*
+htop - InstrumentScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "InstrumentScreen.h"
+
+#include <stdlib.h>
+
+#include "Instrument.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+static void InstrumentScreen_scan(InfoScreen* this) {
+   Panel* panel = this->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+   Panel_prune(panel);
+
+   char line[128];
+
+   if (!Instrument_cycles()) {
+      InfoScreen_addLine(this, "No refresh measured yet; they are measured from now on until htop exits.");
+      Panel_setSelected(panel, idx);
+      return;
+   }
+
+   for (unsigned int i = 0; Instrument_reportLine(i, line, sizeof(line)); i++)
+      InfoScreen_addLine(this, line);
+
+   Panel_setSelected(panel, idx);
+}
+
+static void InstrumentScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Time htop spent per refresh, over the last %u refreshes", Instrument_cycles());
+}
+
+const InfoScreenClass InstrumentScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = InstrumentScreen_delete
+   },
+   .scan = InstrumentScreen_scan,
+   .draw = InstrumentScreen_draw
+};
+
+InstrumentScreen* InstrumentScreen_new(void) {
+   /* Measuring starts with the first look at the screen and goes on from then */
+   static bool enabled = false;
+   if (!enabled) {
+      Instrument_enable();
+      enabled = true;
+   }
+
+   InstrumentScreen* this = AllocThis(InstrumentScreen);
+   return (InstrumentScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, INSTRUMENT_REPORT_HEADER);
+}
+
+void InstrumentScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
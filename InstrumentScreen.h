@@ -0,0 +1,24 @@
+#ifndef HEADER_InstrumentScreen
+#define HEADER_InstrumentScreen
+/*
+htop - InstrumentScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+
+
+typedef struct InstrumentScreen_ {
+   InfoScreen super;
+} InstrumentScreen;
+
+extern const InfoScreenClass InstrumentScreen_class;
+
+InstrumentScreen* InstrumentScreen_new(void);
+
+void InstrumentScreen_delete(Object* this);
+
+#endif
@@ -10,9 +10,11 @@ in the source distribution for its full text.
 
 #include "Machine.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "Instrument.h"
 #include "Object.h"
 #include "Platform.h"
 #include "Row.h"
@@ -60,7 +62,7 @@ void Machine_done(Machine* this) {
    free(this->tables);
 }
 
-static void Machine_addTable(Machine* this, Table* table) {
+void Machine_addTable(Machine* this, Table* table) {
    /* check that this table has not been seen previously */
    for (size_t i = 0; i < this->tableCount; i++)
       if (this->tables[i] == table)
@@ -111,6 +113,8 @@ void Machine_scanTables(Machine* this) {
       return;
    }
 
+   uint64_t start = Instrument_start();
+
    this->maxUserId = 0;
    Row_resetFieldWidths();
 
@@ -128,4 +132,6 @@ void Machine_scanTables(Machine* this) {
    }
 
    Row_setUidColumnWidth(this->maxUserId);
+
+   Instrument_stop(INSTRUMENT_TABLE_SCAN, start);
 }
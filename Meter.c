@@ -189,6 +189,97 @@ static const char* const GraphMeterMode_dotsAscii[] = {
    /*20*/":", /*21*/":", /*22*/":"
 };
 
+/* Length in seconds of the buckets of each rollup level */
+static const unsigned int GraphData_rollupSeconds[GRAPHDATA_ROLLUP_LEVELS] = { 10, 60, 600 };
+
+/* 0 draws the recorded samples, otherwise the buckets of rollup level n - 1 */
+static unsigned int GraphMeterMode_resolution = 0;
+
+void Meter_cycleGraphResolution(void) {
+   GraphMeterMode_resolution = (GraphMeterMode_resolution + 1) % (GRAPHDATA_ROLLUP_LEVELS + 1);
+}
+
+static void GraphData_done(GraphData* data) {
+   free(data->values);
+   for (size_t i = 0; i < GRAPHDATA_ROLLUP_LEVELS; i++)
+      free(data->rollups[i].buckets);
+
+   memset(data, 0, sizeof(*data));
+}
+
+/* Resize the ring buffer to nValues, keeping the samples in order with the newest last */
+static void GraphData_grow(GraphData* data, size_t nValues) {
+   assert(nValues >= data->nValues);
+
+   double* values = xCalloc(nValues, sizeof(*values));
+   if (data->values) {
+      size_t older = data->nValues - data->head;
+      memcpy(values + (nValues - data->nValues), data->values + data->head, older * sizeof(*values));
+      memcpy(values + (nValues - data->head), data->values, data->head * sizeof(*values));
+      free(data->values);
+   }
+
+   data->values = values;
+   data->nValues = nValues;
+   data->head = 0;
+}
+
+/* The i-th recorded sample, counting from the oldest one */
+static inline double GraphData_valueAt(const GraphData* data, size_t i) {
+   size_t at = data->head + i;
+   if (at >= data->nValues)
+      at -= data->nValues;
+   return data->values[at];
+}
+
+static void GraphDataRollup_push(GraphDataRollup* rollup, float avg, float max) {
+   rollup->buckets[rollup->head] = (GraphDataBucket) { .avg = avg, .max = max };
+   rollup->head = (rollup->head + 1) % GRAPHDATA_ROLLUP_BUCKETS;
+}
+
+static void GraphDataRollup_add(GraphDataRollup* rollup, uint64_t span, double value) {
+   if (!rollup->buckets) {
+      rollup->buckets = xCalloc(GRAPHDATA_ROLLUP_BUCKETS, sizeof(*rollup->buckets));
+      rollup->span = span;
+   }
+
+   if (span != rollup->span) {
+      if (rollup->count > 0) {
+         GraphDataRollup_push(rollup, (float)(rollup->sum / rollup->count), (float)rollup->max);
+      } else {
+         GraphDataRollup_push(rollup, 0.0F, 0.0F);
+      }
+
+      /* Spans without any sample, e.g. while the meter was hidden, stay empty */
+      uint64_t skipped = span > rollup->span ? span - rollup->span - 1 : 0;
+      skipped = MINIMUM(skipped, GRAPHDATA_ROLLUP_BUCKETS);
+      for (uint64_t i = 0; i < skipped; i++)
+         GraphDataRollup_push(rollup, 0.0F, 0.0F);
+
+      rollup->span = span;
+      rollup->sum = 0.0;
+      rollup->max = 0.0;
+      rollup->count = 0;
+   }
+
+   rollup->sum += value;
+   rollup->max = MAXIMUM(rollup->max, value);
+   rollup->count++;
+}
+
+/* The bucket age spans before the pending one, which itself is age 0 */
+static GraphDataBucket GraphDataRollup_bucketAt(const GraphDataRollup* rollup, size_t age) {
+   if (age == 0) {
+      if (rollup->count == 0)
+         return (GraphDataBucket) { .avg = 0.0F, .max = 0.0F };
+
+      return (GraphDataBucket) { .avg = (float)(rollup->sum / rollup->count), .max = (float)rollup->max };
+   }
+
+   assert(age <= GRAPHDATA_ROLLUP_BUCKETS);
+   return rollup->buckets[(rollup->head + GRAPHDATA_ROLLUP_BUCKETS - age) % GRAPHDATA_ROLLUP_BUCKETS];
+}
+
 static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
    // Draw the caption
    const char* caption = Meter_getCaption(this);
@@ -203,12 +294,8 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
    // Expand the graph data buffer if necessary
    assert(data->nValues / 2 <= INT_MAX);
    if (w > (int)(data->nValues / 2) && MAX_METER_GRAPHDATA_VALUES > data->nValues) {
-      size_t oldNValues = data->nValues;
-      data->nValues = MAXIMUM(oldNValues + oldNValues / 2, (size_t)w * 2);
-      data->nValues = MINIMUM(data->nValues, MAX_METER_GRAPHDATA_VALUES);
-      data->values = xReallocArray(data->values, data->nValues, sizeof(*data->values));
-      memmove(data->values + (data->nValues - oldNValues), data->values, oldNValues * sizeof(*data->values));
-      memset(data->values, 0, (data->nValues - oldNValues) * sizeof(*data->values));
+      size_t nValues = MAXIMUM(data->nValues + data->nValues / 2, (size_t)w * 2);
+      GraphData_grow(data, MINIMUM(nValues, MAX_METER_GRAPHDATA_VALUES));
    }
 
    const size_t nValues = data->nValues;
@@ -222,13 +309,18 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
       struct timeval delay = { .tv_sec = globalDelay / 10, .tv_usec = (globalDelay % 10) * 100000L };
       timeradd(&host->realtime, &delay, &(data->time));
 
-      memmove(&data->values[0], &data->values[1], (nValues - 1) * sizeof(*data->values));
-
-      data->values[nValues - 1] = 0.0;
+      double value = 0.0;
       if (this->curItems > 0) {
          assert(this->values);
-         data->values[nValues - 1] = sumPositiveValues(this->values, this->curItems);
+         value = sumPositiveValues(this->values, this->curItems);
       }
+
+      // Overwrite the oldest sample
+      data->values[data->head] = value;
+      data->head = (data->head + 1) % nValues;
+
+      for (size_t i = 0; i < GRAPHDATA_ROLLUP_LEVELS; i++)
+         GraphDataRollup_add(&data->rollups[i], (uint64_t)host->realtime.tv_sec / GraphData_rollupSeconds[i], value);
    }
 
    if (w <= 0)
@@ -248,19 +340,39 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
       GraphMeterMode_pixPerRow = PIXPERROW_ASCII;
    }
 
-   // Starting positions of graph data and terminal column
-   if ((size_t)w > nValues / 2) {
-      x += w - nValues / 2;
-      w = nValues / 2;
+   // Samples take half a column each, rollup buckets a column with their average and maximum
+   const GraphDataRollup* rollup = NULL;
+   size_t nColumns = nValues / 2;
+   if (GraphMeterMode_resolution > 0 && data->rollups[GraphMeterMode_resolution - 1].buckets) {
+      rollup = &data->rollups[GraphMeterMode_resolution - 1];
+      nColumns = GRAPHDATA_ROLLUP_BUCKETS + 1;
+   }
+
+   // Starting position of the terminal column
+   if ((size_t)w > nColumns) {
+      x += w - (int)nColumns;
+      w = (int)nColumns;
    }
-   size_t i = nValues - (size_t)w * 2;
 
    // Draw the actual graph
-   for (int col = 0; i < nValues - 1; i += 2, col++) {
+   for (int col = 0; col < w; col++) {
+      size_t age = (size_t)(w - 1 - col);
+      double value1;
+      double value2;
+      if (rollup) {
+         GraphDataBucket bucket = GraphDataRollup_bucketAt(rollup, age);
+         value1 = bucket.avg;
+         value2 = bucket.max;
+      } else {
+         size_t i = nValues - 2 * age - 2;
+         value1 = GraphData_valueAt(data, i);
+         value2 = GraphData_valueAt(data, i + 1);
+      }
+
       int pix = GraphMeterMode_pixPerRow * GRAPH_HEIGHT;
       double total = MAXIMUM(this->total, 1);
-      int v1 = (int) lround(CLAMP(data->values[i] / total * pix, 1.0, pix));
-      int v2 = (int) lround(CLAMP(data->values[i + 1] / total * pix, 1.0, pix));
+      int v1 = (int) lround(CLAMP(value1 / total * pix, 1.0, pix));
+      int v2 = (int) lround(CLAMP(value2 / total * pix, 1.0, pix));
 
       int colorIdx = GRAPH_1;
       for (int line = 0; line < GRAPH_HEIGHT; line++) {
@@ -445,7 +557,7 @@ void Meter_delete(Object* cast) {
    if (Meter_doneFn(this)) {
       Meter_done(this);
    }
-   free(this->drawData.values);
+   GraphData_done(&this->drawData);
    free(this->caption);
    free(this->values);
    free(this);
@@ -475,9 +587,7 @@ void Meter_setMode(Meter* this, MeterModeId modeIndex) {
       this->draw = Meter_drawFn(this);
       Meter_updateMode(this, modeIndex);
    } else {
-      free(this->drawData.values);
-      this->drawData.values = NULL;
-      this->drawData.nValues = 0;
+      GraphData_done(&this->drawData);
 
       const MeterMode* mode = &Meter_modes[modeIndex];
       this->draw = mode->draw;
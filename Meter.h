@@ -21,6 +21,8 @@ in the source distribution for its full text.
 
 #define METER_TXTBUFFER_LEN 256
 #define MAX_METER_GRAPHDATA_VALUES 32768
+#define GRAPHDATA_ROLLUP_LEVELS 3
+#define GRAPHDATA_ROLLUP_BUCKETS 1440
 
 #define METER_BUFFER_CHECK(buffer, size, written)          \
    do {                                                    \
@@ -96,10 +98,28 @@ typedef struct MeterClass_ {
 #define Meter_uiName(this_)            As_Meter(this_)->uiName
 #define Meter_isMultiColumn(this_)     As_Meter(this_)->isMultiColumn
 
+typedef struct GraphDataBucket_ {
+   float avg;
+   float max;
+} GraphDataBucket;
+
+/* Summaries of the samples taken during fixed spans of time, oldest at head */
+typedef struct GraphDataRollup_ {
+   GraphDataBucket* buckets;
+   size_t head;
+   uint64_t span;             /* realtime divided by the span length, of the pending bucket */
+   double sum;                /* samples of the pending bucket */
+   double max;
+   unsigned int count;
+} GraphDataRollup;
+
+/* Ring buffer of the recorded samples, oldest at head, plus coarser rollups of them */
 typedef struct GraphData_ {
    struct timeval time;
    size_t nValues;
+   size_t head;
    double* values;
+   GraphDataRollup rollups[GRAPHDATA_ROLLUP_LEVELS];
 } GraphData;
 
 struct Meter_ {
@@ -146,6 +166,9 @@ MeterModeId Meter_nextSupportedMode(const Meter* this);
 
 ListItem* Meter_toListItem(const Meter* this, bool moving);
 
+/* Switch all graph meters to the next coarser time resolution, wrapping around to the samples */
+void Meter_cycleGraphResolution(void);
+
 extern const MeterClass BlankMeter_class;
 
 #endif
@@ -20,12 +20,28 @@ in the source distribution for its full text.
 #include <sys/wait.h>
 #include <sys/stat.h>
 
+#ifdef HTOP_LINUX
+#include <sys/sysmacros.h>
+#endif
+
+#include "CRT.h"
 #include "Macros.h"
 #include "Panel.h"
 #include "ProvideCurses.h"
 #include "Vector.h"
 #include "XUtils.h"
 
+#ifdef HTOP_LINUX
+#include "linux/ProcOpenFiles.h"
+#endif
+
+
+#ifdef HTOP_LINUX
+
+/* Files added between two checks for a key press */
+#define OPENFILES_BATCH 1024
+
+#else
 
 // cf. getIndexForType; must be larger than the maximum value returned.
 #define LSOF_DATACOL_COUNT 8
@@ -75,6 +91,8 @@ static const char* getDataForType(const OpenFiles_Data* data, char type) {
    return data->data[index] ? data->data[index] : "";
 }
 
+#endif /* HTOP_LINUX */
+
 OpenFilesScreen* OpenFilesScreen_new(const Process* process) {
    OpenFilesScreen* this = xCalloc(1, sizeof(OpenFilesScreen));
    Object_setClass(this, Class(OpenFilesScreen));
@@ -87,6 +105,10 @@ OpenFilesScreen* OpenFilesScreen_new(const Process* process) {
 }
 
 void OpenFilesScreen_delete(Object* this) {
+#ifdef HTOP_LINUX
+   if (((OpenFilesScreen*)this)->files)
+      ProcOpenFiles_delete(((OpenFilesScreen*)this)->files);
+#endif
    free(InfoScreen_done((InfoScreen*)this));
 }
 
@@ -94,6 +116,87 @@ static void OpenFilesScreen_draw(InfoScreen* this) {
    InfoScreen_drawTitled(this, "Snapshot of files open in process %d - %s", ((OpenFilesScreen*)this)->pid, Process_getCommand(this->process));
 }
 
+#ifdef HTOP_LINUX
+
+static void OpenFilesScreen_addFile(InfoScreen* super, const ProcOpenFile* file) {
+   char mode[2] = { file->mode, '\0' };
+   char device[24] = "";
+   char size[21] = "";
+   char offset[21] = "";
+   char node[21] = "";
+
+   if (file->hasDevice)
+      xSnprintf(device, sizeof(device), "%u,%u", major(file->device), minor(file->device));
+   if (file->hasSize)
+      xSnprintf(size, sizeof(size), "%" PRIu64, file->size);
+   if (file->hasOffset)
+      xSnprintf(offset, sizeof(offset), "%" PRIu64, file->offset);
+   if (file->inode)
+      xSnprintf(node, sizeof(node), "%" PRIu64, file->inode);
+
+   char* entry = NULL;
+   xAsprintf(&entry, "%5.5s %-7.7s %-4.4s %6.6s %10s %10s %10s  %s",
+             file->fd, file->type, mode, device, size, offset, node, file->name);
+   InfoScreen_addLine(super, entry);
+   free(entry);
+}
+
+/* Add up to count more files; false once all were added */
+static bool OpenFilesScreen_readFiles(OpenFilesScreen* this, int count) {
+   Panel* panel = this->super.display;
+
+   bool more = true;
+   for (int i = 0; i < count; i++) {
+      const ProcOpenFile* file = ProcOpenFiles_next(this->files);
+      if (!file) {
+         more = false;
+         break;
+      }
+      OpenFilesScreen_addFile(&this->super, file);
+   }
+
+   if (this->selection >= 0 && (this->selection < Panel_size(panel) || !more)) {
+      Panel_setSelected(panel, this->selection);
+      this->selection = -1;
+   }
+
+   if (!more && this->reading) {
+      this->reading = false;
+      CRT_enableDelay();
+   }
+   return more;
+}
+
+static void OpenFilesScreen_scan(InfoScreen* super) {
+   OpenFilesScreen* this = (OpenFilesScreen*)super;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+
+   if (!this->files)
+      this->files = ProcOpenFiles_new(this->pid);
+
+   if (!ProcOpenFiles_start(this->files)) {
+      InfoScreen_addLine(super, "Failed listing open files.");
+      return;
+   }
+
+   /* Show the first page at once, the rest is read while no key is pressed */
+   this->selection = idx;
+   if (OpenFilesScreen_readFiles(this, MAXIMUM(panel->h, 1)) && !this->reading) {
+      this->reading = true;
+      CRT_disableDelay();
+   }
+}
+
+static void OpenFilesScreen_readMore(InfoScreen* super) {
+   OpenFilesScreen* this = (OpenFilesScreen*)super;
+   if (this->reading)
+      OpenFilesScreen_readFiles(this, OPENFILES_BATCH);
+}
+
+#else
+
 static OpenFiles_ProcessData* OpenFilesScreen_getProcessData(pid_t pid) {
    OpenFiles_ProcessData* pdata = xCalloc(1, sizeof(OpenFiles_ProcessData));
    pdata->cols[getIndexForType('s')] = 8;
@@ -305,11 +408,16 @@ static void OpenFilesScreen_scan(InfoScreen* super) {
    Panel_setSelected(panel, idx);
 }
 
+#endif /* HTOP_LINUX */
+
 const InfoScreenClass OpenFilesScreen_class = {
    .super = {
       .extends = Class(Object),
       .delete = OpenFilesScreen_delete
    },
    .scan = OpenFilesScreen_scan,
-   .draw = OpenFilesScreen_draw
+   .draw = OpenFilesScreen_draw,
+#ifdef HTOP_LINUX
+   .onErr = OpenFilesScreen_readMore,
+#endif
 };
@@ -7,6 +7,7 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stdbool.h>
 #include <sys/types.h>
 
 #include "InfoScreen.h"
@@ -17,6 +18,11 @@ in the source distribution for its full text.
 typedef struct OpenFilesScreen_ {
    InfoScreen super;
    pid_t pid;
+#ifdef HTOP_LINUX
+   struct ProcOpenFiles_* files;
+   bool reading;              /* more files are added as long as no key is pressed */
+   int selection;             /* row to select again once it was added */
+#endif
 } OpenFilesScreen;
 
 extern const InfoScreenClass OpenFilesScreen_class;
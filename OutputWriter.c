@@ -0,0 +1,358 @@
+/*
+htop - OutputWriter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "OutputWriter.h"
+
+#include <assert.h>
+#include <float.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "DynamicColumn.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Process.h"
+#include "RichString.h"
+#include "Row.h"
+#include "RowField.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+#define OUTPUT_WRITER_BUFSIZE 65536
+
+struct OutputWriter_ {
+   int fd;
+   OutputFormat format;
+   bool failed;
+   bool headerWritten;
+   size_t used;
+   char buffer[OUTPUT_WRITER_BUFSIZE];
+};
+
+static const char OutputWriter_hexDigits[] = "0123456789abcdef";
+
+OutputFormat OutputFormat_fromName(const char* name) {
+   if (String_eq(name, "json"))
+      return OUTPUT_FORMAT_JSON;
+   if (String_eq(name, "csv"))
+      return OUTPUT_FORMAT_CSV;
+   return OUTPUT_FORMAT_NONE;
+}
+
+OutputWriter* OutputWriter_new(int fd, OutputFormat format) {
+   assert(format != OUTPUT_FORMAT_NONE);
+
+   OutputWriter* this = xMalloc(sizeof(OutputWriter));
+   this->fd = fd;
+   this->format = format;
+   this->failed = false;
+   this->headerWritten = false;
+   this->used = 0;
+   return this;
+}
+
+static void OutputWriter_flush(OutputWriter* this) {
+   if (this->used > 0 && !this->failed && full_write(this->fd, this->buffer, this->used) < 0)
+      this->failed = true;
+
+   this->used = 0;
+}
+
+void OutputWriter_delete(OutputWriter* this) {
+   if (!this)
+      return;
+
+   OutputWriter_flush(this);
+   free(this);
+}
+
+/* Make room for len more bytes and return where they go */
+static inline char* OutputWriter_reserve(OutputWriter* this, size_t len) {
+   assert(len <= sizeof(this->buffer));
+
+   if (sizeof(this->buffer) - this->used < len)
+      OutputWriter_flush(this);
+
+   return this->buffer + this->used;
+}
+
+static inline void OutputWriter_putChar(OutputWriter* this, char c) {
+   *OutputWriter_reserve(this, 1) = c;
+   this->used++;
+}
+
+static void OutputWriter_putUnsigned(OutputWriter* this, unsigned long long value) {
+   char digits[20];
+   size_t n = 0;
+
+   do {
+      digits[sizeof(digits) - ++n] = (char)('0' + value % 10);
+      value /= 10;
+   } while (value);
+
+   memcpy(OutputWriter_reserve(this, n), digits + sizeof(digits) - n, n);
+   this->used += n;
+}
+
+static void OutputWriter_putUnicodeEscape(OutputWriter* this, unsigned int c) {
+   char* out = OutputWriter_reserve(this, 6);
+   out[0] = '\\';
+   out[1] = 'u';
+   out[2] = OutputWriter_hexDigits[(c >> 12) & 0xF];
+   out[3] = OutputWriter_hexDigits[(c >> 8) & 0xF];
+   out[4] = OutputWriter_hexDigits[(c >> 4) & 0xF];
+   out[5] = OutputWriter_hexDigits[c & 0xF];
+   this->used += 6;
+}
+
+/* Everything outside printable ASCII is escaped, keeping the output valid UTF-8 in any locale */
+static void OutputWriter_putJSONChar(OutputWriter* this, unsigned int c) {
+   switch (c) {
+      case '"':
+      case '\\':
+         OutputWriter_putChar(this, '\\');
+         OutputWriter_putChar(this, (char)c);
+         return;
+      case '\n':
+         OutputWriter_putChar(this, '\\');
+         OutputWriter_putChar(this, 'n');
+         return;
+      case '\t':
+         OutputWriter_putChar(this, '\\');
+         OutputWriter_putChar(this, 't');
+         return;
+      default:
+         break;
+   }
+
+   if (c >= 0x20 && c < 0x7F) {
+      OutputWriter_putChar(this, (char)c);
+   } else if (c <= 0xFFFF) {
+      OutputWriter_putUnicodeEscape(this, c);
+   } else if (c <= 0x10FFFF) {
+      c -= 0x10000;
+      OutputWriter_putUnicodeEscape(this, 0xD800 + (c >> 10));
+      OutputWriter_putUnicodeEscape(this, 0xDC00 + (c & 0x3FF));
+   } else {
+      OutputWriter_putUnicodeEscape(this, 0xFFFD);
+   }
+}
+
+static void OutputWriter_putJSONString(OutputWriter* this, const char* str) {
+   OutputWriter_putChar(this, '"');
+   for (const char* c = str; *c; c++)
+      OutputWriter_putJSONChar(this, (unsigned char)*c);
+   OutputWriter_putChar(this, '"');
+}
+
+static void OutputWriter_putCSVString(OutputWriter* this, const char* str) {
+   bool quote = strpbrk(str, ",\"\r\n") != NULL;
+
+   if (quote)
+      OutputWriter_putChar(this, '"');
+   for (const char* c = str; *c; c++) {
+      if (*c == '"')
+         OutputWriter_putChar(this, '"');
+      OutputWriter_putChar(this, *c);
+   }
+   if (quote)
+      OutputWriter_putChar(this, '"');
+}
+
+static inline unsigned int OutputWriter_charAt(const RichString* str, int i) {
+   return (unsigned int)RichString_getCharVal(*str, i);
+}
+
+static void OutputWriter_putJSONValue(OutputWriter* this, const RichString* str, int start, int end) {
+   OutputWriter_putChar(this, '"');
+   for (int i = start; i < end; i++)
+      OutputWriter_putJSONChar(this, OutputWriter_charAt(str, i));
+   OutputWriter_putChar(this, '"');
+}
+
+/* A numeric field, the same way in JSON and CSV but for unknown values */
+static void OutputWriter_putMachineValue(OutputWriter* this, const RowValue* value, bool json) {
+   switch (value->kind) {
+      case ROW_VALUE_NONE:
+         if (json) {
+            memcpy(OutputWriter_reserve(this, 4), "null", 4);
+            this->used += 4;
+         }
+         return;
+      case ROW_VALUE_SIGNED:
+         if (value->i < 0) {
+            OutputWriter_putChar(this, '-');
+            OutputWriter_putUnsigned(this, (unsigned long long)-(value->i + 1) + 1);
+         } else {
+            OutputWriter_putUnsigned(this, (unsigned long long)value->i);
+         }
+         return;
+      case ROW_VALUE_UNSIGNED:
+         OutputWriter_putUnsigned(this, value->u);
+         return;
+      case ROW_VALUE_REAL: {
+         /* Three decimals, without trailing zeros, so percentages read like 12.5 */
+         char buffer[DBL_MAX_10_EXP + 8];
+         int len = xSnprintf(buffer, sizeof(buffer), "%.3f", value->d);
+         while (buffer[len - 1] == '0')
+            len--;
+         if (buffer[len - 1] == '.')
+            len--;
+         memcpy(OutputWriter_reserve(this, (size_t)len), buffer, (size_t)len);
+         this->used += (size_t)len;
+         return;
+      }
+   }
+}
+
+/* Written in the encoding of the current locale, like the terminal would show it */
+static void OutputWriter_putCSVValue(OutputWriter* this, const RichString* str, int start, int end) {
+   bool quote = false;
+   for (int i = start; i < end && !quote; i++) {
+      unsigned int c = OutputWriter_charAt(str, i);
+      quote = c == ',' || c == '"' || c == '\r' || c == '\n';
+   }
+
+   if (quote)
+      OutputWriter_putChar(this, '"');
+
+#ifdef HAVE_LIBNCURSESW
+   mbstate_t state;
+   memset(&state, 0, sizeof(state));
+#endif
+
+   for (int i = start; i < end; i++) {
+      unsigned int c = OutputWriter_charAt(str, i);
+      if (c == '"')
+         OutputWriter_putChar(this, '"');
+
+#ifdef HAVE_LIBNCURSESW
+      if (c >= 0x80) {
+         char* out = OutputWriter_reserve(this, MB_LEN_MAX);
+         size_t len = wcrtomb(out, (wchar_t)c, &state);
+         if (len == (size_t)-1) {
+            memset(&state, 0, sizeof(state));
+            *out = '?';
+            len = 1;
+         }
+         this->used += len;
+         continue;
+      }
+#endif
+
+      OutputWriter_putChar(this, (char)c);
+   }
+
+   if (quote)
+      OutputWriter_putChar(this, '"');
+}
+
+static const char* OutputWriter_fieldName(const Settings* settings, RowField field) {
+   if (field >= ROW_DYNAMIC_FIELDS) {
+      const DynamicColumn* column = DynamicColumn_lookup(settings->dynamicColumns, field);
+      return column ? column->name : "";
+   }
+
+   return Process_fields[field].name ? Process_fields[field].name : "";
+}
+
+static void OutputWriter_writeCSVHeader(OutputWriter* this, const Settings* settings) {
+   const RowField* fields = settings->ss->fields;
+
+   memcpy(OutputWriter_reserve(this, 16), "sample,timestamp", 16);
+   this->used += 16;
+   for (int i = 0; fields[i]; i++) {
+      OutputWriter_putChar(this, ',');
+      OutputWriter_putCSVString(this, OutputWriter_fieldName(settings, fields[i]));
+   }
+   OutputWriter_putChar(this, '\n');
+}
+
+static void OutputWriter_writeRow(OutputWriter* this, const Settings* settings, const Row* row, unsigned int sample, uint64_t timestamp) {
+   const RowField* fields = settings->ss->fields;
+   bool json = this->format == OUTPUT_FORMAT_JSON;
+
+   if (json) {
+      memcpy(OutputWriter_reserve(this, 10), "{\"sample\":", 10);
+      this->used += 10;
+      OutputWriter_putUnsigned(this, sample);
+      memcpy(OutputWriter_reserve(this, 13), ",\"timestamp\":", 13);
+      this->used += 13;
+   } else {
+      OutputWriter_putUnsigned(this, sample);
+      OutputWriter_putChar(this, ',');
+   }
+   OutputWriter_putUnsigned(this, timestamp);
+
+   for (int i = 0; fields[i]; i++) {
+      OutputWriter_putChar(this, ',');
+      if (json) {
+         OutputWriter_putJSONString(this, OutputWriter_fieldName(settings, fields[i]));
+         OutputWriter_putChar(this, ':');
+      }
+
+      /* Numbers from the data of the row, not from how they are shown */
+      RowValue value;
+      if (Row_machineValue(row, fields[i], &value)) {
+         OutputWriter_putMachineValue(this, &value, json);
+         continue;
+      }
+
+      RichString_begin(str);
+      As_Row(row)->writeField(row, &str, fields[i]);
+
+      /* Drop the padding aligning the columns on screen */
+      int start = 0;
+      int end = RichString_sizeVal(str);
+      while (start < end && OutputWriter_charAt(&str, start) == ' ')
+         start++;
+      while (end > start && OutputWriter_charAt(&str, end - 1) == ' ')
+         end--;
+
+      if (json) {
+         OutputWriter_putJSONValue(this, &str, start, end);
+      } else {
+         OutputWriter_putCSVValue(this, &str, start, end);
+      }
+
+      RichString_delete(&str);
+   }
+
+   if (json)
+      OutputWriter_putChar(this, '}');
+   OutputWriter_putChar(this, '\n');
+}
+
+bool OutputWriter_writeTable(OutputWriter* this, const Table* table, unsigned int sample) {
+   const Machine* host = table->host;
+   const Settings* settings = host->settings;
+
+   if (this->format == OUTPUT_FORMAT_CSV && !this->headerWritten) {
+      OutputWriter_writeCSVHeader(this, settings);
+      this->headerWritten = true;
+   }
+
+   int size = Vector_size(table->displayList);
+   for (int i = 0; i < size; i++) {
+      const Row* row = (const Row*) Vector_get(table->displayList, i);
+
+      /* Same selection as Table_rebuildPanel, minus the rows of exited processes */
+      if (!row->show || row->tombStampMs > 0 || Row_matchesFilter(row, table))
+         continue;
+
+      OutputWriter_writeRow(this, settings, row, sample, host->realtimeMs);
+   }
+
+   OutputWriter_flush(this);
+   return !this->failed;
+}
@@ -0,0 +1,37 @@
+#ifndef HEADER_OutputWriter
+#define HEADER_OutputWriter
+/*
+htop - OutputWriter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "Table.h"
+
+
+typedef enum OutputFormat_ {
+   OUTPUT_FORMAT_NONE,
+   OUTPUT_FORMAT_JSON,
+   OUTPUT_FORMAT_CSV,
+} OutputFormat;
+
+typedef struct OutputWriter_ OutputWriter;
+
+/* Returns OUTPUT_FORMAT_NONE for unknown names */
+OutputFormat OutputFormat_fromName(const char* name);
+
+OutputWriter* OutputWriter_new(int fd, OutputFormat format);
+
+void OutputWriter_delete(OutputWriter* this);
+
+/*
+ * Emit the visible rows of the table's display list, one JSON object per
+ * line or one CSV record each, using the columns of the current screen.
+ * Returns false once writing to the file descriptor failed.
+ */
+bool OutputWriter_writeTable(OutputWriter* this, const Table* table, unsigned int sample);
+
+#endif /* HEADER_OutputWriter */
@@ -24,11 +24,13 @@ in the source distribution for its full text.
 #include "Hashtable.h"
 #include "Machine.h"
 #include "Macros.h"
+#include "ProcessFilter.h"
 #include "ProcessTable.h"
 #include "DynamicColumn.h"
 #include "RichString.h"
 #include "Scheduling.h"
 #include "Settings.h"
+#include "StringPool.h"
 #include "Table.h"
 #include "XUtils.h"
 
@@ -558,34 +560,8 @@ void Process_writeField(const Process* this, RichString* str, RowField field) {
          attr = CRT_colors[PROCESS_THREAD];
          baseattr = CRT_colors[PROCESS_THREAD_BASENAME];
       }
-      const ScreenSettings* ss = settings->ss;
-      if (!ss->treeView || super->indent == 0) {
-         Process_writeCommand(this, attr, baseattr, str);
-         return;
-      }
-
-      char* buf = buffer;
-      const bool lastItem = (super->indent < 0);
-
-      for (uint32_t indent = (super->indent < 0 ? -super->indent : super->indent); indent > 1; indent >>= 1) {
-         int written, ret;
-         if (indent & 1U) {
-            ret = xSnprintf(buf, n, "%s  ", CRT_treeStr[TREE_STR_VERT]);
-         } else {
-            ret = xSnprintf(buf, n, "   ");
-         }
-         if (ret < 0 || (size_t)ret >= n) {
-            written = n;
-         } else {
-            written = ret;
-         }
-         buf += written;
-         n -= written;
-      }
-
-      const char* draw = CRT_treeStr[lastItem ? TREE_STR_BEND : TREE_STR_RTEE];
-      xSnprintf(buf, n, "%s%s ", draw, super->showChildren ? CRT_treeStr[TREE_STR_SHUT] : CRT_treeStr[TREE_STR_OPEN] );
-      RichString_appendWide(str, CRT_colors[PROCESS_TREE], buffer);
+      if (settings->ss->treeView)
+         Row_writeTreeBranches(super, str);
       Process_writeCommand(this, attr, baseattr, str);
       return;
    }
@@ -766,12 +742,13 @@ void Process_writeField(const Process* this, RichString* str, RowField field) {
 
 void Process_done(Process* this) {
    assert(this != NULL);
-   free(this->cmdline);
-   free(this->procComm);
-   free(this->procExe);
-   free(this->procCwd);
+   StringPool_release(this->cmdline);
+   StringPool_release(this->procComm);
+   StringPool_release(this->procExe);
+   StringPool_release(this->procCwd);
    free(this->mergedCommand.str);
    free(this->tty_name);
+   Row_done(&this->super);
 }
 
 /* This function returns the string displayed in Command column, so that sorting
@@ -829,12 +806,16 @@ static bool Process_matchesFilter(const Process* this, const Table* table) {
    if (host->userId != (uid_t) -1 && this->st_uid != host->userId)
       return true;
 
-   const char* incFilter = table->incFilter;
-   if (incFilter && !String_contains_i(Process_getCommand(this), incFilter, true))
+   ProcessTable* pt = (ProcessTable*) host->activeTable;
+   assert(Object_isA((const Object*) pt, (const ObjectClass*) &ProcessTable_class));
+
+   /* Matching updates the results the process caches for the filter */
+   const ProcessFilter* filter = ProcessTable_getFilter(pt);
+   IGNORE_WCASTQUAL_BEGIN
+   if (filter && !ProcessFilter_matches(filter, (Process*) this))
       return true;
+   IGNORE_WCASTQUAL_END
 
-   const ProcessTable* pt = (const ProcessTable*) host->activeTable;
-   assert(Object_isA((const Object*) pt, (const ObjectClass*) &ProcessTable_class));
    if (pt->pidMatchList && !Hashtable_get(pt->pidMatchList, Process_getThreadGroup(this)))
       return true;
 
@@ -922,19 +903,19 @@ int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField
    case PERCENT_MEM:
       return SPACESHIP_NUMBER(p1->m_resident, p2->m_resident);
    case COMM:
-      return SPACESHIP_NULLSTR(Process_getCommand(p1), Process_getCommand(p2));
+      return StringPool_compare(Process_getCommand(p1), Process_getCommand(p2));
    case PROC_COMM: {
       const char* comm1 = p1->procComm ? p1->procComm : (Process_isKernelThread(p1) ? kthreadID : "");
       const char* comm2 = p2->procComm ? p2->procComm : (Process_isKernelThread(p2) ? kthreadID : "");
-      return SPACESHIP_NULLSTR(comm1, comm2);
+      return StringPool_compare(comm1, comm2);
    }
    case PROC_EXE: {
       const char* exe1 = p1->procExe ? (p1->procExe + p1->procExeBasenameOffset) : (Process_isKernelThread(p1) ? kthreadID : "");
       const char* exe2 = p2->procExe ? (p2->procExe + p2->procExeBasenameOffset) : (Process_isKernelThread(p2) ? kthreadID : "");
-      return SPACESHIP_NULLSTR(exe1, exe2);
+      return StringPool_compare(exe1, exe2);
    }
    case CWD:
-      return SPACESHIP_NULLSTR(p1->procCwd, p2->procCwd);
+      return StringPool_compare(p1->procCwd, p2->procCwd);
    case ELAPSED:
       r = -SPACESHIP_NUMBER(p1->starttime_ctime, p2->starttime_ctime);
       return r != 0 ? r : SPACESHIP_NUMBER(Process_getPid(p1), Process_getPid(p2));
@@ -989,17 +970,172 @@ int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField
    }
 }
 
-void Process_updateComm(Process* this, const char* comm) {
-   if (!this->procComm && !comm)
-      return;
+/* Start time and PID in one key, as their comparison falls back to the PID */
+static bool Process_starttimeKey(const Process* this, bool elapsed, uint64_t* result) {
+   const uint64_t maxStarttime = (UINT64_C(1) << 40) - 1;
+   const uint64_t maxPid = (UINT64_C(1) << 23) - 1;
 
-   if (this->procComm && comm && String_eq(this->procComm, comm))
-      return;
+   pid_t pid = Process_getPid(this);
+   if (this->starttime_ctime < 0 || (uint64_t)this->starttime_ctime > maxStarttime || pid < 0 || (uint64_t)pid > maxPid)
+      return false;
 
-   free(this->procComm);
-   this->procComm = comm ? xStrdup(comm) : NULL;
+   uint64_t starttime = (uint64_t)this->starttime_ctime;
+   *result = ((elapsed ? maxStarttime - starttime : starttime) << 23) | (uint64_t)pid;
+   return true;
+}
+
+bool Process_numericKeyBase(const Process* this, ProcessField key, uint64_t* result) {
+   switch (key) {
+   case PERCENT_CPU:
+   case PERCENT_NORM_CPU:
+      *result = Row_keyFromReal(this->percent_cpu);
+      return true;
+   case PERCENT_MEM:
+   case M_RESIDENT:
+      *result = Row_keyFromSigned(this->m_resident);
+      return true;
+   case ELAPSED:
+      return Process_starttimeKey(this, true, result);
+   case STARTTIME:
+      return Process_starttimeKey(this, false, result);
+   case MAJFLT:
+      *result = this->majflt;
+      return true;
+   case MINFLT:
+      *result = this->minflt;
+      return true;
+   case M_VIRT:
+      *result = Row_keyFromSigned(this->m_virt);
+      return true;
+   case NICE:
+      *result = Row_keyFromSigned(this->nice);
+      return true;
+   case NLWP:
+      *result = Row_keyFromSigned(this->nlwp);
+      return true;
+   case PGRP:
+      *result = Row_keyFromSigned(this->pgrp);
+      return true;
+   case PID:
+      *result = Row_keyFromSigned(Process_getPid(this));
+      return true;
+   case PPID:
+      *result = Row_keyFromSigned(Process_getParent(this));
+      return true;
+   case PRIORITY:
+      *result = Row_keyFromSigned(this->priority);
+      return true;
+   case PROCESSOR:
+      *result = Row_keyFromSigned(this->processor);
+      return true;
+   case SCHEDULERPOLICY:
+      *result = Row_keyFromSigned(this->scheduling_policy);
+      return true;
+   case SESSION:
+      *result = Row_keyFromSigned(this->session);
+      return true;
+   case STATE:
+      *result = Row_keyFromSigned(this->state);
+      return true;
+   case ST_UID:
+      *result = this->st_uid;
+      return true;
+   case TIME:
+      *result = this->time;
+      return true;
+   case TGID:
+      *result = Row_keyFromSigned(Process_getThreadGroup(this));
+      return true;
+   case TPGID:
+      *result = Row_keyFromSigned(this->tpgid);
+      return true;
+   default:
+      return false;
+   }
+}
+
+bool Process_rowNumericKey(const Row* super, RowField key, uint64_t* result) {
+   const Process* this = (const Process*) super;
+   assert(Object_isA((const Object*) this, (const ObjectClass*) &Process_class));
+
+   /* Platforms may order any field their own way; only trust those saying how */
+   if (!As_Process(this)->numericKey)
+      return false;
+
+   return As_Process(this)->numericKey(this, key, result);
+}
+
+bool Process_machineValueBase(const Process* this, ProcessField field, RowValue* value) {
+   const Machine* host = this->super.host;
+
+   switch (field) {
+   case PERCENT_CPU:
+      return Row_valueReal(value, this->percent_cpu);
+   case PERCENT_NORM_CPU:
+      return Row_valueReal(value, this->percent_cpu / host->activeCPUs);
+   case PERCENT_MEM:
+      return Row_valueReal(value, this->percent_mem);
+   case M_RESIDENT:
+      return Row_valueSigned(value, this->m_resident);
+   case M_VIRT:
+      return Row_valueSigned(value, this->m_virt);
+   case TIME:
+      return Row_valueUnsigned(value, this->time);
+   case ELAPSED: {
+      const uint64_t st = (uint64_t)this->starttime_ctime * 1000;
+      return Row_valueUnsigned(value, host->realtimeMs < st ? 0 : (host->realtimeMs - st) / 10);
+   }
+   case STARTTIME:
+      return Row_valueSigned(value, this->starttime_ctime);
+   case MAJFLT:
+      return Row_valueUnsigned(value, this->majflt);
+   case MINFLT:
+      return Row_valueUnsigned(value, this->minflt);
+   case NICE:
+      if (this->nice == PROCESS_NICE_UNKNOWN)
+         return Row_valueNone(value);
+      return Row_valueSigned(value, this->nice);
+   case NLWP:
+      return Row_valueSigned(value, this->nlwp);
+   case PGRP:
+      return Row_valueSigned(value, this->pgrp);
+   case PID:
+      return Row_valueSigned(value, Process_getPid(this));
+   case PPID:
+      return Row_valueSigned(value, Process_getParent(this));
+   case PRIORITY:
+      return Row_valueSigned(value, this->priority);
+   case PROCESSOR:
+      return Row_valueSigned(value, this->processor);
+   case SESSION:
+      return Row_valueSigned(value, this->session);
+   case ST_UID:
+      return Row_valueUnsigned(value, this->st_uid);
+   case TGID:
+      return Row_valueSigned(value, Process_getThreadGroup(this));
+   case TPGID:
+      return Row_valueSigned(value, this->tpgid);
+   default:
+      return false;
+   }
+}
+
+bool Process_rowMachineValue(const Row* super, RowField field, RowValue* value) {
+   const Process* this = (const Process*) super;
+   assert(Object_isA((const Object*) this, (const ObjectClass*) &Process_class));
+
+   if (As_Process(this)->machineValue)
+      return As_Process(this)->machineValue(this, field, value);
+
+   return Process_machineValueBase(this, field, value);
+}
+
+void Process_updateComm(Process* this, const char* comm) {
+   if (!StringPool_replace(&this->procComm, comm))
+      return;
 
    this->mergedCommand.lastUpdate = 0;
+   this->filterStamp = 0;
 }
 
 static int skipPotentialPath(const char* cmdline, int end) {
@@ -1029,14 +1165,9 @@ void Process_updateCmdline(Process* this, const char* cmdline, int basenameStart
    assert((basenameEnd > basenameStart) || (basenameEnd == 0 && basenameStart == 0));
    assert((cmdline && basenameEnd <= (int)strlen(cmdline)) || (!cmdline && basenameEnd == 0));
 
-   if (!this->cmdline && !cmdline)
-      return;
-
-   if (this->cmdline && cmdline && String_eq(this->cmdline, cmdline))
+   if (!StringPool_replace(&this->cmdline, cmdline))
       return;
 
-   free(this->cmdline);
-   this->cmdline = cmdline ? xStrdup(cmdline) : NULL;
    if (Process_isKernelThread(this)) {
       /* kernel threads have no basename */
       this->cmdlineBasenameStart = 0;
@@ -1047,26 +1178,26 @@ void Process_updateCmdline(Process* this, const char* cmdline, int basenameStart
    }
 
    this->mergedCommand.lastUpdate = 0;
+   this->filterStamp = 0;
 }
 
 void Process_updateExe(Process* this, const char* exe) {
-   if (!this->procExe && !exe)
+   if (!StringPool_replace(&this->procExe, exe))
       return;
 
-   if (this->procExe && exe && String_eq(this->procExe, exe))
-      return;
-
-   free(this->procExe);
    if (exe) {
-      this->procExe = xStrdup(exe);
       const char* lastSlash = strrchr(exe, '/');
       this->procExeBasenameOffset = (lastSlash && *(lastSlash + 1) != '\0' && lastSlash != exe) ? (lastSlash - exe + 1) : 0;
    } else {
-      this->procExe = NULL;
       this->procExeBasenameOffset = 0;
    }
 
    this->mergedCommand.lastUpdate = 0;
+   this->filterStamp = 0;
+}
+
+void Process_updateCwd(Process* this, const char* cwd) {
+   StringPool_replace(&this->procCwd, cwd);
 }
 
 void Process_updateCPUFieldWidths(float percentage) {
@@ -1096,6 +1227,10 @@ const ProcessClass Process_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .sortKeyString = Process_rowGetSortKey,
       .compareByParent = Process_compareByParent,
+      .numericKey = Process_rowNumericKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = Process_rowWriteField
    },
+   .numericKey = Process_numericKeyBase,
+   .machineValue = Process_machineValueBase,
 };
@@ -125,8 +125,9 @@ typedef struct Process_ {
    /*
     * Process name including arguments.
     * Use Process_getCommand() for Command actually displayed.
+    * This and the other strings of the process below are in the StringPool.
     */
-   char* cmdline;
+   const char* cmdline;
 
    /* End Offset in cmdline of the process basename */
    int cmdlineBasenameEnd;
@@ -135,13 +136,13 @@ typedef struct Process_ {
    int cmdlineBasenameStart;
 
    /* The process' "command" name */
-   char* procComm;
+   const char* procComm;
 
    /* The main process executable */
-   char* procExe;
+   const char* procExe;
 
    /* The process/thread working directory */
-   char* procCwd;
+   const char* procCwd;
 
    /* Offset in procExe of the process basename */
    int procExeBasenameOffset;
@@ -198,6 +199,10 @@ typedef struct Process_ {
     * Internal state for merged Command display
     */
    ProcessMergedCommand mergedCommand;
+
+   /* Results of the command terms of the filter with this stamp, see ProcessFilter */
+   uint32_t filterStamp;
+   uint64_t filterMatches;
 } Process;
 
 typedef struct ProcessFieldData_ {
@@ -240,10 +245,14 @@ extern const ProcessFieldData Process_fields[LAST_PROCESSFIELD];
 
 typedef Process* (*Process_New)(const struct Machine_*);
 typedef int (*Process_CompareByKey)(const Process*, const Process*, ProcessField);
+typedef bool (*Process_NumericKey)(const Process*, ProcessField, uint64_t*);
+typedef bool (*Process_MachineValue)(const Process*, ProcessField, RowValue*);
 
 typedef struct ProcessClass_ {
    const RowClass super;
    const Process_CompareByKey compareByKey;
+   const Process_NumericKey numericKey;   /* must order exactly like compareByKey where it answers */
+   const Process_MachineValue machineValue;
 } ProcessClass;
 
 #define As_Process(this_)   ((const ProcessClass*)((this_)->super.super.klass))
@@ -323,11 +332,21 @@ static inline int Process_pidEqualCompare(const void* v1, const void* v2) {
 
 int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField key);
 
+/* Integer keys of the numeric fields known to all platforms, sorting like Process_compareByKey_Base */
+bool Process_numericKeyBase(const Process* this, ProcessField key, uint64_t* result);
+
+bool Process_rowNumericKey(const Row* super, RowField key, uint64_t* result);
+
+bool Process_machineValueBase(const Process* this, ProcessField field, RowValue* value);
+
+bool Process_rowMachineValue(const Row* super, RowField field, RowValue* value);
+
 const char* Process_getCommand(const Process* this);
 
 void Process_updateComm(Process* this, const char* comm);
 void Process_updateCmdline(Process* this, const char* cmdline, int basenameStart, int basenameEnd);
 void Process_updateExe(Process* this, const char* exe);
+void Process_updateCwd(Process* this, const char* cwd);
 
 /* This function constructs the string that is displayed by
  * Process_writeCommand and also returned by Process_getCommand */
@@ -0,0 +1,414 @@
+/*
+htop - ProcessFilter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ProcessFilter.h"
+
+#include <ctype.h>
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "Macros.h"
+#include "RichString.h"
+#include "Row.h"
+#include "XUtils.h"
+
+
+/* Command terms beyond this many are not cached */
+#define PROCESSFILTER_CACHED_TERMS 64
+
+typedef enum ProcessFilterKind_ {
+   PROCESSFILTER_COMMAND,
+   PROCESSFILTER_REGEX,
+   PROCESSFILTER_COLUMN,
+   PROCESSFILTER_NUMBER,
+} ProcessFilterKind;
+
+typedef enum ProcessFilterNumber_ {
+   PROCESSFILTER_CPU,
+   PROCESSFILTER_MEM,
+   PROCESSFILTER_RSS,
+   PROCESSFILTER_VIRT,
+   PROCESSFILTER_PID,
+   PROCESSFILTER_PPID,
+   PROCESSFILTER_NICE,
+   PROCESSFILTER_PRIO,
+   PROCESSFILTER_THREADS,
+   PROCESSFILTER_TIME,
+} ProcessFilterNumber;
+
+typedef enum ProcessFilterOp_ {
+   PROCESSFILTER_LT,
+   PROCESSFILTER_LE,
+   PROCESSFILTER_GT,
+   PROCESSFILTER_GE,
+   PROCESSFILTER_EQ,
+   PROCESSFILTER_NE,
+} ProcessFilterOp;
+
+struct ProcessFilterTerm_ {
+   ProcessFilterKind kind;
+   bool negate;
+   bool lastOfGroup;          /* closes an alternative */
+   int cacheBit;              /* bit of the cached command results, -1 if not cached */
+   char* text;
+   regex_t regex;
+   ProcessField column;
+   ProcessFilterNumber number;
+   ProcessFilterOp op;
+   double value;
+};
+
+static const struct {
+   const char* name;
+   ProcessFilterNumber number;
+   bool size;
+} ProcessFilter_numbers[] = {
+   { "cpu",     PROCESSFILTER_CPU,     false },
+   { "mem",     PROCESSFILTER_MEM,     false },
+   { "rss",     PROCESSFILTER_RSS,     true },
+   { "virt",    PROCESSFILTER_VIRT,    true },
+   { "pid",     PROCESSFILTER_PID,     false },
+   { "ppid",    PROCESSFILTER_PPID,    false },
+   { "nice",    PROCESSFILTER_NICE,    false },
+   { "prio",    PROCESSFILTER_PRIO,    false },
+   { "threads", PROCESSFILTER_THREADS, false },
+   { "time",    PROCESSFILTER_TIME,    false },
+};
+
+static uint32_t ProcessFilter_lastStamp;
+
+/* Parse "name<op>number" */
+static bool ProcessFilter_parseNumber(ProcessFilterTerm* term, const char* text) {
+   size_t nameLen = 0;
+   while (isalpha((unsigned char)text[nameLen]))
+      nameLen++;
+
+   size_t i;
+   for (i = 0; i < ARRAYSIZE(ProcessFilter_numbers); i++)
+      if (strlen(ProcessFilter_numbers[i].name) == nameLen && strncasecmp(text, ProcessFilter_numbers[i].name, nameLen) == 0)
+         break;
+   if (i == ARRAYSIZE(ProcessFilter_numbers))
+      return false;
+
+   static const struct {
+      const char* spelling;
+      ProcessFilterOp op;
+   } ops[] = {
+      { ">=", PROCESSFILTER_GE },
+      { "<=", PROCESSFILTER_LE },
+      { "!=", PROCESSFILTER_NE },
+      { ">",  PROCESSFILTER_GT },
+      { "<",  PROCESSFILTER_LT },
+      { "=",  PROCESSFILTER_EQ },
+   };
+
+   const char* op = text + nameLen;
+   size_t j;
+   for (j = 0; j < ARRAYSIZE(ops); j++)
+      if (String_startsWith(op, ops[j].spelling))
+         break;
+   if (j == ARRAYSIZE(ops))
+      return false;
+
+   term->op = ops[j].op;
+   const char* number = op + strlen(ops[j].spelling);
+   char* end;
+   double value = strtod(number, &end);
+   if (end == number)
+      return false;
+
+   if (ProcessFilter_numbers[i].size) {
+      switch (toupper((unsigned char)*end)) {
+         case 'T': value *= 1024.0;  /* FALLTHRU */
+         case 'G': value *= 1024.0;  /* FALLTHRU */
+         case 'M': value *= 1024.0;  /* FALLTHRU */
+         case 'K': end++; break;
+      }
+   }
+   if (*end)
+      return false;
+
+   term->kind = PROCESSFILTER_NUMBER;
+   term->number = ProcessFilter_numbers[i].number;
+   term->value = value;
+   return true;
+}
+
+/* Parse "column:text" for the name of a column of the process list */
+static bool ProcessFilter_parseColumn(ProcessFilterTerm* term, const char* text) {
+   const char* colon = strchr(text, ':');
+   if (!colon || colon == text)
+      return false;
+
+   size_t nameLen = (size_t)(colon - text);
+   for (int i = 1; i < LAST_PROCESSFIELD; i++) {
+      const char* name = Process_fields[i].name;
+      if (!name || strlen(name) != nameLen || strncasecmp(text, name, nameLen) != 0)
+         continue;
+
+      term->kind = PROCESSFILTER_COLUMN;
+      term->column = i;
+      term->text = xStrdup(colon + 1);
+      return true;
+   }
+
+   return false;
+}
+
+static void ProcessFilter_compileTerm(ProcessFilterTerm* term, const char* text, bool quoted) {
+   if (!quoted) {
+      if (String_startsWith(text, "re:") && text[3]) {
+         if (regcomp(&term->regex, text + 3, REG_EXTENDED | REG_ICASE | REG_NOSUB) == 0) {
+            term->kind = PROCESSFILTER_REGEX;
+            return;
+         }
+         /* Taken as a fixed string while it is no valid regex, like when still typed */
+      } else if (ProcessFilter_parseNumber(term, text) || ProcessFilter_parseColumn(term, text)) {
+         return;
+      }
+   }
+
+   term->kind = PROCESSFILTER_COMMAND;
+   term->text = xStrdup(text);
+}
+
+static ProcessFilterTerm* ProcessFilter_addTerm(ProcessFilter* this, size_t* capacity) {
+   if (this->count == *capacity) {
+      *capacity = *capacity ? 2 * *capacity : 4;
+      this->terms = xReallocArray(this->terms, *capacity, sizeof(ProcessFilterTerm));
+   }
+
+   ProcessFilterTerm* term = &this->terms[this->count++];
+   *term = (ProcessFilterTerm) { .cacheBit = -1 };
+   return term;
+}
+
+/* The plain filter: fixed strings separated by "|", blanks included as typed */
+static void ProcessFilter_parseLiteral(ProcessFilter* this, const char* text) {
+   size_t capacity = 0;
+
+   for (const char* s = text; *s; ) {
+      size_t len = strcspn(s, "|");
+
+      ProcessFilterTerm* term = ProcessFilter_addTerm(this, &capacity);
+      term->kind = PROCESSFILTER_COMMAND;
+      term->lastOfGroup = true;
+      term->text = xStrndup(s, len);
+      if (this->count <= PROCESSFILTER_CACHED_TERMS)
+         term->cacheBit = (int)this->count - 1;
+
+      s += len;
+      if (*s)
+         s++;
+   }
+}
+
+/* The filter following PROCESSFILTER_EXTENDED_PREFIX */
+static void ProcessFilter_parseExtended(ProcessFilter* this, const char* text) {
+   size_t capacity = 0;
+   int cacheBits = 0;
+
+   char* token = xMalloc(strlen(text) + 1);
+   const char* s = text;
+   for (;;) {
+      while (*s == ' ' || *s == '\t')
+         s++;
+
+      if (*s == '|' || !*s) {
+         if (this->count)
+            this->terms[this->count - 1].lastOfGroup = true;
+         if (!*s)
+            break;
+         s++;
+         continue;
+      }
+
+      bool negate = false;
+      if (*s == '!') {
+         negate = true;
+         s++;
+      }
+
+      size_t len = 0;
+      bool quoted = *s == '"';
+      if (quoted) {
+         s++;
+         while (*s && *s != '"')
+            token[len++] = *s++;
+         if (*s)
+            s++;
+      } else {
+         while (*s && *s != ' ' && *s != '\t' && *s != '|')
+            token[len++] = *s++;
+      }
+      token[len] = '\0';
+
+      /* A lone "!" while typing filters nothing yet */
+      if (!len && !quoted)
+         continue;
+
+      ProcessFilterTerm* term = ProcessFilter_addTerm(this, &capacity);
+      term->negate = negate;
+      ProcessFilter_compileTerm(term, token, quoted);
+
+      if (term->kind == PROCESSFILTER_COMMAND || term->kind == PROCESSFILTER_REGEX) {
+         if (cacheBits < PROCESSFILTER_CACHED_TERMS)
+            term->cacheBit = cacheBits++;
+      } else if (term->kind == PROCESSFILTER_COLUMN) {
+         this->flags |= Process_fields[term->column].flags;
+      }
+   }
+   free(token);
+}
+
+ProcessFilter* ProcessFilter_new(const char* text) {
+   ProcessFilter* this = xCalloc(1, sizeof(ProcessFilter));
+
+   if (String_startsWith(text, PROCESSFILTER_EXTENDED_PREFIX))
+      ProcessFilter_parseExtended(this, text + strlen(PROCESSFILTER_EXTENDED_PREFIX));
+   else
+      ProcessFilter_parseLiteral(this, text);
+
+   if (!this->count) {
+      ProcessFilter_delete(this);
+      return NULL;
+   }
+
+   if (++ProcessFilter_lastStamp == 0)
+      ProcessFilter_lastStamp = 1;
+   this->stamp = ProcessFilter_lastStamp;
+   return this;
+}
+
+void ProcessFilter_delete(ProcessFilter* this) {
+   for (size_t i = 0; i < this->count; i++) {
+      ProcessFilterTerm* term = &this->terms[i];
+      if (term->kind == PROCESSFILTER_REGEX)
+         regfree(&term->regex);
+      free(term->text);
+   }
+   free(this->terms);
+   free(this);
+}
+
+static bool ProcessFilter_matchesCommand(const ProcessFilterTerm* term, const Process* process) {
+   const char* command = Process_getCommand(process);
+   if (!command)
+      command = "";
+
+   if (term->kind == PROCESSFILTER_REGEX)
+      return regexec(&term->regex, command, 0, NULL, 0) == 0;
+
+   return strcasestr(command, term->text) != NULL;
+}
+
+static bool ProcessFilter_matchesColumn(const ProcessFilterTerm* term, const Process* process) {
+   if (term->column == USER) {
+      char uid[16];
+      const char* user = process->user;
+      if (!user) {
+         xSnprintf(uid, sizeof(uid), "%u", (unsigned int)process->st_uid);
+         user = uid;
+      }
+      return strcasestr(user, term->text) != NULL;
+   }
+
+   const Row* row = &process->super;
+   RichString_begin(str);
+   As_Row(row)->writeField(row, &str, term->column);
+
+   int size = RichString_sizeVal(str);
+   char* text = xMalloc((size_t)size + 1);
+   for (int i = 0; i < size; i++) {
+      unsigned int ch = (unsigned int)RichString_getCharVal(str, i);
+      text[i] = ch < 128 ? (char)ch : '?';
+   }
+   text[size] = '\0';
+   RichString_delete(&str);
+
+   /* Drop the padding aligning the columns on screen */
+   char* trimmed = String_trim(text);
+   bool result = strcasestr(trimmed, term->text) != NULL;
+   free(trimmed);
+   free(text);
+   return result;
+}
+
+static double ProcessFilter_numberOf(ProcessFilterNumber number, const Process* process) {
+   switch (number) {
+      case PROCESSFILTER_CPU:     return process->percent_cpu;
+      case PROCESSFILTER_MEM:     return process->percent_mem;
+      case PROCESSFILTER_RSS:     return process->m_resident;
+      case PROCESSFILTER_VIRT:    return process->m_virt;
+      case PROCESSFILTER_PID:     return Process_getPid(process);
+      case PROCESSFILTER_PPID:    return Process_getParent(process);
+      case PROCESSFILTER_NICE:    return process->nice;
+      case PROCESSFILTER_PRIO:    return process->priority;
+      case PROCESSFILTER_THREADS: return process->nlwp;
+      case PROCESSFILTER_TIME:    return process->time / 100.0;
+   }
+   return 0.0;
+}
+
+static bool ProcessFilter_matchesNumber(const ProcessFilterTerm* term, const Process* process) {
+   double value = ProcessFilter_numberOf(term->number, process);
+   switch (term->op) {
+      case PROCESSFILTER_LT: return value < term->value;
+      case PROCESSFILTER_LE: return value <= term->value;
+      case PROCESSFILTER_GT: return value > term->value;
+      case PROCESSFILTER_GE: return value >= term->value;
+      case PROCESSFILTER_EQ: return !(value < term->value || value > term->value);
+      case PROCESSFILTER_NE: return value < term->value || value > term->value;
+   }
+   return false;
+}
+
+bool ProcessFilter_matches(const ProcessFilter* this, Process* process) {
+   if (process->filterStamp != this->stamp) {
+      uint64_t matches = 0;
+      for (size_t i = 0; i < this->count; i++) {
+         const ProcessFilterTerm* term = &this->terms[i];
+         if (term->cacheBit >= 0 && ProcessFilter_matchesCommand(term, process))
+            matches |= UINT64_C(1) << term->cacheBit;
+      }
+      process->filterMatches = matches;
+      process->filterStamp = this->stamp;
+   }
+
+   bool groupMatches = true;
+   for (size_t i = 0; i < this->count; i++) {
+      const ProcessFilterTerm* term = &this->terms[i];
+
+      /* Skip the rest of an alternative once it failed */
+      if (groupMatches) {
+         bool result;
+         if (term->cacheBit >= 0)
+            result = (process->filterMatches & (UINT64_C(1) << term->cacheBit)) != 0;
+         else if (term->kind == PROCESSFILTER_NUMBER)
+            result = ProcessFilter_matchesNumber(term, process);
+         else if (term->kind == PROCESSFILTER_COLUMN)
+            result = ProcessFilter_matchesColumn(term, process);
+         else
+            result = ProcessFilter_matchesCommand(term, process);
+
+         groupMatches = result != term->negate;
+      }
+
+      if (term->lastOfGroup) {
+         if (groupMatches)
+            return true;
+         groupMatches = true;
+      }
+   }
+
+   return false;
+}
@@ -0,0 +1,55 @@
+#ifndef HEADER_ProcessFilter
+#define HEADER_ProcessFilter
+/*
+htop - ProcessFilter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Process.h"
+
+
+/*
+ * The filter of the process list, compiled once when its text changes.
+ * Plain text matches the command case-insensitively as fixed strings
+ * separated by "|", blanks included. Text starting with
+ * PROCESSFILTER_EXTENDED_PREFIX is parsed into terms instead: blank
+ * separated terms must all match, "|" separates alternatives, so
+ * "?a b|c" keeps the processes matching both a and b, and those matching c.
+ * A term matches the command as a fixed string, unless it takes one of
+ * the forms
+ *    !term           the term must not match
+ *    "a b"           a fixed string including blanks
+ *    re:regex        an extended regular expression for the command
+ *    column:text     the text of a column, like user:root or cgroup:docker
+ *    name>number     also <, >=, <=, = and != for cpu, mem, rss, virt, pid,
+ *                    ppid, nice, prio, threads and time (in seconds); sizes
+ *                    are in KiB unless followed by K, M, G or T
+ * Each process keeps the results of the command terms until its command
+ * or the filter changes.
+ */
+#define PROCESSFILTER_EXTENDED_PREFIX "?"
+
+typedef struct ProcessFilterTerm_ ProcessFilterTerm;
+
+typedef struct ProcessFilter_ {
+   ProcessFilterTerm* terms;
+   size_t count;
+   uint32_t stamp;            /* identifies the filter in the caches of the processes */
+   uint32_t flags;            /* process flags of the columns filtered on */
+} ProcessFilter;
+
+/* Compile the text of a filter; NULL if it lets every process pass */
+ProcessFilter* ProcessFilter_new(const char* text);
+
+void ProcessFilter_delete(ProcessFilter* this);
+
+/* Whether the process passes; updates the cached results of the process */
+bool ProcessFilter_matches(const ProcessFilter* this, Process* process);
+
+#endif
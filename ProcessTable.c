@@ -13,6 +13,7 @@ in the source distribution for its full text.
 #include <stdlib.h>
 
 #include "Hashtable.h"
+#include "ProcessFilter.h"
 #include "Row.h"
 #include "Settings.h"
 #include "Vector.h"
@@ -25,9 +26,23 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
 }
 
 void ProcessTable_done(ProcessTable* this) {
+   if (this->filter)
+      ProcessFilter_delete(this->filter);
    Table_done(&this->super);
 }
 
+const ProcessFilter* ProcessTable_getFilter(ProcessTable* this) {
+   const Table* super = &this->super;
+   if (this->filterStamp == super->incFilterStamp)
+      return this->filter;
+
+   if (this->filter)
+      ProcessFilter_delete(this->filter);
+   this->filter = super->incFilter ? ProcessFilter_new(super->incFilter) : NULL;
+   this->filterStamp = super->incFilterStamp;
+   return this->filter;
+}
+
 Process* ProcessTable_getProcess(ProcessTable* this, pid_t pid, bool* preExisting, Process_New constructor) {
    const Table* table = &this->super;
    Process* proc = (Process*) Hashtable_get(table->table, pid);
@@ -68,7 +83,12 @@ static void ProcessTable_cleanupEntries(Table* super) {
       Process* p = (Process*) Vector_get(super->rows, i);
 
       // tidy up Process state after refreshing the ProcessTable table
+      uint64_t commandStamp = p->mergedCommand.lastUpdate;
       Process_makeCommandStr(p, settings);
+      if (p->mergedCommand.lastUpdate != commandStamp) {
+         Row_markDirty(&p->super);
+         p->filterStamp = 0;
+      }
 
       // keep track of the highest UID for column scaling
       if (p->st_uid > host->maxUserId)
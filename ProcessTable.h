@@ -22,6 +22,9 @@ typedef struct ProcessTable_ {
 
    Hashtable* pidMatchList;
 
+   struct ProcessFilter_* filter; /* compiled from incFilter, see ProcessTable_getFilter */
+   unsigned int filterStamp;      /* incFilterStamp the filter was compiled for */
+
    unsigned int totalTasks;
    unsigned int runningTasks;
    unsigned int userlandThreads;
@@ -37,6 +40,9 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
 
 void ProcessTable_done(ProcessTable* this);
 
+/* The incremental filter of the table, compiled again after it changed */
+const struct ProcessFilter_* ProcessTable_getFilter(ProcessTable* this);
+
 extern const TableClass ProcessTable_class;
 
 static inline void ProcessTable_add(ProcessTable* this, Process* process) {
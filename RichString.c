@@ -62,6 +62,12 @@ void RichString_rewind(RichString* this, int count) {
    RichString_setLen(this, this->chlen - count);
 }
 
+void RichString_appendCells(RichString* this, const CharType* cells, int len) {
+   int from = this->chlen;
+   RichString_setLen(this, from + len);
+   memcpy(this->chptr + from, cells, charBytes(len));
+}
+
 #ifdef HAVE_LIBNCURSESW
 
 static size_t mbstowcs_nonfatal(wchar_t* restrict dest, const char* restrict src, size_t n) {
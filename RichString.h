@@ -50,6 +50,9 @@ void RichString_delete(RichString* this);
 
 void RichString_rewind(RichString* this, int count);
 
+/* Appends characters taken from another RichString, along with their attributes */
+void RichString_appendCells(RichString* this, const CharType* cells, int len);
+
 void RichString_setAttrn(RichString* this, int attrs, int start, int charcount);
 
 int RichString_findChar(const RichString* this, char c, int start);
@@ -32,6 +32,35 @@ in the source distribution for its full text.
 int Row_pidDigits = ROW_MIN_PID_DIGITS;
 int Row_uidDigits = ROW_MIN_UID_DIGITS;
 
+/*
+ * A rendered line depends on the values of its row, tracked by the row
+ * version, on the row's place in the tree and on state shared by all rows:
+ * the settings, tracked by their lastUpdate stamp, and the column layout.
+ */
+typedef struct RowLineCache_ {
+   bool valid;
+   bool tag;
+   bool showChildren;
+   int32_t indent;
+   uint32_t version;
+   uint32_t layoutStamp;
+   uint64_t settingsStamp;
+   int len;
+   int capacity;
+   CharType* cells;
+} RowLineCache;
+
+/* Column layout the rendered lines were built for */
+static uint32_t Row_layoutStamp = 1;
+static uint64_t Row_layoutFieldsHash;
+static const ScreenSettings* Row_layoutScreen;
+static bool Row_layoutTreeView;
+static uint64_t Row_layoutRealtimeMs;
+static unsigned int Row_layoutActiveCPUs;
+static int Row_layoutPidDigits;
+static int Row_layoutUidDigits;
+static uint8_t Row_layoutWidths[LAST_RESERVED_FIELD];
+
 void Row_init(Row* this, const Machine* host) {
    this->host = host;
    this->tag = false;
@@ -39,11 +68,25 @@ void Row_init(Row* this, const Machine* host) {
    this->show = true;
    this->wasShown = false;
    this->updated = false;
+   this->lineCache = xCalloc(1, sizeof(RowLineCache));
 }
 
 void Row_done(Row* this) {
    assert(this != NULL);
-   (void) this;
+   Row_releaseLineCache(this);
+   free(this->lineCache);
+}
+
+void Row_releaseLineCache(Row* this) {
+   RowLineCache* cache = this->lineCache;
+   free(cache->cells);
+   cache->cells = NULL;
+   cache->capacity = 0;
+   cache->valid = false;
+}
+
+bool Row_hasLineCache(const Row* this) {
+   return this->lineCache->valid;
 }
 
 static inline bool Row_isNew(const Row* this) {
@@ -59,19 +102,90 @@ static inline bool Row_isTomb(const Row* this) {
    return this->tombStampMs > 0;
 }
 
+/*
+ * Changes whenever the columns, their widths or the tree mode change, and
+ * with the machine values some columns are computed from at display time
+ */
+static uint32_t Row_currentLayoutStamp(const Machine* host) {
+   const ScreenSettings* ss = host->settings->ss;
+   uint64_t realtimeMs = 0;
+   unsigned int activeCPUs = 0;
+
+   uint64_t fieldsHash = 0xcbf29ce484222325ULL;
+   for (const RowField* field = ss->fields; *field; field++) {
+      fieldsHash ^= (uint64_t)*field;
+      fieldsHash *= 0x100000001b3ULL;
+
+      if (*field == ELAPSED)
+         realtimeMs = host->realtimeMs;
+      else if (*field == PERCENT_NORM_CPU)
+         activeCPUs = host->activeCPUs;
+   }
+
+   if (ss != Row_layoutScreen ||
+       ss->treeView != Row_layoutTreeView ||
+       fieldsHash != Row_layoutFieldsHash ||
+       realtimeMs != Row_layoutRealtimeMs ||
+       activeCPUs != Row_layoutActiveCPUs ||
+       Row_pidDigits != Row_layoutPidDigits ||
+       Row_uidDigits != Row_layoutUidDigits ||
+       memcmp(Row_fieldWidths, Row_layoutWidths, sizeof(Row_layoutWidths)) != 0) {
+      Row_layoutScreen = ss;
+      Row_layoutTreeView = ss->treeView;
+      Row_layoutFieldsHash = fieldsHash;
+      Row_layoutRealtimeMs = realtimeMs;
+      Row_layoutActiveCPUs = activeCPUs;
+      Row_layoutPidDigits = Row_pidDigits;
+      Row_layoutUidDigits = Row_uidDigits;
+      memcpy(Row_layoutWidths, Row_fieldWidths, sizeof(Row_layoutWidths));
+      Row_layoutStamp++;
+   }
+
+   return Row_layoutStamp;
+}
+
 void Row_display(const Object* cast, RichString* out) {
    const Row* this = (const Row*) cast;
    const Settings* settings = this->host->settings;
    const RowField* fields = settings->ss->fields;
+   RowLineCache* cache = this->lineCache;
+   const uint32_t layoutStamp = Row_currentLayoutStamp(this->host);
+
+   if (cache->valid &&
+       cache->version == this->version &&
+       cache->layoutStamp == layoutStamp &&
+       cache->settingsStamp == settings->lastUpdate &&
+       cache->indent == this->indent &&
+       cache->showChildren == this->showChildren &&
+       cache->tag == this->tag) {
+      RichString_appendCells(out, cache->cells, cache->len);
+   } else {
+      int start = RichString_size(out);
+
+      for (int i = 0; fields[i]; i++)
+         As_Row(this)->writeField(this, out, fields[i]);
 
-   for (int i = 0; fields[i]; i++)
-      As_Row(this)->writeField(this, out, fields[i]);
+      if (Row_isHighlighted(this))
+         RichString_setAttr(out, CRT_colors[PROCESS_SHADOW]);
 
-   if (Row_isHighlighted(this))
-      RichString_setAttr(out, CRT_colors[PROCESS_SHADOW]);
+      if (this->tag == true)
+         RichString_setAttr(out, CRT_colors[PROCESS_TAG]);
 
-   if (this->tag == true)
-      RichString_setAttr(out, CRT_colors[PROCESS_TAG]);
+      int len = RichString_size(out) - start;
+      if (len > cache->capacity) {
+         cache->cells = xReallocArray(cache->cells, len, sizeof(CharType));
+         cache->capacity = len;
+      }
+      memcpy(cache->cells, out->chptr + start, len * sizeof(CharType));
+      cache->len = len;
+      cache->version = this->version;
+      cache->layoutStamp = layoutStamp;
+      cache->settingsStamp = settings->lastUpdate;
+      cache->indent = this->indent;
+      cache->showChildren = this->showChildren;
+      cache->tag = this->tag;
+      cache->valid = true;
+   }
 
    if (settings->highlightChanges) {
       if (Row_isTomb(this))
@@ -493,6 +607,36 @@ void Row_printRate(RichString* str, double rate, bool coloring) {
    }
 }
 
+void Row_writeTreeBranches(const Row* this, RichString* str) {
+   if (this->indent == 0)
+      return;
+
+   char buffer[256];
+   char* buf = buffer;
+   size_t n = sizeof(buffer);
+   const bool lastItem = (this->indent < 0);
+
+   for (uint32_t indent = (this->indent < 0 ? -this->indent : this->indent); indent > 1; indent >>= 1) {
+      int written, ret;
+      if (indent & 1U) {
+         ret = xSnprintf(buf, n, "%s  ", CRT_treeStr[TREE_STR_VERT]);
+      } else {
+         ret = xSnprintf(buf, n, "   ");
+      }
+      if (ret < 0 || (size_t)ret >= n) {
+         written = n;
+      } else {
+         written = ret;
+      }
+      buf += written;
+      n -= written;
+   }
+
+   const char* draw = CRT_treeStr[lastItem ? TREE_STR_BEND : TREE_STR_RTEE];
+   xSnprintf(buf, n, "%s%s ", draw, this->showChildren ? CRT_treeStr[TREE_STR_SHUT] : CRT_treeStr[TREE_STR_OPEN] );
+   RichString_appendWide(str, CRT_colors[PROCESS_TREE], buffer);
+}
+
 void Row_printLeftAlignedField(RichString* str, int attr, const char* content, unsigned int width) {
    int columns = width;
    RichString_appendnWideColumns(str, attr, content, strlen(content), &columns);
@@ -530,6 +674,27 @@ void Row_toggleTag(Row* this) {
    this->tag = !this->tag;
 }
 
+uint64_t Row_keyFromReal(double value) {
+   if (isNaN(value))
+      return 0;
+
+   /* Adding zero turns -0.0 into 0.0, which compare equal */
+   value += 0.0;
+
+   uint64_t bits;
+   memcpy(&bits, &value, sizeof(bits));
+   return (bits & (UINT64_C(1) << 63)) ? ~bits : bits | (UINT64_C(1) << 63);
+}
+
+bool Row_valueReal(RowValue* value, double x) {
+   if (!isfinite(x))
+      return Row_valueNone(value);
+
+   value->kind = ROW_VALUE_REAL;
+   value->d = x;
+   return true;
+}
+
 int Row_compare(const void* v1, const void* v2) {
    const Row* r1 = (const Row*)v1;
    const Row* r2 = (const Row*)v2;
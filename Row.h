@@ -27,6 +27,7 @@ extern int Row_pidDigits;
 extern int Row_uidDigits;
 
 struct Machine_;     // IWYU pragma: keep
+struct RowLineCache_; // IWYU pragma: keep
 struct Settings_;    // IWYU pragma: keep
 struct Table_;       // IWYU pragma: keep
 
@@ -63,12 +64,32 @@ typedef struct Row_ {
    /* Whether the row was updated during the last scan */
    bool updated;
 
+   /* Whether the row was in the visible part of the panel at its last rebuild */
+   bool inViewport;
+
+   /* Changes whenever a value shown by the row changes, see Row_markDirty() */
+   uint32_t version;
+
+   /* Line last rendered by Row_display(), reused until it would render differently */
+   struct RowLineCache_* lineCache;
+
    /*
     * Internal state for tree-mode.
     */
    int32_t indent;
    unsigned int tree_depth;
 
+   /*
+    * Links of the tree index kept by the table, see Table_syncTree().
+    * Siblings form a doubly linked list below their parent or, for
+    * roots, below the table.
+    */
+   struct Row_* treeParent;
+   struct Row_* treeFirstChild;
+   struct Row_* treeNext;
+   struct Row_* treePrev;
+   int treeParentId;          /* Row_getGroupOrParent() when last linked */
+
    /*
     * Internal time counts for showing new and exited processes.
     */
@@ -83,6 +104,29 @@ typedef bool (*Row_IsVisible)(const Row*, const struct Table_*);
 typedef bool (*Row_MatchesFilter)(const Row*, const struct Table_*);
 typedef const char* (*Row_SortKeyString)(Row*);
 typedef int (*Row_CompareByParent)(const Row*, const Row*);
+typedef bool (*Row_NumericKey)(const Row*, RowField, uint64_t*);
+
+/*
+ * A numeric field as machine readable output shows it, whatever its display.
+ * Sizes are in KiB, times in hundredths of a second, counters and rates in
+ * their own units and percentages as such. ROW_VALUE_NONE stands for a value
+ * not known, shown as N/A.
+ */
+typedef enum RowValueKind_ {
+   ROW_VALUE_NONE,
+   ROW_VALUE_SIGNED,
+   ROW_VALUE_UNSIGNED,
+   ROW_VALUE_REAL,
+} RowValueKind;
+
+typedef struct RowValue_ {
+   RowValueKind kind;
+   int64_t i;
+   uint64_t u;
+   double d;
+} RowValue;
+
+typedef bool (*Row_MachineValue)(const Row*, RowField, RowValue*);
 
 int Row_compare(const void* v1, const void* v2);
 
@@ -94,6 +138,8 @@ typedef struct RowClass_ {
    const Row_MatchesFilter matchesFilter;
    const Row_SortKeyString sortKeyString;
    const Row_CompareByParent compareByParent;
+   const Row_NumericKey numericKey;   /* order-preserving integer of a numeric field, false for other fields */
+   const Row_MachineValue machineValue;   /* value of a numeric field for --output, false for text fields */
 } RowClass;
 
 #define As_Row(this_)  ((const RowClass*)((this_)->super.klass))
@@ -103,6 +149,43 @@ typedef struct RowClass_ {
 #define Row_matchesFilter(r_, t_)  (As_Row(r_)->matchesFilter ? (As_Row(r_)->matchesFilter(r_, t_)) : false)
 #define Row_sortKeyString(r_)  (As_Row(r_)->sortKeyString ? (As_Row(r_)->sortKeyString(r_)) : "")
 #define Row_compareByParent(r1_, r2_)  (As_Row(r1_)->compareByParent ? (As_Row(r1_)->compareByParent(r1_, r2_)) : Row_compareByParent_Base(r1_, r2_))
+#define Row_numericKey(r_, f_, k_)  (As_Row(r_)->numericKey ? (As_Row(r_)->numericKey(r_, f_, k_)) : false)
+#define Row_machineValue(r_, f_, v_)  (As_Row(r_)->machineValue ? (As_Row(r_)->machineValue(r_, f_, v_)) : false)
+
+/* Setters of a RowValue, returning true to be returned by machineValue */
+static inline bool Row_valueSigned(RowValue* value, int64_t x) {
+   value->kind = ROW_VALUE_SIGNED;
+   value->i = x;
+   return true;
+}
+
+/* The largest value stands for an unknown one, like for Row_printCount */
+static inline bool Row_valueUnsigned(RowValue* value, uint64_t x) {
+   if (x == UINT64_MAX) {
+      value->kind = ROW_VALUE_NONE;
+      return true;
+   }
+
+   value->kind = ROW_VALUE_UNSIGNED;
+   value->u = x;
+   return true;
+}
+
+static inline bool Row_valueNone(RowValue* value) {
+   value->kind = ROW_VALUE_NONE;
+   return true;
+}
+
+/* NaN and infinities are not known values */
+bool Row_valueReal(RowValue* value, double x);
+
+/* Numeric keys ordering like SPACESHIP_NUMBER of the values */
+static inline uint64_t Row_keyFromSigned(int64_t value) {
+   return (uint64_t)value ^ (UINT64_C(1) << 63);
+}
+
+/* Numeric key ordering like compareRealNumbers, NaN first */
+uint64_t Row_keyFromReal(double value);
 
 #define ONE_K 1024UL
 #define ONE_M (ONE_K * ONE_K)
@@ -124,12 +207,26 @@ void Row_done(Row* this);
 
 void Row_display(const Object* cast, RichString* out);
 
+/* Frees the rendered line kept for the row, e.g. once it is no longer on screen */
+void Row_releaseLineCache(Row* this);
+
+/* Whether a rendered line is kept for the row, which would then need Row_markDirty() on changes */
+bool Row_hasLineCache(const Row* this);
+
+/* To be called by scanners when a value shown by the row changed */
+static inline void Row_markDirty(Row* this) {
+   this->version++;
+}
+
 void Row_toggleTag(Row* this);
 
 void Row_resetFieldWidths(void);
 
 void Row_updateFieldWidth(RowField key, size_t width);
 
+/* Appends the tree branches drawn left of a row name in tree view */
+void Row_writeTreeBranches(const Row* this, RichString* str);
+
 void Row_printLeftAlignedField(RichString* str, int attr, const char* content, unsigned int width);
 
 const char* RowField_alignedTitle(const struct Settings_* settings, RowField field);
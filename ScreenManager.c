@@ -11,12 +11,14 @@ in the source distribution for its full text.
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
 
 #include "CRT.h"
 #include "FunctionBar.h"
+#include "Instrument.h"
 #include "Machine.h"
 #include "Macros.h"
 #include "Object.h"
@@ -139,13 +141,19 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
          host->activeTable->needsSort = true;
          *sortTimeout = 1;
       }
+      Instrument_cycle();
+
       // sample current values for system metrics and processes if not paused
+      uint64_t start = Instrument_start();
       Machine_scan(host);
+      Instrument_stop(INSTRUMENT_MACHINE_SCAN, start);
       if (!this->state->pauseUpdate)
          Machine_scanTables(host);
 
       // always update header, especially to avoid gaps in graph meters
+      start = Instrument_start();
       Header_updateData(this->header);
+      Instrument_stop(INSTRUMENT_HEADER, start);
       // force redraw if the number of UID digits was changed
       if (Process_uidDigits != oldUidDigits) {
          *force_redraw = true;
@@ -154,8 +162,11 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
    }
    if (*redraw) {
       Table_rebuildPanel(host->activeTable);
-      if (!this->state->hideMeters)
+      if (!this->state->hideMeters) {
+         uint64_t start = Instrument_start();
          Header_draw(this->header);
+         Instrument_stop(INSTRUMENT_HEADER, start);
+      }
    }
    *rescan = false;
 }
@@ -206,6 +217,7 @@ static void ScreenManager_drawScreenTabs(ScreenManager* this) {
 
 static void ScreenManager_drawPanels(ScreenManager* this, int focus, bool force_redraw) {
    Settings* settings = this->host->settings;
+   CRT_frameCount++;
    if (settings->screenTabs) {
       ScreenManager_drawScreenTabs(this);
    }
@@ -248,7 +260,9 @@ void ScreenManager_run(ScreenManager* this, Panel** lastFocus, int* lastKey, con
       }
 
       if (redraw || force_redraw) {
+         uint64_t start = Instrument_start();
          ScreenManager_drawPanels(this, focus, force_redraw);
+         Instrument_stop(INSTRUMENT_DRAW, start);
          force_redraw = false;
          if (this->host->iterationsRemaining != -1) {
             if (!--this->host->iterationsRemaining) {
@@ -322,6 +336,10 @@ void ScreenManager_run(ScreenManager* this, Panel** lastFocus, int* lastKey, con
          continue;
       }
 
+      /* Keys may move or search past the rows sorted for the last redraw */
+      if (this->header)
+         Table_finishSort(this->host->activeTable);
+
       switch (ch) {
          case KEY_ALT('H'): ch = KEY_LEFT; break;
          case KEY_ALT('J'): ch = KEY_DOWN; break;
@@ -0,0 +1,72 @@
+/*
+htop - SelfMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "SelfMeter.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include "CRT.h"
+#include "Instrument.h"
+#include "Macros.h"
+#include "Object.h"
+#include "XUtils.h"
+
+
+static const int SelfMeter_attributes[] = {
+   METER_VALUE
+};
+
+static double SelfMeter_lastMs(InstrumentPhase phase) {
+   InstrumentStats stats;
+   return Instrument_stats(phase, &stats) ? stats.last / 1e6 : 0.0;
+}
+
+static void SelfMeter_updateValues(Meter* this) {
+   if (!Instrument_cycles()) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "(measuring)");
+      return;
+   }
+
+   double scan = SelfMeter_lastMs(INSTRUMENT_MACHINE_SCAN) + SelfMeter_lastMs(INSTRUMENT_TABLE_SCAN);
+   double draw = SelfMeter_lastMs(INSTRUMENT_HEADER) + SelfMeter_lastMs(INSTRUMENT_DRAW);
+   int len = xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "scan %.1f ms, sort %.1f ms, draw %.1f ms",
+                       scan, SelfMeter_lastMs(INSTRUMENT_SORT), draw);
+
+   InstrumentStats syscalls;
+   if (Instrument_syscallStats(&syscalls))
+      xSnprintf(this->txtBuffer + len, sizeof(this->txtBuffer) - (size_t)len, ", %" PRIu64 " syscalls", syscalls.last);
+}
+
+static void SelfMeter_init(Meter* this ATTR_UNUSED) {
+   Instrument_enable();
+}
+
+static void SelfMeter_done(Meter* this ATTR_UNUSED) {
+   Instrument_disable();
+}
+
+const MeterClass SelfMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .init = SelfMeter_init,
+   .done = SelfMeter_done,
+   .updateValues = SelfMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 0,
+   .total = 0.0,
+   .attributes = SelfMeter_attributes,
+   .name = "Self",
+   .uiName = "htop self",
+   .description = "Time htop spent scanning, sorting and drawing in the last refresh",
+   .caption = "htop: ",
+};
@@ -0,0 +1,15 @@
+#ifndef HEADER_SelfMeter
+#define HEADER_SelfMeter
+/*
+htop - SelfMeter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+extern const MeterClass SelfMeter_class;
+
+#endif
@@ -477,6 +477,10 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
       #endif
       } else if (String_eq(option[0], "update_process_names")) {
          this->updateProcessNames = atoi(option[1]);
+      } else if (String_eq(option[0], "lazy_process_fields")) {
+         this->lazyProcessFields = atoi(option[1]);
+      } else if (String_eq(option[0], "tiered_process_sampling")) {
+         this->tieredProcessSampling = atoi(option[1]);
       } else if (String_eq(option[0], "account_guest_in_cpu_meter")) {
          this->accountGuestInCPUMeter = atoi(option[1]);
       } else if (String_eq(option[0], "delay")) {
@@ -520,6 +524,14 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
       } else if (String_eq(option[0], "topology_affinity")) {
          this->topologyAffinity = !!atoi(option[1]);
       #endif
+      #ifdef HAVE_SCAN_THREADS
+      } else if (String_eq(option[0], "scan_threads")) {
+         this->scanThreads = CLAMP(atoi(option[1]), 1, MAX_SCAN_THREADS);
+      #endif
+      #ifdef HAVE_PROC_CONNECTOR
+      } else if (String_eq(option[0], "track_process_events")) {
+         this->trackProcessEvents = !!atoi(option[1]);
+      #endif
       } else if (strncmp(option[0], "screen:", 7) == 0) {
          screen = Settings_newScreen(this, &(const ScreenDefaults) { .name = option[0] + 7, .columns = option[1] });
       } else if (String_eq(option[0], ".sort_key")) {
@@ -706,6 +718,8 @@ int Settings_write(const Settings* this, bool onCrash) {
    #endif
    printSettingInteger("show_cached_memory", this->showCachedMemory);
    printSettingInteger("update_process_names", this->updateProcessNames);
+   printSettingInteger("lazy_process_fields", this->lazyProcessFields);
+   printSettingInteger("tiered_process_sampling", this->tieredProcessSampling);
    printSettingInteger("account_guest_in_cpu_meter", this->accountGuestInCPUMeter);
    printSettingInteger("color_scheme", this->colorScheme);
    #ifdef HAVE_GETMOUSE
@@ -716,6 +730,12 @@ int Settings_write(const Settings* this, bool onCrash) {
    #ifdef HAVE_LIBHWLOC
    printSettingInteger("topology_affinity", this->topologyAffinity);
    #endif
+   #ifdef HAVE_SCAN_THREADS
+   printSettingInteger("scan_threads", this->scanThreads);
+   #endif
+   #ifdef HAVE_PROC_CONNECTOR
+   printSettingInteger("track_process_events", this->trackProcessEvents);
+   #endif
 
    printSettingString("header_layout", HeaderLayout_getName(this->hLayout));
    for (unsigned int i = 0; i < HeaderLayout_getColumns(this->hLayout); i++) {
@@ -811,6 +831,8 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
    #endif
    this->showCachedMemory = true;
    this->updateProcessNames = false;
+   this->lazyProcessFields = true;
+   this->tieredProcessSampling = false;
    this->showProgramPath = true;
    this->highlightThreads = true;
    this->highlightChanges = false;
@@ -823,6 +845,12 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
    #ifdef HAVE_LIBHWLOC
    this->topologyAffinity = false;
    #endif
+   #ifdef HAVE_SCAN_THREADS
+   this->scanThreads = 1;
+   #endif
+   #ifdef HAVE_PROC_CONNECTOR
+   this->trackProcessEvents = false;
+   #endif
 
    this->screens = xCalloc(Platform_numberOfDefaultScreens, sizeof(ScreenSettings*));
    this->nScreens = 0;
@@ -905,13 +933,15 @@ void ScreenSettings_invertSortOrder(ScreenSettings* this) {
 }
 
 void ScreenSettings_setSortKey(ScreenSettings* this, ProcessField sortKey) {
+   /* dynamic columns mostly hold amounts, sort those largest first */
+   bool sortDesc = sortKey >= LAST_PROCESSFIELD || Process_fields[sortKey].defaultSortDesc;
    if (this->treeViewAlwaysByPID || !this->treeView) {
       this->sortKey = sortKey;
-      this->direction = (Process_fields[sortKey].defaultSortDesc) ? -1 : 1;
+      this->direction = sortDesc ? -1 : 1;
       this->treeView = false;
    } else {
       this->treeSortKey = sortKey;
-      this->treeDirection = (Process_fields[sortKey].defaultSortDesc) ? -1 : 1;
+      this->treeDirection = sortDesc ? -1 : 1;
    }
 }
 
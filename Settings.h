@@ -22,6 +22,8 @@ in the source distribution for its full text.
 
 #define CONFIG_READER_MIN_VERSION 3
 
+#define MAX_SCAN_THREADS 64
+
 struct DynamicScreen_;  // IWYU pragma: keep
 struct Machine_;        // IWYU pragma: keep
 struct Table_;          // IWYU pragma: keep
@@ -98,6 +100,8 @@ typedef struct Settings_ {
    bool stripExeFromCmdline;
    bool showMergedCommand;
    bool updateProcessNames;
+   bool lazyProcessFields;
+   bool tieredProcessSampling;
    bool accountGuestInCPUMeter;
    bool headerMargin;
    bool screenTabs;
@@ -109,6 +113,12 @@ typedef struct Settings_ {
    #ifdef HAVE_LIBHWLOC
    bool topologyAffinity;
    #endif
+   #ifdef HAVE_SCAN_THREADS
+   int scanThreads;
+   #endif
+   #ifdef HAVE_PROC_CONNECTOR
+   bool trackProcessEvents;
+   #endif
 
    bool changed;
    uint64_t lastUpdate;
@@ -0,0 +1,172 @@
+/*
+htop - Slab.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Slab.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+#ifdef __SANITIZE_ADDRESS__
+#include <sanitizer/asan_interface.h>
+#endif
+
+
+/* Alignment of the objects, enough for any member type they may contain */
+#define SLAB_ALIGNMENT 16
+
+/* Objects are preceded by the link to their chunk, padded to the alignment */
+#define SLAB_SLOT_HEADER SLAB_ALIGNMENT
+
+struct SlabChunk_ {
+   SlabChunk* prev;
+   SlabChunk* next;
+   void* freeList;
+   size_t inUse;
+};
+
+/* The chunk header, padded to the alignment, is followed by the slots */
+#define SLAB_CHUNK_HEADER ((sizeof(SlabChunk) + SLAB_ALIGNMENT - 1) & ~(size_t)(SLAB_ALIGNMENT - 1))
+
+static inline size_t Slab_stride(const Slab* this) {
+   size_t size = this->objectSize < sizeof(void*) ? sizeof(void*) : this->objectSize;
+   return (size + SLAB_ALIGNMENT - 1) & ~(size_t)(SLAB_ALIGNMENT - 1);
+}
+
+/* Free objects hold the link to the next free one in their first bytes; the
+   rest of them is off limits for the address sanitizer until handed out */
+static inline void Slab_poison(const Slab* this, char* object) {
+#ifdef __SANITIZE_ADDRESS__
+   ASAN_POISON_MEMORY_REGION(object + sizeof(void*), Slab_stride(this) - sizeof(void*));
+#else
+   (void)this;
+   (void)object;
+#endif
+}
+
+static inline void Slab_unpoison(const Slab* this, char* object) {
+#ifdef __SANITIZE_ADDRESS__
+   ASAN_UNPOISON_MEMORY_REGION(object, Slab_stride(this));
+#else
+   (void)this;
+   (void)object;
+#endif
+}
+
+static inline SlabChunk* Slab_chunkOf(const void* object) {
+   SlabChunk* chunk;
+   memcpy(&chunk, (const char*)object - SLAB_SLOT_HEADER, sizeof(chunk));
+   return chunk;
+}
+
+static void Slab_push(Slab* this, SlabChunk* chunk, char* object) {
+   memcpy(object, &chunk->freeList, sizeof(chunk->freeList));
+   chunk->freeList = object;
+   Slab_poison(this, object);
+   this->stats.available++;
+}
+
+static void Slab_link(Slab* this, SlabChunk* chunk) {
+   chunk->prev = NULL;
+   chunk->next = this->partial;
+   if (this->partial)
+      this->partial->prev = chunk;
+   this->partial = chunk;
+}
+
+static void Slab_unlink(Slab* this, SlabChunk* chunk) {
+   if (chunk->prev)
+      chunk->prev->next = chunk->next;
+   else
+      this->partial = chunk->next;
+   if (chunk->next)
+      chunk->next->prev = chunk->prev;
+   chunk->prev = chunk->next = NULL;
+}
+
+static SlabChunk* Slab_grow(Slab* this) {
+   assert(this->perChunk > 0);
+
+   size_t slot = SLAB_SLOT_HEADER + Slab_stride(this);
+   SlabChunk* chunk = xMalloc(SLAB_CHUNK_HEADER + this->perChunk * slot);
+   *chunk = (SlabChunk) { .freeList = NULL };
+   this->stats.chunks++;
+
+   /* Push in reverse, so the objects are handed out in address order */
+   char* slots = (char*)chunk + SLAB_CHUNK_HEADER;
+   for (size_t i = this->perChunk; i > 0; i--) {
+      char* header = slots + (i - 1) * slot;
+      memcpy(header, &chunk, sizeof(chunk));
+      Slab_push(this, chunk, header + SLAB_SLOT_HEADER);
+   }
+
+   return chunk;
+}
+
+static void Slab_release(Slab* this, SlabChunk* chunk) {
+   assert(chunk->inUse == 0);
+
+   free(chunk);
+   this->stats.chunks--;
+   this->stats.available -= this->perChunk;
+}
+
+void* Slab_alloc(Slab* this) {
+   SlabChunk* chunk = this->partial;
+   if (!chunk) {
+      if (this->spare) {
+         chunk = this->spare;
+         this->spare = NULL;
+      } else {
+         chunk = Slab_grow(this);
+      }
+      Slab_link(this, chunk);
+   }
+
+   char* object = chunk->freeList;
+   Slab_unpoison(this, object);
+   memcpy(&chunk->freeList, object, sizeof(chunk->freeList));
+   memset(object, 0, this->objectSize);
+   chunk->inUse++;
+
+   /* Full chunks leave the list until one of their objects is freed */
+   if (!chunk->freeList)
+      Slab_unlink(this, chunk);
+
+   this->stats.available--;
+   this->stats.inUse++;
+   this->stats.allocations++;
+   return object;
+}
+
+void Slab_free(Slab* this, void* object) {
+   if (!object)
+      return;
+
+   SlabChunk* chunk = Slab_chunkOf(object);
+   assert(chunk->inUse > 0);
+
+   if (!chunk->freeList)
+      Slab_link(this, chunk);
+
+   Slab_push(this, chunk, object);
+   chunk->inUse--;
+   this->stats.inUse--;
+
+   if (chunk->inUse > 0)
+      return;
+
+   Slab_unlink(this, chunk);
+   if (this->spare)
+      Slab_release(this, chunk);
+   else
+      this->spare = chunk;
+}
@@ -0,0 +1,52 @@
+#ifndef HEADER_Slab
+#define HEADER_Slab
+/*
+htop - Slab.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * Allocator for objects of one fixed size, carved out of chunks holding
+ * many of them. Freed objects go on the free list of their chunk and are
+ * handed out again before a new chunk is allocated, so rows of processes
+ * coming and going reuse the same memory instead of fragmenting the heap.
+ * A chunk goes back to the system once none of its objects is in use, but
+ * for one kept as a spare so a few rows coming and going do not allocate
+ * and free a chunk each refresh.
+ */
+
+typedef struct SlabStats_ {
+   size_t chunks;             /* chunks currently allocated, the spare included */
+   size_t inUse;              /* objects handed out and not freed yet */
+   size_t available;          /* objects free in the allocated chunks */
+   uint64_t allocations;      /* objects handed out since the start */
+} SlabStats;
+
+typedef struct SlabChunk_ SlabChunk;
+
+typedef struct Slab_ {
+   size_t objectSize;
+   size_t perChunk;
+   SlabChunk* partial;        /* chunks with objects both free and in use */
+   SlabChunk* spare;          /* a chunk with no object in use, or NULL */
+   SlabStats stats;
+} Slab;
+
+#define SLAB_INITIALIZER(type_, perChunk_) { .objectSize = sizeof(type_), .perChunk = (perChunk_) }
+
+/* Returns a zeroed object; never fails */
+void* Slab_alloc(Slab* this);
+
+void Slab_free(Slab* this, void* object);
+
+static inline const SlabStats* Slab_stats(const Slab* this) {
+   return &this->stats;
+}
+
+#endif /* HEADER_Slab */
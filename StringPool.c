@@ -0,0 +1,157 @@
+/*
+htop - StringPool.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "StringPool.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+
+/*
+ * Chained hash table with a power-of-two number of buckets; the strings are
+ * stored inline after their entry, which is found again from the string by
+ * subtracting the offset of the text within the entry.
+ */
+typedef struct StringPoolEntry_ {
+   struct StringPoolEntry_* next;
+   uint32_t hash;
+   uint32_t refs;
+   size_t len;
+   char str[];
+} StringPoolEntry;
+
+typedef struct StringPool_ {
+   StringPoolEntry** buckets;
+   size_t size;
+   size_t strings;
+   size_t bytes;
+} StringPool;
+
+#define STRINGPOOL_MIN_SIZE 256
+
+static StringPool StringPool_pool;
+
+/* FNV-1a, also measuring the string */
+static uint32_t StringPool_hash(const char* str, size_t* len) {
+   uint32_t hash = 2166136261U;
+   const char* c = str;
+   for (; *c; c++) {
+      hash ^= (unsigned char)*c;
+      hash *= 16777619U;
+   }
+   *len = (size_t)(c - str);
+   return hash;
+}
+
+static inline StringPoolEntry* StringPool_entry(const char* str) {
+   return (StringPoolEntry*)(void*)((uintptr_t)str - offsetof(StringPoolEntry, str));
+}
+
+static void StringPool_resize(StringPool* this, size_t size) {
+   StringPoolEntry** buckets = xCalloc(size, sizeof(*buckets));
+
+   for (size_t i = 0; i < this->size; i++) {
+      StringPoolEntry* entry = this->buckets[i];
+      while (entry) {
+         StringPoolEntry* next = entry->next;
+         StringPoolEntry** bucket = &buckets[entry->hash & (size - 1)];
+         entry->next = *bucket;
+         *bucket = entry;
+         entry = next;
+      }
+   }
+
+   free(this->buckets);
+   this->buckets = buckets;
+   this->size = size;
+}
+
+const char* StringPool_intern(const char* str) {
+   if (!str)
+      return NULL;
+
+   StringPool* this = &StringPool_pool;
+   size_t len;
+   uint32_t hash = StringPool_hash(str, &len);
+
+   if (this->size) {
+      for (StringPoolEntry* entry = this->buckets[hash & (this->size - 1)]; entry; entry = entry->next) {
+         if (entry->hash == hash && entry->len == len && memcmp(entry->str, str, len) == 0) {
+            assert(entry->refs < UINT32_MAX);
+            entry->refs++;
+            return entry->str;
+         }
+      }
+   }
+
+   if (this->strings >= this->size)
+      StringPool_resize(this, this->size ? this->size * 2 : STRINGPOOL_MIN_SIZE);
+
+   StringPoolEntry* entry = xMalloc(sizeof(StringPoolEntry) + len + 1);
+   entry->hash = hash;
+   entry->refs = 1;
+   entry->len = len;
+   memcpy(entry->str, str, len + 1);
+
+   StringPoolEntry** bucket = &this->buckets[hash & (this->size - 1)];
+   entry->next = *bucket;
+   *bucket = entry;
+
+   this->strings++;
+   this->bytes += len + 1;
+   return entry->str;
+}
+
+void StringPool_release(const char* str) {
+   if (!str)
+      return;
+
+   StringPool* this = &StringPool_pool;
+   StringPoolEntry* entry = StringPool_entry(str);
+   assert(entry->refs > 0);
+   if (--entry->refs > 0)
+      return;
+
+   StringPoolEntry** link = &this->buckets[entry->hash & (this->size - 1)];
+   while (*link != entry) {
+      assert(*link);
+      link = &(*link)->next;
+   }
+   *link = entry->next;
+
+   this->strings--;
+   this->bytes -= entry->len + 1;
+   free(entry);
+
+   /* Give the table back once the last string is gone, e.g. on exit */
+   if (this->strings == 0) {
+      free(this->buckets);
+      this->buckets = NULL;
+      this->size = 0;
+   }
+}
+
+bool StringPool_replace(const char** slot, const char* str) {
+   const char* old = *slot;
+   if (old == str || (old && str && String_eq(old, str)))
+      return false;
+
+   *slot = StringPool_intern(str);
+   StringPool_release(old);
+   return true;
+}
+
+void StringPool_stats(size_t* strings, size_t* bytes) {
+   *strings = StringPool_pool.strings;
+   *bytes = StringPool_pool.bytes;
+}
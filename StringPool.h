@@ -0,0 +1,41 @@
+#ifndef HEADER_StringPool
+#define HEADER_StringPool
+/*
+htop - StringPool.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Macros.h"
+
+
+/*
+ * Reference counted strings shared by all rows: interning equal contents
+ * yields the same pointer, so the command lines, paths and cgroups common
+ * to many processes and threads are stored once. Strings obtained from the
+ * pool must only be given back with StringPool_release, never freed.
+ */
+
+/* Returns the shared copy of str with a new reference, NULL for NULL */
+const char* StringPool_intern(const char* str);
+
+/* Drops a reference to a string returned by StringPool_intern; NULL is ignored */
+void StringPool_release(const char* str);
+
+/* Make *slot refer to the shared copy of str, releasing its previous string;
+   returns false if the contents did not change */
+bool StringPool_replace(const char** slot, const char* str);
+
+/* Number of distinct strings and the bytes they take */
+void StringPool_stats(size_t* strings, size_t* bytes);
+
+/* Orders like SPACESHIP_NULLSTR, answering equal pool strings without comparing them */
+static inline int StringPool_compare(const char* a, const char* b) {
+   return a == b ? 0 : SPACESHIP_NULLSTR(a, b);
+}
+
+#endif /* HEADER_StringPool */
@@ -11,16 +11,19 @@ in the source distribution for its full text.
 #include "Table.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 #include "CRT.h"
 #include "Hashtable.h"
+#include "Instrument.h"
 #include "Machine.h"
 #include "Macros.h"
 #include "Panel.h"
 #include "RowField.h"
 #include "Vector.h"
+#include "XUtils.h"
 
 
 Table* Table_init(Table* this, const ObjectClass* klass, Machine* host) {
@@ -28,12 +31,18 @@ Table* Table_init(Table* this, const ObjectClass* klass, Machine* host) {
    this->displayList = Vector_new(klass, false, DEFAULT_SIZE);
    this->table = Hashtable_new(200, false);
    this->needsSort = true;
+   this->tracksChanges = false;
    this->following = -1;
+   this->viewportKnown = false;
+   this->sortKeys = NULL;
+   this->sortKeysCapacity = 0;
+   this->sortedRows = 0;
    this->host = host;
    return this;
 }
 
 void Table_done(Table* this) {
+   free(this->sortKeys);
    Hashtable_delete(this->table);
    Vector_delete(this->displayList);
    Vector_delete(this->rows);
@@ -49,6 +58,40 @@ void Table_setPanel(Table* this, Panel* panel) {
    this->panel = panel;
 }
 
+void Table_setIncFilter(Table* this, const char* incFilter) {
+   this->incFilter = incFilter;
+   this->incFilterStamp++;
+}
+
+static void Table_linkRow(Table* this, Row* row, Row* parent) {
+   Row** first = parent ? &parent->treeFirstChild : &this->treeRoots;
+
+   row->treeParent = parent;
+   row->treePrev = NULL;
+   row->treeNext = *first;
+   if (*first)
+      (*first)->treePrev = row;
+   *first = row;
+
+   row->isRoot = !parent;
+}
+
+static void Table_unlinkRow(Table* this, Row* row) {
+   if (row->treePrev)
+      row->treePrev->treeNext = row->treeNext;
+   else if (row->treeParent)
+      row->treeParent->treeFirstChild = row->treeNext;
+   else
+      this->treeRoots = row->treeNext;
+
+   if (row->treeNext)
+      row->treeNext->treePrev = row->treePrev;
+
+   row->treeParent = NULL;
+   row->treePrev = NULL;
+   row->treeNext = NULL;
+}
+
 void Table_add(Table* this, Row* row) {
    assert(Vector_indexOf(this->rows, row, Row_idEqualCompare) == -1);
    assert(Hashtable_get(this->table, row->id) == NULL);
@@ -59,6 +102,10 @@ void Table_add(Table* this, Row* row) {
    Vector_add(this->rows, row);
    Hashtable_put(this->table, row->id, row);
 
+   // the parent is looked up on the next sync, it may not be known yet
+   Table_linkRow(this, row, NULL);
+   this->treeRowsAdded = true;
+
    assert(Vector_indexOf(this->rows, row, Row_idEqualCompare) != -1);
    assert(Hashtable_get(this->table, row->id) != NULL);
    assert(Vector_countEquals(this->rows, Hashtable_count(this->table)));
@@ -69,15 +116,28 @@ void Table_add(Table* this, Row* row) {
 // removing items.
 // Note: for processes should only be called from ProcessTable_iterate to avoid
 // breaking dying process highlighting.
-static void Table_removeIndex(Table* this, const Row* row, int idx) {
+static void Table_removeIndex(Table* this, Row* row, int idx) {
    int rowid = row->id;
 
    assert(row == (Row*)Vector_get(this->rows, idx));
    assert(Hashtable_get(this->table, rowid) != NULL);
 
    Hashtable_remove(this->table, rowid);
+
+   // children of the row become roots, unless reparented on the next sync
+   Row* child = row->treeFirstChild;
+   while (child) {
+      Row* next = child->treeNext;
+      Table_linkRow(this, child, NULL);
+      child = next;
+   }
+   Table_unlinkRow(this, row);
+
    Vector_softRemove(this->rows, idx);
 
+   if (idx < this->sortedRows)
+      this->sortedRows--;
+
    if (this->following != -1 && this->following == rowid) {
       this->following = -1;
       Panel_setSelectionColor(this->panel, PANEL_SELECTION_FOCUS);
@@ -87,48 +147,120 @@ static void Table_removeIndex(Table* this, const Row* row, int idx) {
    assert(Vector_countEquals(this->rows, Hashtable_count(this->table)));
 }
 
-static void Table_buildTreeBranch(Table* this, int rowid, unsigned int level, int32_t indent, bool show) {
-   // Do not treat zero as root of any tree.
-   // (e.g. on OpenBSD the kernel thread 'swapper' has pid 0.)
-   if (rowid == 0)
-      return;
-
-   // The vector is sorted by parent, find the start of the range by bisection
+/*
+ * Bring the tree index up to date with the parents rows report now. Only
+ * rows whose parent changed, roots after rows were added and rows whose
+ * parent went away get relinked, so this is a single pass over the rows.
+ */
+static void Table_syncTree(Table* this) {
    int vsize = Vector_size(this->rows);
-   int l = 0;
-   int r = vsize;
-   while (l < r) {
-      int c = (l + r) / 2;
-      Row* row = (Row*)Vector_get(this->rows, c);
-      int parent = row->isRoot ? 0 : Row_getGroupOrParent(row);
-      if (parent < rowid) {
-         l = c + 1;
+   for (int i = 0; i < vsize; i++) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+      int parentId = Row_getGroupOrParent(row);
+
+      if (parentId == row->treeParentId && (row->treeParent || !this->treeRowsAdded))
+         continue;
+
+      row->treeParentId = parentId;
+
+      // Do not treat zero as root of any tree.
+      // (e.g. on OpenBSD the kernel thread 'swapper' has pid 0.)
+      Row* parent = (parentId && parentId != row->id) ? Table_findRow(this, parentId) : NULL;
+
+      // Break cycles from reused identifiers, keeping every row reachable
+      for (const Row* ancestor = parent; ancestor; ancestor = ancestor->treeParent) {
+         if (ancestor == row) {
+            parent = NULL;
+            break;
+         }
+      }
+
+      if (parent != row->treeParent) {
+         Table_unlinkRow(this, row);
+         Table_linkRow(this, row, parent);
+      }
+   }
+
+   this->treeRowsAdded = false;
+}
+
+/* Merge sort of a sibling list, returning the new first; treePrev is left for the caller */
+static Row* Table_sortSiblingList(Row* list, int count) {
+   if (count < 2)
+      return list;
+
+   Row* second = list;
+   for (int i = 1; i < count / 2; i++)
+      second = second->treeNext;
+   Row* tail = second->treeNext;
+   second->treeNext = NULL;
+
+   Row* a = Table_sortSiblingList(list, count / 2);
+   Row* b = Table_sortSiblingList(tail, count - count / 2);
+
+   Row* first = NULL;
+   Row** link = &first;
+   while (a && b) {
+      if (Row_compareByParent(a, b) <= 0) {
+         *link = a;
+         a = a->treeNext;
       } else {
-         r = c;
+         *link = b;
+         b = b->treeNext;
       }
+      link = &(*link)->treeNext;
    }
-   // Find the end to know the last line for indent handling purposes
-   int lastShown = r;
-   while (r < vsize) {
-      Row* row = (Row*)Vector_get(this->rows, r);
-      if (!Row_isChildOf(row, rowid))
-         break;
-      if (row->show)
-         lastShown = r;
-      r++;
+   *link = a ? a : b;
+
+   return first;
+}
+
+/* Order the siblings starting at *first, in place unless they already are */
+static void Table_sortSiblings(Row** first) {
+   int count = 0;
+   bool sorted = true;
+
+   for (const Row* walk = *first; walk; walk = walk->treeNext) {
+      if (walk->treeNext && sorted && Row_compareByParent(walk, walk->treeNext) > 0)
+         sorted = false;
+      count++;
    }
 
-   for (int i = l; i < r; i++) {
-      Row* row = (Row*)Vector_get(this->rows, i);
+   if (sorted)
+      return;
+
+   *first = Table_sortSiblingList(*first, count);
 
+   Row* prev = NULL;
+   for (Row* walk = *first; walk; walk = walk->treeNext) {
+      walk->treePrev = prev;
+      prev = walk;
+   }
+}
+
+static void Table_buildTreeBranch(Table* this, Row* parent, unsigned int level, int32_t indent, bool show) {
+   Table_sortSiblings(&parent->treeFirstChild);
+
+   // Find the last shown child to know the last line for indent handling purposes
+   const Row* lastShown = parent->treeFirstChild;
+   for (const Row* row = parent->treeFirstChild; row; row = row->treeNext) {
+      if (row->show)
+         lastShown = row;
+   }
+
+   bool beforeLastShown = true;
+   for (Row* row = parent->treeFirstChild; row; row = row->treeNext) {
       if (!show)
          row->show = false;
 
       Vector_add(this->displayList, row);
 
+      if (row == lastShown)
+         beforeLastShown = false;
+
       int32_t nextIndent = indent | ((int32_t)1 << MINIMUM(level, sizeof(row->indent) * 8 - 2));
-      Table_buildTreeBranch(this, row->id, level + 1, (i < lastShown) ? nextIndent : indent, row->show && row->showChildren);
-      if (i == lastShown)
+      Table_buildTreeBranch(this, row, level + 1, beforeLastShown ? nextIndent : indent, row->show && row->showChildren);
+      if (row == lastShown)
          row->indent = -nextIndent;
       else
          row->indent = nextIndent;
@@ -137,75 +269,134 @@ static void Table_buildTreeBranch(Table* this, int rowid, unsigned int level, in
    }
 }
 
-static int compareRowByKnownParentThenNatural(const void* v1, const void* v2) {
-   return Row_compareByParent((const Row*) v1, (const Row*) v2);
-}
-
-// Builds a sorted tree from scratch, without relying on previously gathered information
+// Flattens the tree index into the display list; siblings are only resorted where their order changed
 static void Table_buildTree(Table* this) {
    Vector_prune(this->displayList);
 
-   // Mark root processes
-   int vsize = Vector_size(this->rows);
-   for (int i = 0; i < vsize; i++) {
-      Row* row = (Row*) Vector_get(this->rows, i);
-      int parent = Row_getGroupOrParent(row);
-      row->isRoot = false;
+   Table_syncTree(this);
 
-      if (row->id == parent) {
-         row->isRoot = true;
-         continue;
-      }
+   Table_sortSiblings(&this->treeRoots);
 
-      if (!parent) {
-         row->isRoot = true;
-         continue;
-      }
+   for (Row* row = this->treeRoots; row; row = row->treeNext) {
+      row->indent = 0;
+      row->tree_depth = 0;
+      Vector_add(this->displayList, row);
+      Table_buildTreeBranch(this, row, 0, 0, row->showChildren);
+   }
 
-      // We don't know about its parent for whatever reason
-      if (Table_findRow(this, parent) == NULL)
-         row->isRoot = true;
+   this->needsSort = false;
+
+   // Check consistency of the built structures
+   assert(Vector_size(this->displayList) == Vector_size(this->rows));
+}
+
+#ifndef NDEBUG
+static bool Table_rowsAreSorted(const Table* this, int count) {
+   Object_Compare compare = this->rows->type->compare;
+   for (int i = 1; i < count; i++) {
+      if (compare(Vector_get(this->rows, i - 1), Vector_get(this->rows, i)) > 0)
+         return false;
+   }
+   for (int i = count; i < Vector_size(this->rows); i++) {
+      if (count > 0 && compare(Vector_get(this->rows, count - 1), Vector_get(this->rows, i)) > 0)
+         return false;
    }
+   return true;
+}
+#endif
 
-   // Sort by known parent (roots first), then row ID
-   Vector_quickSortCustomCompare(this->rows, compareRowByKnownParentThenNatural);
+/*
+ * Sort the rows from start on by integer keys extracted once per row,
+ * instead of chasing the row pointers in every comparison, leaving only
+ * the first limit of them in order. Ties order by row id ascending in
+ * either direction, like Process_compare. Returns false without changing
+ * anything if some row has no numeric key for the sort field.
+ */
+static bool Table_sortByNumericKey(Table* this, int start, int limit) {
+   const ScreenSettings* ss = this->host->settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   bool descending = ScreenSettings_getActiveDirection(ss) != 1;
 
-   // Find all processes whose parent is not visible
-   for (int i = 0; i < vsize; i++) {
-      Row* row = (Row*)Vector_get(this->rows, i);
-
-      // If parent not found, then construct the tree with this node as root
-      if (row->isRoot) {
-         row = (Row*)Vector_get(this->rows, i);
-         row->indent = 0;
-         row->tree_depth = 0;
-         Vector_add(this->displayList, row);
-         Table_buildTreeBranch(this, row->id, 0, 0, row->showChildren);
-         continue;
-      }
+   int size = Vector_size(this->rows);
+   if (size > this->sortKeysCapacity) {
+      this->sortKeysCapacity = MAXIMUM(size, this->sortKeysCapacity + this->sortKeysCapacity / 2);
+      this->sortKeys = xReallocArray(this->sortKeys, (size_t)this->sortKeysCapacity, sizeof(*this->sortKeys));
    }
 
-   this->needsSort = false;
+   for (int i = start; i < size; i++) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+      uint64_t value;
+      if (!Row_numericKey(row, key, &value))
+         return false;
+
+      this->sortKeys[i - start] = (VectorSortKey) {
+         .key = descending ? ~value : value,
+         .tie = row->id,
+         .object = (Object*) row,
+      };
+   }
 
-   // Check consistency of the built structures
-   assert(Vector_size(this->displayList) == vsize); (void)vsize;
+   Vector_sortByKeys(this->rows, start, this->sortKeys, limit);
+   this->sortedRows = start + MINIMUM(limit, size - start);
+   assert(Table_rowsAreSorted(this, this->sortedRows));
+   return true;
 }
 
-void Table_updateDisplayList(Table* this) {
+static void Table_fillDisplayList(Table* this) {
+   Vector_prune(this->displayList);
+   int size = Vector_size(this->rows);
+   for (int i = 0; i < size; i++)
+      Vector_add(this->displayList, Vector_get(this->rows, i));
+}
+
+/*
+ * The panel only needs the rows up to the window in order; with a numeric
+ * sort key the rest is left unsorted, in O(n + window log window) rather
+ * than O(n log n), until Table_finishSort.
+ */
+static void Table_updateDisplayWindow(Table* this, int window) {
    const Settings* settings = this->host->settings;
 
+   uint64_t start = Instrument_start();
+
    if (settings->ss->treeView) {
       if (this->needsSort)
          Table_buildTree(this);
+      this->sortedRows = Vector_size(this->rows);
    } else {
-      if (this->needsSort)
+      if (this->needsSort && !Table_sortByNumericKey(this, 0, window)) {
          Vector_insertionSort(this->rows);
-      Vector_prune(this->displayList);
-      int size = Vector_size(this->rows);
-      for (int i = 0; i < size; i++)
-         Vector_add(this->displayList, Vector_get(this->rows, i));
+         this->sortedRows = Vector_size(this->rows);
+      }
+      Table_fillDisplayList(this);
    }
    this->needsSort = false;
+
+   Instrument_stop(INSTRUMENT_SORT, start);
+}
+
+void Table_updateDisplayList(Table* this) {
+   Table_updateDisplayWindow(this, INT_MAX);
+}
+
+/* Sort limit more of the unsorted rows and refill the panel with them */
+static void Table_extendSort(Table* this, int limit) {
+   uint64_t start = Instrument_start();
+   if (!Table_sortByNumericKey(this, this->sortedRows, limit)) {
+      Vector_insertionSort(this->rows);
+      this->sortedRows = Vector_size(this->rows);
+   }
+   Table_fillDisplayList(this);
+   Instrument_stop(INSTRUMENT_SORT, start);
+
+   Table_rebuildPanel(this);
+}
+
+void Table_finishSort(Table* this) {
+   if (this->needsSort || this->sortedRows >= Vector_size(this->rows) || this->host->settings->ss->treeView)
+      return;
+
+   Table_extendSort(this, INT_MAX);
 }
 
 void Table_expandTree(Table* this) {
@@ -219,7 +410,7 @@ void Table_expandTree(Table* this) {
 // Called on collapse-all toggle and on startup, possibly in non-tree mode
 void Table_collapseAllBranches(Table* this) {
    Table_buildTree(this); // Update `tree_depth` fields of the rows
-   this->needsSort = true; // Table is sorted by parent now, force new sort
+   this->needsSort = true; // Rebuild the display list with the branches collapsed
    int size = Vector_size(this->rows);
    for (int i = 0; i < size; i++) {
       Row* row = (Row*) Vector_get(this->rows, i);
@@ -229,13 +420,43 @@ void Table_collapseAllBranches(Table* this) {
    }
 }
 
-void Table_rebuildPanel(Table* this) {
-   Table_updateDisplayList(this);
+/* Remember which rows the panel shows, letting the next scan skip costly data of the others */
+static void Table_updateViewport(Table* this) {
+   for (int i = 0; i < Vector_size(this->rows); i++) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+
+      /* Keep the rendered lines of rows shown recently, for scrolling back */
+      if (!row->inViewport)
+         Row_releaseLineCache(row);
+
+      row->inViewport = false;
+   }
+
+   Panel* panel = this->panel;
+   const int size = Panel_size(panel);
+   const int first = CLAMP(panel->scrollV, 0, MAXIMUM(size - panel->h, 0));
+   const int last = MINIMUM(first + panel->h, size);
+   for (int i = first; i < last; i++) {
+      Row* row = (Row*) Panel_get(panel, i);
+      row->inViewport = true;
+   }
+
+   Row* selected = (Row*) Panel_getSelected(panel);
+   if (selected)
+      selected->inViewport = true;
 
+   this->viewportKnown = true;
+}
+
+void Table_rebuildPanel(Table* this) {
    const int currPos = Panel_getSelectedIndex(this->panel);
    const int currScrollV = this->panel->scrollV;
    const int currSize = Panel_size(this->panel);
 
+   /* Sort a page past the visible rows, so a little scrolling stays within the window */
+   const int height = this->panel->h;
+   Table_updateDisplayWindow(this, MAXIMUM(currPos, currScrollV + height) + height);
+
    Panel_prune(this->panel);
 
    /* Follow main group row instead if following a row that is occluded (hidden) */
@@ -251,10 +472,14 @@ void Table_rebuildPanel(Table* this) {
    const int rowCount = Vector_size(this->displayList);
    bool foundFollowed = false;
    int idx = 0;
+   int sortedShown = 0;
 
    for (int i = 0; i < rowCount; i++) {
       Row* row = (Row*) Vector_get(this->displayList, i);
 
+      if (i == this->sortedRows)
+         sortedShown = idx;
+
       if ( !row->show || (Row_matchesFilter(row, this) == true) )
          continue;
 
@@ -284,6 +509,17 @@ void Table_rebuildPanel(Table* this) {
 
       this->panel->scrollV = currScrollV;
    }
+
+   if (this->sortedRows < rowCount) {
+      /* Rows hidden by filters or the selection may reach past the sorted window, double it */
+      const int lastNeeded = MAXIMUM(Panel_getSelectedIndex(this->panel), this->panel->scrollV + height - 1);
+      if (lastNeeded >= sortedShown) {
+         Table_extendSort(this, MAXIMUM(this->sortedRows, MAXIMUM(height, 1)));
+         return;
+      }
+   }
+
+   Table_updateViewport(this);
 }
 
 void Table_printHeader(const Settings* settings, RichString* header) {
@@ -333,6 +569,9 @@ void Table_cleanupRow(Table* table, Row* row, int idx) {
    Machine* host = table->host;
    const Settings* settings = host->settings;
 
+   if (row->updated && !table->tracksChanges)
+      Row_markDirty(row);
+
    if (row->tombStampMs > 0) {
       // remove tombed process
       if (host->monotonicMs >= row->tombStampMs) {
@@ -29,11 +29,21 @@ typedef struct Table_ {
    Vector* displayList;   /* row tree flattened in display order (borrowed);
                              updated in Table_updateDisplayList when rebuilding panel */
    Hashtable* table;      /* fast known row lookup by identifier */
+   struct Row_* treeRoots; /* first of the rows without a known parent */
+   bool treeRowsAdded;    /* rows were added since the tree index was last synced */
 
    struct Machine_* host;
    const char* incFilter;
+   unsigned int incFilterStamp; /* changed by Table_setIncFilter */
    bool needsSort;
+   bool tracksChanges;    /* the scanner marks changed rows dirty itself,
+                             otherwise every updated row is considered changed */
    int following;         /* -1 or row being visually tracked in the user interface */
+   bool viewportKnown;    /* the panel has been laid out, so Row.inViewport is set */
+
+   VectorSortKey* sortKeys; /* scratch space for sorting the rows by a numeric key */
+   int sortKeysCapacity;
+   int sortedRows;        /* leading rows in their final order; the others follow unsorted */
 
    struct Panel_* panel;
 } Table;
@@ -64,6 +74,9 @@ extern const TableClass Table_class;
 
 void Table_setPanel(Table* this, struct Panel_* panel);
 
+/* Filter the rows by incFilter, NULL for none; call again whenever its text changed */
+void Table_setIncFilter(Table* this, const char* incFilter);
+
 void Table_printHeader(const Settings* settings, RichString* header);
 
 void Table_add(Table* this, struct Row_* row);
@@ -76,6 +89,9 @@ void Table_collapseAllBranches(Table* this);
 
 void Table_rebuildPanel(Table* this);
 
+/* Sort the rows left out of the window sorted for the panel, before the user moves past it */
+void Table_finishSort(Table* this);
+
 static inline struct Row_* Table_findRow(Table* this, int id) {
    return (struct Row_*) Hashtable_get(this->table, id);
 }
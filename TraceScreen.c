@@ -12,13 +12,13 @@ in the source distribution for its full text.
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
-#include <sys/select.h>
 #include <sys/wait.h>
 
 #include "CRT.h"
@@ -137,20 +137,21 @@ static void TraceScreen_updateTrace(InfoScreen* super) {
 
    int fd_strace = fileno(this->strace);
 
-   fd_set fds;
-   FD_ZERO(&fds);
-   FD_SET(STDIN_FILENO, &fds);
+   /* poll(2) rather than select(2): descriptors cached for procfs may push fd_strace beyond FD_SETSIZE */
+   struct pollfd fds[2] = {
+      { .fd = STDIN_FILENO, .events = POLLIN },
+      { .fd = -1, .events = POLLIN },
+   };
    if (this->strace_alive) {
       assert(fd_strace != -1);
-      FD_SET(fd_strace, &fds);
+      fds[1].fd = fd_strace;
    }
 
-   struct timeval tv = { .tv_sec = 0, .tv_usec = 500 };
-   int ready = select(MAXIMUM(STDIN_FILENO, fd_strace) + 1, &fds, NULL, NULL, &tv);
+   int ready = poll(fds, 2, 1);
 
    char buffer[1025];
    size_t nread = 0;
-   if (ready > 0 && FD_ISSET(fd_strace, &fds))
+   if (ready > 0 && (fds[1].revents & (POLLIN | POLLHUP)))
       nread = fread(buffer, 1, sizeof(buffer) - 1, this->strace);
 
    if (nread && this->tracing) {
@@ -13,6 +13,7 @@ in the source distribution for its full text.
 #include <stdlib.h>
 #include <string.h>
 
+#include "Macros.h"
 #include "XUtils.h"
 
 
@@ -196,6 +197,140 @@ void Vector_insertionSort(Vector* this) {
    assert(Vector_isConsistent(this));
 }
 
+static int Vector_compareSortKeys(const void* v1, const void* v2) {
+   const VectorSortKey* k1 = v1;
+   const VectorSortKey* k2 = v2;
+
+   int r = SPACESHIP_NUMBER(k1->key, k2->key);
+   return r ? r : SPACESHIP_NUMBER(k1->tie, k2->tie);
+}
+
+/* Below this many items a comparison sort is cheaper than the radix passes */
+#define VECTOR_RADIX_MIN_ITEMS 256
+
+#define VECTOR_RADIX_DIGITS 12
+
+/* Digit d of the combined sort key, least significant first: 0-3 are the tie, 4-11 the key */
+static inline unsigned int Vector_sortKeyDigit(const VectorSortKey* k, unsigned int d) {
+   if (d < 4)
+      return (((uint32_t)k->tie ^ UINT32_C(0x80000000)) >> (8 * d)) & 0xFF;
+
+   return (unsigned int)(k->key >> (8 * (d - 4))) & 0xFF;
+}
+
+/*
+ * LSD radix sort on bytes; the histograms of all digits are taken in one
+ * pass, and digits where all items agree, like the high bytes of small
+ * numbers, are skipped. Returns the array holding the result, which is
+ * either keys or scratch.
+ */
+static VectorSortKey* Vector_radixSortKeys(VectorSortKey* keys, VectorSortKey* scratch, size_t n) {
+   size_t (*counts)[256] = xCalloc(VECTOR_RADIX_DIGITS, sizeof(*counts));
+
+   for (size_t i = 0; i < n; i++) {
+      for (unsigned int d = 0; d < VECTOR_RADIX_DIGITS; d++)
+         counts[d][Vector_sortKeyDigit(&keys[i], d)]++;
+   }
+
+   VectorSortKey* src = keys;
+   VectorSortKey* dst = scratch;
+   for (unsigned int d = 0; d < VECTOR_RADIX_DIGITS; d++) {
+      size_t* count = counts[d];
+      if (count[Vector_sortKeyDigit(&src[0], d)] == n)
+         continue;
+
+      size_t offset = 0;
+      for (unsigned int b = 0; b < 256; b++) {
+         size_t c = count[b];
+         count[b] = offset;
+         offset += c;
+      }
+
+      for (size_t i = 0; i < n; i++)
+         dst[count[Vector_sortKeyDigit(&src[i], d)]++] = src[i];
+
+      VectorSortKey* t = src;
+      src = dst;
+      dst = t;
+   }
+
+   free(counts);
+   return src;
+}
+
+static inline bool Vector_sortKeyLess(const VectorSortKey* k1, const VectorSortKey* k2) {
+   return k1->key < k2->key || (k1->key == k2->key && k1->tie < k2->tie);
+}
+
+static inline void Vector_swapSortKeys(VectorSortKey* keys, size_t i, size_t j) {
+   VectorSortKey t = keys[i];
+   keys[i] = keys[j];
+   keys[j] = t;
+}
+
+/* Quickselect moving the k smallest keys, in no particular order, to the front */
+static void Vector_selectSortKeys(VectorSortKey* keys, size_t n, size_t k) {
+   size_t lo = 0;
+   size_t hi = n;
+
+   while (hi - lo > 1) {
+      /* Median of three as pivot, moved to the end of the range */
+      size_t mid = lo + (hi - lo) / 2;
+      if (Vector_sortKeyLess(&keys[mid], &keys[lo]))
+         Vector_swapSortKeys(keys, mid, lo);
+      if (Vector_sortKeyLess(&keys[hi - 1], &keys[lo]))
+         Vector_swapSortKeys(keys, hi - 1, lo);
+      if (Vector_sortKeyLess(&keys[mid], &keys[hi - 1]))
+         Vector_swapSortKeys(keys, mid, hi - 1);
+
+      const VectorSortKey pivot = keys[hi - 1];
+      size_t p = lo;
+      for (size_t i = lo; i < hi - 1; i++) {
+         if (Vector_sortKeyLess(&keys[i], &pivot))
+            Vector_swapSortKeys(keys, i, p++);
+      }
+      Vector_swapSortKeys(keys, p, hi - 1);
+
+      if (p == k || p + 1 == k)
+         return;
+
+      if (p > k) {
+         hi = p;
+      } else {
+         lo = p + 1;
+      }
+   }
+}
+
+void Vector_sortByKeys(Vector* this, int start, VectorSortKey* keys, int limit) {
+   assert(Vector_isConsistent(this));
+   assert(start >= 0 && start <= this->items);
+   assert(limit >= 0);
+
+   size_t n = (size_t)(this->items - start);
+   size_t k = MINIMUM((size_t)limit, n);
+   if (k < n)
+      Vector_selectSortKeys(keys, n, k);
+
+   VectorSortKey* scratch = NULL;
+   const VectorSortKey* sorted = keys;
+   if (k < VECTOR_RADIX_MIN_ITEMS) {
+      qsort(keys, k, sizeof(*keys), Vector_compareSortKeys);
+   } else {
+      scratch = xMallocArray(k, sizeof(*scratch));
+      sorted = Vector_radixSortKeys(keys, scratch, k);
+   }
+
+   Object** array = this->array + start;
+   for (size_t i = 0; i < k; i++)
+      array[i] = sorted[i].object;
+   for (size_t i = k; i < n; i++)
+      array[i] = keys[i].object;
+
+   free(scratch);
+   assert(Vector_isConsistent(this));
+}
+
 static void Vector_resizeIfNecessary(Vector* this, int newSize) {
    assert(newSize >= 0);
    if (newSize > this->arraySize) {
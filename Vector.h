@@ -10,6 +10,7 @@ in the source distribution for its full text.
 #include "Object.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 
 
 #ifndef DEFAULT_SIZE
@@ -43,6 +44,21 @@ static inline void Vector_quickSort(Vector* this) {
 
 void Vector_insertionSort(Vector* this);
 
+/* Precomputed order of an item: by key, then by tie */
+typedef struct VectorSortKey_ {
+   uint64_t key;
+   int tie;
+   Object* object;
+} VectorSortKey;
+
+/*
+ * Reorder the items from start on like their keys sort, given one key per
+ * item in any order. Only the first limit of those items are guaranteed to
+ * be in order; the others follow them in unspecified order. The key array
+ * is used as scratch space.
+ */
+void Vector_sortByKeys(Vector* this, int start, VectorSortKey* keys, int limit);
+
 void Vector_insert(Vector* this, int idx, void* data_);
 
 Object* Vector_take(Vector* this, int idx);
@@ -20,6 +20,7 @@ in the source distribution for its full text.
 #include <unistd.h>
 
 #include "CRT.h"
+#include "Instrument.h"
 #include "Macros.h"
 
 
@@ -36,6 +37,7 @@ void* xMalloc(size_t size) {
    if (!data) {
       fail();
    }
+   Instrument_countAllocation();
    return data;
 }
 
@@ -58,6 +60,7 @@ void* xCalloc(size_t nmemb, size_t size) {
    if (!data) {
       fail();
    }
+   Instrument_countAllocation();
    return data;
 }
 
@@ -75,6 +78,7 @@ void* xRealloc(void* ptr, size_t size) {
       // free(ptr);
       fail();
    }
+   Instrument_countAllocation();
    return data;
 }
 
@@ -233,6 +237,7 @@ int xAsprintf(char** strp, const char* fmt, ...) {
    if (r < 0 || !*strp) {
       fail();
    }
+   Instrument_countAllocation();
 
    return r;
 }
@@ -257,6 +262,7 @@ char* xStrdup(const char* str) {
    if (!data) {
       fail();
    }
+   Instrument_countAllocation();
    return data;
 }
 
@@ -273,6 +279,7 @@ char* xStrndup(const char* str, size_t len) {
    if (!data) {
       fail();
    }
+   Instrument_countAllocation();
    return data;
 }
 
@@ -329,6 +336,33 @@ ssize_t xReadfileat(openat_arg_t dirfd, const char* pathname, void* buffer, size
    return readfd_internal(fd, buffer, count);
 }
 
+ssize_t xPreadfile(int fd, void* buffer, size_t count) {
+   if (!count)
+      return -EINVAL;
+
+   size_t alreadyRead = 0;
+   count--; // reserve one for null-terminator
+
+   while (alreadyRead < count) {
+      ssize_t res = pread(fd, (char*)buffer + alreadyRead, count - alreadyRead, (off_t)alreadyRead);
+      if (res == -1) {
+         if (errno == EINTR)
+            continue;
+
+         *((char*)buffer) = '\0';
+         return -errno;
+      }
+
+      if (res == 0)
+         break;
+
+      alreadyRead += (size_t)res;
+   }
+
+   ((char*)buffer)[alreadyRead] = '\0';
+   return (ssize_t)alreadyRead;
+}
+
 ssize_t full_write(int fd, const void* buf, size_t count) {
    ssize_t written = 0;
 
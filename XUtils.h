@@ -121,6 +121,9 @@ ATTR_NONNULL ATTR_ACCESS3_W(2, 3)
 ssize_t xReadfile(const char* pathname, void* buffer, size_t count);
 ATTR_NONNULL ATTR_ACCESS3_W(3, 4)
 ssize_t xReadfileat(openat_arg_t dirfd, const char* pathname, void* buffer, size_t count);
+/* Like xReadfile, but reads an already opened file from its start and keeps it open */
+ATTR_NONNULL ATTR_ACCESS3_W(2, 3)
+ssize_t xPreadfile(int fd, void* buffer, size_t count);
 
 ATTR_NONNULL ATTR_ACCESS3_R(2, 3)
 ssize_t full_write(int fd, const void* buf, size_t count);
@@ -119,18 +119,16 @@ static void DarwinProcess_updateCwd(pid_t pid, Process* proc) {
 
    int r = proc_pidinfo(pid, PROC_PIDVNODEPATHINFO, 0, &vpi, sizeof(vpi));
    if (r <= 0) {
-      free(proc->procCwd);
-      proc->procCwd = NULL;
+      Process_updateCwd(proc, NULL);
       return;
    }
 
    if (!vpi.pvi_cdir.vip_path[0]) {
-      free(proc->procCwd);
-      proc->procCwd = NULL;
+      Process_updateCwd(proc, NULL);
       return;
    }
 
-   free_and_xStrdup(&proc->procCwd, vpi.pvi_cdir.vip_path);
+   Process_updateCwd(proc, vpi.pvi_cdir.vip_path);
 }
 
 static void DarwinProcess_updateCmdLine(const struct kinfo_proc* k, Process* proc) {
@@ -526,6 +524,7 @@ const ProcessClass DarwinProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = DarwinProcess_rowWriteField
    },
    .compareByKey = DarwinProcess_compareByKey
@@ -115,6 +115,7 @@ const ProcessClass DragonFlyBSDProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = DragonFlyBSDProcess_rowWriteField
    },
    .compareByKey = DragonFlyBSDProcess_compareByKey
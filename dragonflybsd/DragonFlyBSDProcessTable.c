@@ -81,19 +81,17 @@ static void DragonFlyBSDProcessTable_updateCwd(const struct kinfo_proc* kproc, P
    char buffer[2048];
    size_t size = sizeof(buffer);
    if (sysctl(mib, 4, buffer, &size, NULL, 0) != 0) {
-      free(proc->procCwd);
-      proc->procCwd = NULL;
+      Process_updateCwd(proc, NULL);
       return;
    }
 
    /* Kernel threads return an empty buffer */
    if (buffer[0] == '\0') {
-      free(proc->procCwd);
-      proc->procCwd = NULL;
+      Process_updateCwd(proc, NULL);
       return;
    }
 
-   free_and_xStrdup(&proc->procCwd, buffer);
+   Process_updateCwd(proc, buffer);
 }
 
 static void DragonFlyBSDProcessTable_updateProcessName(kvm_t* kd, const struct kinfo_proc* kproc, Process* proc) {
@@ -149,6 +149,7 @@ const ProcessClass FreeBSDProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = FreeBSDProcess_rowWriteField
    },
    .compareByKey = FreeBSDProcess_compareByKey
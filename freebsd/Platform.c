@@ -40,6 +40,7 @@ in the source distribution for its full text.
 #include "MemorySwapMeter.h"
 #include "Meter.h"
 #include "NetworkIOMeter.h"
+#include "SelfMeter.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -132,6 +133,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &ZfsCompressedArcMeter_class,
    &DiskIOMeter_class,
    &FileDescriptorMeter_class,
+   &SelfMeter_class,
    &NetworkIOMeter_class,
    NULL
 };
@@ -0,0 +1,379 @@
+/*
+htop - linux/BatchReader.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/BatchReader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#if defined(HAVE_IO_URING) && defined(HAVE_OPENAT)
+#define BATCHREADER_IO_URING
+#endif
+
+#ifdef BATCHREADER_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <linux/io_uring.h>
+#endif
+
+
+#ifdef BATCHREADER_IO_URING
+
+/* Submission queue size; larger batches are split into several rounds */
+#define BATCHREADER_DEPTH 256
+
+/* user_data of the close requests, which need no handling */
+#define BATCHREADER_CLOSE_TAG UINT64_MAX
+
+typedef enum BatchReadState_ {
+   BATCHREAD_PENDING,
+   BATCHREAD_OPENED,
+   BATCHREAD_DONE,
+} BatchReadState;
+
+#endif /* BATCHREADER_IO_URING */
+
+struct BatchReader_ {
+   bool async;
+
+#ifdef BATCHREADER_IO_URING
+   int ringFd;
+
+   void* sqRing;
+   size_t sqRingSize;
+   void* cqRing;
+   size_t cqRingSize;
+   struct io_uring_sqe* sqes;
+   size_t sqesSize;
+
+   unsigned int sqEntries;
+   unsigned int sqMask;
+   unsigned int sqTail;
+   unsigned int* sqTailPtr;
+   unsigned int* sqArray;
+
+   unsigned int cqMask;
+   unsigned int* cqHeadPtr;
+   unsigned int* cqTailPtr;
+   struct io_uring_cqe* cqes;
+
+   /* Per read state of the current run */
+   int* fds;
+   unsigned char* states;
+   size_t stateSize;
+#endif
+};
+
+static void BatchReader_readSync(BatchRead* read) {
+   if (read->path)
+      read->result = xReadfileat(read->dir, read->path, read->buffer, read->size);
+   else
+      read->result = xPreadfile(read->fd, read->buffer, read->size);
+}
+
+#ifdef BATCHREADER_IO_URING
+
+static bool BatchReader_probe(int ringFd) {
+   const size_t nOps = 256;
+   struct io_uring_probe* probe = xCalloc(1, sizeof(struct io_uring_probe) + nOps * sizeof(struct io_uring_probe_op));
+
+   bool ok = syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, (unsigned int)nOps) == 0;
+   if (ok) {
+      static const unsigned int required[] = { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE };
+      for (size_t i = 0; i < ARRAYSIZE(required); i++) {
+         if (required[i] > probe->last_op || !(probe->ops[required[i]].flags & IO_URING_OP_SUPPORTED))
+            ok = false;
+      }
+   }
+
+   free(probe);
+   return ok;
+}
+
+static void BatchReader_teardown(BatchReader* this) {
+   if (this->sqes)
+      munmap(this->sqes, this->sqesSize);
+   if (this->cqRing && this->cqRing != this->sqRing)
+      munmap(this->cqRing, this->cqRingSize);
+   if (this->sqRing)
+      munmap(this->sqRing, this->sqRingSize);
+   if (this->ringFd >= 0)
+      close(this->ringFd);
+
+   this->sqes = NULL;
+   this->cqRing = NULL;
+   this->sqRing = NULL;
+   this->ringFd = -1;
+   this->async = false;
+}
+
+static bool BatchReader_setup(BatchReader* this) {
+   struct io_uring_params params;
+   memset(&params, 0, sizeof(params));
+
+   this->ringFd = (int)syscall(__NR_io_uring_setup, BATCHREADER_DEPTH, &params);
+   if (this->ringFd < 0)
+      return false;
+
+   if (!BatchReader_probe(this->ringFd))
+      goto fail;
+
+   this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+   this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+   if (params.features & IORING_FEAT_SINGLE_MMAP)
+      this->sqRingSize = this->cqRingSize = MAXIMUM(this->sqRingSize, this->cqRingSize);
+
+   this->sqRing = mmap(NULL, this->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_SQ_RING);
+   if (this->sqRing == MAP_FAILED) {
+      this->sqRing = NULL;
+      goto fail;
+   }
+
+   if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      this->cqRing = this->sqRing;
+   } else {
+      this->cqRing = mmap(NULL, this->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_CQ_RING);
+      if (this->cqRing == MAP_FAILED) {
+         this->cqRing = NULL;
+         goto fail;
+      }
+   }
+
+   this->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+   this->sqes = mmap(NULL, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_SQES);
+   if (this->sqes == MAP_FAILED) {
+      this->sqes = NULL;
+      goto fail;
+   }
+
+   char* sq = this->sqRing;
+   char* cq = this->cqRing;
+   this->sqEntries = params.sq_entries;
+   this->sqMask = *(unsigned int*)(void*)(sq + params.sq_off.ring_mask);
+   this->sqTailPtr = (unsigned int*)(void*)(sq + params.sq_off.tail);
+   this->sqArray = (unsigned int*)(void*)(sq + params.sq_off.array);
+   this->sqTail = *this->sqTailPtr;
+   this->cqMask = *(unsigned int*)(void*)(cq + params.cq_off.ring_mask);
+   this->cqHeadPtr = (unsigned int*)(void*)(cq + params.cq_off.head);
+   this->cqTailPtr = (unsigned int*)(void*)(cq + params.cq_off.tail);
+   this->cqes = (struct io_uring_cqe*)(void*)(cq + params.cq_off.cqes);
+
+   this->async = true;
+   return true;
+
+fail:
+   BatchReader_teardown(this);
+   return false;
+}
+
+static struct io_uring_sqe* BatchReader_prepare(BatchReader* this, uint8_t opcode, int fd, uint64_t userData) {
+   unsigned int index = this->sqTail & this->sqMask;
+   this->sqTail++;
+
+   struct io_uring_sqe* sqe = &this->sqes[index];
+   memset(sqe, 0, sizeof(*sqe));
+   sqe->opcode = opcode;
+   sqe->fd = fd;
+   sqe->user_data = userData;
+   this->sqArray[index] = index;
+   return sqe;
+}
+
+static void BatchReader_complete(BatchReader* this, BatchRead* reads, uint64_t userData, int res) {
+   if (userData == BATCHREADER_CLOSE_TAG)
+      return;
+
+   size_t i = (size_t)userData;
+   if (this->states[i] == BATCHREAD_PENDING) {
+      /* open request */
+      if (res < 0) {
+         reads[i].result = res;
+         this->states[i] = BATCHREAD_DONE;
+      } else {
+         this->fds[i] = res;
+         this->states[i] = BATCHREAD_OPENED;
+      }
+      return;
+   }
+
+   /* read request */
+   if (res < 0) {
+      reads[i].buffer[0] = '\0';
+   } else {
+      reads[i].buffer[res] = '\0';
+   }
+   reads[i].result = res;
+   this->states[i] = BATCHREAD_DONE;
+}
+
+/* Submit the prepared requests and wait for all of their completions */
+static bool BatchReader_submitAndWait(BatchReader* this, BatchRead* reads, unsigned int count) {
+   __atomic_store_n(this->sqTailPtr, this->sqTail, __ATOMIC_RELEASE);
+
+   unsigned int toSubmit = count;
+   unsigned int reaped = 0;
+   while (reaped < count) {
+      long r = syscall(__NR_io_uring_enter, this->ringFd, toSubmit, count - reaped, IORING_ENTER_GETEVENTS, NULL, 0);
+      if (r < 0) {
+         if (errno == EINTR)
+            continue;
+
+         return false;
+      }
+      toSubmit -= MINIMUM((unsigned int)r, toSubmit);
+
+      unsigned int head = *this->cqHeadPtr;
+      unsigned int tail = __atomic_load_n(this->cqTailPtr, __ATOMIC_ACQUIRE);
+      for (; head != tail; head++) {
+         const struct io_uring_cqe* cqe = &this->cqes[head & this->cqMask];
+         BatchReader_complete(this, reads, cqe->user_data, cqe->res);
+         reaped++;
+      }
+      __atomic_store_n(this->cqHeadPtr, head, __ATOMIC_RELEASE);
+   }
+
+   return true;
+}
+
+static bool BatchReader_runAsync(BatchReader* this, BatchRead* reads, size_t count) {
+   if (this->stateSize < count) {
+      this->stateSize = count;
+      this->fds = xReallocArray(this->fds, count, sizeof(int));
+      this->states = xReallocArray(this->states, count, sizeof(unsigned char));
+   }
+
+   for (size_t i = 0; i < count; i++) {
+      this->fds[i] = reads[i].path ? -1 : reads[i].fd;
+      this->states[i] = reads[i].path ? BATCHREAD_PENDING : BATCHREAD_OPENED;
+      reads[i].result = -EINVAL;
+   }
+
+   /* Round 1: open the files given by path */
+   unsigned int queued = 0;
+   for (size_t i = 0; i < count; i++) {
+      if (this->states[i] != BATCHREAD_PENDING)
+         continue;
+
+      struct io_uring_sqe* sqe = BatchReader_prepare(this, IORING_OP_OPENAT, reads[i].dir, i);
+      sqe->addr = (uint64_t)(uintptr_t)reads[i].path;
+      sqe->open_flags = O_RDONLY | O_CLOEXEC;
+
+      if (++queued == this->sqEntries) {
+         if (!BatchReader_submitAndWait(this, reads, queued))
+            return false;
+         queued = 0;
+      }
+   }
+   if (queued && !BatchReader_submitAndWait(this, reads, queued))
+      return false;
+
+   /* Round 2: read everything, closing the files opened in round 1 right after */
+   queued = 0;
+   for (size_t i = 0; i < count; i++) {
+      if (this->states[i] != BATCHREAD_OPENED)
+         continue;
+
+      if (reads[i].size == 0) {
+         reads[i].result = -EINVAL;
+         this->states[i] = BATCHREAD_DONE;
+      }
+
+      bool owned = reads[i].path != NULL;
+      if (queued + (owned ? 2 : 1) > this->sqEntries) {
+         if (!BatchReader_submitAndWait(this, reads, queued))
+            return false;
+         queued = 0;
+      }
+
+      if (this->states[i] == BATCHREAD_OPENED) {
+         struct io_uring_sqe* sqe = BatchReader_prepare(this, IORING_OP_READ, this->fds[i], i);
+         sqe->addr = (uint64_t)(uintptr_t)reads[i].buffer;
+         sqe->len = (uint32_t)MINIMUM(reads[i].size - 1, (size_t)UINT32_MAX);
+         sqe->off = 0;
+         /* A hard link keeps the close even if the read fails */
+         if (owned)
+            sqe->flags |= IOSQE_IO_HARDLINK;
+         queued++;
+      }
+
+      if (owned) {
+         BatchReader_prepare(this, IORING_OP_CLOSE, this->fds[i], BATCHREADER_CLOSE_TAG);
+         queued++;
+      }
+   }
+   if (queued && !BatchReader_submitAndWait(this, reads, queued))
+      return false;
+
+   return true;
+}
+
+#endif /* BATCHREADER_IO_URING */
+
+BatchReader* BatchReader_new(void) {
+   BatchReader* this = xCalloc(1, sizeof(BatchReader));
+   this->async = false;
+
+#ifdef BATCHREADER_IO_URING
+   this->ringFd = -1;
+   (void) BatchReader_setup(this);
+#endif
+
+   return this;
+}
+
+void BatchReader_delete(BatchReader* this) {
+   if (!this)
+      return;
+
+#ifdef BATCHREADER_IO_URING
+   BatchReader_teardown(this);
+   free(this->fds);
+   free(this->states);
+#endif
+
+   free(this);
+}
+
+bool BatchReader_isAsync(const BatchReader* this) {
+   return this->async;
+}
+
+void BatchReader_run(BatchReader* this, BatchRead* reads, size_t count) {
+#ifdef BATCHREADER_IO_URING
+   if (this->async && count > 0) {
+      if (BatchReader_runAsync(this, reads, count))
+         return;
+
+      /*
+       * The ring failed in an unexpected way: stop using it and finish the
+       * outstanding reads synchronously. Files opened by requests in flight
+       * are left alone, as their state is unknown.
+       */
+      BatchReader_teardown(this);
+      for (size_t i = 0; i < count; i++) {
+         if (this->states[i] != BATCHREAD_DONE)
+            BatchReader_readSync(&reads[i]);
+      }
+      return;
+   }
+#else
+   (void) this;
+#endif
+
+   for (size_t i = 0; i < count; i++)
+      BatchReader_readSync(&reads[i]);
+}
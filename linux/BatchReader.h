@@ -0,0 +1,46 @@
+#ifndef HEADER_BatchReader
+#define HEADER_BatchReader
+/*
+htop - linux/BatchReader.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "Compat.h"
+
+
+typedef struct BatchRead_ {
+   /* Either read path below dir (like xReadfileat) ... */
+   openat_arg_t dir;
+   const char* path;
+   /* ... or, if path is NULL, the already opened fd from its start (like xPreadfile) */
+   int fd;
+
+   char* buffer;
+   size_t size;
+
+   /* Bytes read, the buffer being NUL-terminated, or a negative errno value */
+   ssize_t result;
+} BatchRead;
+
+typedef struct BatchReader_ BatchReader;
+
+/* Uses io_uring if available, plain synchronous reads otherwise */
+BatchReader* BatchReader_new(void);
+
+void BatchReader_delete(BatchReader* this);
+
+bool BatchReader_isAsync(const BatchReader* this);
+
+/*
+ * Perform all reads. Each file is read with a single read request, which
+ * is sufficient for files generated at once on open like most procfs files.
+ */
+void BatchReader_run(BatchReader* this, BatchRead* reads, size_t count);
+
+#endif /* HEADER_BatchReader */
@@ -0,0 +1,234 @@
+/*
+htop - linux/CGroupRow.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupRow.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+
+const LinuxDynamicField CGroupRow_fields[CGROUP_FIELD_COUNT] = {
+   [CGROUP_FIELD_PERCENT_CPU] = { .name = "CPU", .heading = "CPU%", .description = "Percentage of one CPU used by the cgroup since the last refresh", .width = 5, },
+   [CGROUP_FIELD_MEMORY] = { .name = "MEMORY", .heading = "MEM", .description = "Memory charged to the cgroup", .width = 5, },
+   [CGROUP_FIELD_PROCS] = { .name = "PROCS", .heading = "PROCS", .description = "Number of processes in the cgroup", .width = 6, },
+   [CGROUP_FIELD_IO_READ_RATE] = { .name = "IO_READ_RATE", .heading = "DISK READ", .description = "Bytes read from block devices per second", .width = 11, },
+   [CGROUP_FIELD_IO_WRITE_RATE] = { .name = "IO_WRITE_RATE", .heading = "DISK WRITE", .description = "Bytes written to block devices per second", .width = 11, },
+   [CGROUP_FIELD_MEMORY_PRESSURE] = { .name = "MEMORY_PRESSURE", .heading = "MEMPSI", .description = "Percentage of time some tasks stalled on memory over the last 10 seconds", .width = 6, },
+   [CGROUP_FIELD_NAME] = { .name = "NAME", .heading = "CGROUP", .description = "Path of the cgroup", .width = -6, },
+};
+
+CGroupRow* CGroupRow_new(const Machine* host, int id, const char* path) {
+   CGroupRow* this = xCalloc(1, sizeof(CGroupRow));
+   Object_setClass(this, Class(CGroupRow));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+   super->id = id;
+   super->group = id;
+
+   CGroupRow_setPath(this, path);
+
+   this->percent_cpu = NAN;
+   this->memory = UINT64_MAX;
+   this->io_rate_read_bps = NAN;
+   this->io_rate_write_bps = NAN;
+   this->memory_pressure = NAN;
+
+   return this;
+}
+
+void CGroupRow_setPath(CGroupRow* this, const char* path) {
+   free_and_xStrdup(&this->path, path);
+   const char* slash = strrchr(this->path, '/');
+   this->name = (slash && slash[1]) ? slash + 1 : this->path;
+}
+
+void CGroupRow_done(CGroupRow* this) {
+   free(this->path);
+   Row_done(&this->super);
+}
+
+static void CGroupRow_delete(Object* cast) {
+   CGroupRow* this = (CGroupRow*) cast;
+   CGroupRow_done(this);
+   free(this);
+}
+
+static void CGroupRow_writeField(const Row* super, RichString* str, RowField field) {
+   const CGroupRow* this = (const CGroupRow*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   switch ((int)field - ROW_DYNAMIC_FIELDS) {
+   case CGROUP_FIELD_PERCENT_CPU:
+      Row_printPercentage(this->percent_cpu, buffer, n, CGroupRow_fields[CGROUP_FIELD_PERCENT_CPU].width, &attr);
+      break;
+   case CGROUP_FIELD_MEMORY:
+      Row_printBytes(str, this->memory == UINT64_MAX ? ULLONG_MAX : this->memory, coloring);
+      return;
+   case CGROUP_FIELD_PROCS:
+      if (this->procs == 0)
+         attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "%6u ", this->procs);
+      break;
+   case CGROUP_FIELD_IO_READ_RATE:
+      Row_printRate(str, this->io_rate_read_bps, coloring);
+      return;
+   case CGROUP_FIELD_IO_WRITE_RATE:
+      Row_printRate(str, this->io_rate_write_bps, coloring);
+      return;
+   case CGROUP_FIELD_MEMORY_PRESSURE:
+      if (isNonnegative(this->memory_pressure)) {
+         if (this->memory_pressure < 0.005F)
+            attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%6.2f ", this->memory_pressure);
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "   N/A ");
+      }
+      break;
+   case CGROUP_FIELD_NAME:
+      if (settings->ss->treeView) {
+         Row_writeTreeBranches(super, str);
+         RichString_appendWide(str, attr, this->name);
+      } else {
+         RichString_appendWide(str, attr, this->path);
+      }
+      return;
+   default:
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static bool CGroupRow_matchesFilter(const Row* super, const Table* table) {
+   const CGroupRow* this = (const CGroupRow*) super;
+   const char* incFilter = table->incFilter;
+
+   return incFilter && !String_contains_i(this->path, incFilter, true);
+}
+
+static const char* CGroupRow_sortKeyString(Row* super) {
+   const CGroupRow* this = (const CGroupRow*) super;
+   return this->path;
+}
+
+static bool CGroupRow_numericKey(const Row* super, RowField field, uint64_t* result) {
+   const CGroupRow* this = (const CGroupRow*) super;
+
+   switch ((int)field - ROW_DYNAMIC_FIELDS) {
+   case CGROUP_FIELD_PERCENT_CPU:
+      *result = Row_keyFromReal(this->percent_cpu);
+      return true;
+   case CGROUP_FIELD_MEMORY:
+      *result = this->memory == UINT64_MAX ? 0 : this->memory + 1;
+      return true;
+   case CGROUP_FIELD_PROCS:
+      *result = this->procs;
+      return true;
+   case CGROUP_FIELD_IO_READ_RATE:
+      *result = Row_keyFromReal(this->io_rate_read_bps);
+      return true;
+   case CGROUP_FIELD_IO_WRITE_RATE:
+      *result = Row_keyFromReal(this->io_rate_write_bps);
+      return true;
+   case CGROUP_FIELD_MEMORY_PRESSURE:
+      *result = Row_keyFromReal(this->memory_pressure);
+      return true;
+   default:
+      return false;
+   }
+}
+
+static bool CGroupRow_machineValue(const Row* super, RowField field, RowValue* value) {
+   const CGroupRow* this = (const CGroupRow*) super;
+
+   switch ((int)field - ROW_DYNAMIC_FIELDS) {
+   case CGROUP_FIELD_PERCENT_CPU:
+      return Row_valueReal(value, this->percent_cpu);
+   case CGROUP_FIELD_MEMORY:
+      if (this->memory == UINT64_MAX)
+         return Row_valueNone(value);
+      return Row_valueUnsigned(value, this->memory / ONE_K);
+   case CGROUP_FIELD_PROCS:
+      return Row_valueUnsigned(value, this->procs);
+   case CGROUP_FIELD_IO_READ_RATE:
+      return Row_valueReal(value, this->io_rate_read_bps);
+   case CGROUP_FIELD_IO_WRITE_RATE:
+      return Row_valueReal(value, this->io_rate_write_bps);
+   case CGROUP_FIELD_MEMORY_PRESSURE:
+      return Row_valueReal(value, this->memory_pressure);
+   default:
+      return false;
+   }
+}
+
+static int CGroupRow_compareByKey(const CGroupRow* c1, const CGroupRow* c2, RowField key) {
+   switch ((int)key - ROW_DYNAMIC_FIELDS) {
+   case CGROUP_FIELD_PERCENT_CPU:
+      return compareRealNumbers(c1->percent_cpu, c2->percent_cpu);
+   case CGROUP_FIELD_MEMORY:
+      /* unaccounted memory orders before any amount */
+      return SPACESHIP_NUMBER(c1->memory + 1, c2->memory + 1);
+   case CGROUP_FIELD_PROCS:
+      return SPACESHIP_NUMBER(c1->procs, c2->procs);
+   case CGROUP_FIELD_IO_READ_RATE:
+      return compareRealNumbers(c1->io_rate_read_bps, c2->io_rate_read_bps);
+   case CGROUP_FIELD_IO_WRITE_RATE:
+      return compareRealNumbers(c1->io_rate_write_bps, c2->io_rate_write_bps);
+   case CGROUP_FIELD_MEMORY_PRESSURE:
+      return compareRealNumbers(c1->memory_pressure, c2->memory_pressure);
+   case CGROUP_FIELD_NAME:
+      return strcmp(c1->path, c2->path);
+   default:
+      return 0;
+   }
+}
+
+static int CGroupRow_compare(const void* v1, const void* v2) {
+   const CGroupRow* c1 = (const CGroupRow*)v1;
+   const CGroupRow* c2 = (const CGroupRow*)v2;
+   const ScreenSettings* ss = c1->super.host->settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int result = CGroupRow_compareByKey(c1, c2, key);
+
+   // Implement tie-breaker (needed to make tree mode more stable)
+   if (!result)
+      return SPACESHIP_NUMBER(c1->super.id, c2->super.id);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+const RowClass CGroupRow_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = CGroupRow_delete,
+      .compare = CGroupRow_compare,
+   },
+   .writeField = CGroupRow_writeField,
+   .matchesFilter = CGroupRow_matchesFilter,
+   .sortKeyString = CGroupRow_sortKeyString,
+   .numericKey = CGroupRow_numericKey,
+   .machineValue = CGroupRow_machineValue,
+};
@@ -0,0 +1,67 @@
+#ifndef HEADER_CGroupRow
+#define HEADER_CGroupRow
+/*
+htop - linux/CGroupRow.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Machine.h"
+#include "Row.h"
+#include "RowField.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+/* Columns of the cgroups screen, following the reserved process fields */
+typedef enum CGroupField_ {
+   CGROUP_FIELD_PERCENT_CPU,
+   CGROUP_FIELD_MEMORY,
+   CGROUP_FIELD_PROCS,
+   CGROUP_FIELD_IO_READ_RATE,
+   CGROUP_FIELD_IO_WRITE_RATE,
+   CGROUP_FIELD_MEMORY_PRESSURE,
+   CGROUP_FIELD_NAME,
+   CGROUP_FIELD_COUNT
+} CGroupField;
+
+#define CGROUP_ROW_FIELD(f_) ((RowField)(ROW_DYNAMIC_FIELDS + (f_)))
+
+extern const LinuxDynamicField CGroupRow_fields[CGROUP_FIELD_COUNT];
+
+/*
+ * A cgroup of the unified hierarchy. Its values cover the cgroup and all
+ * its descendants, as the kernel accounts them.
+ */
+typedef struct CGroupRow_ {
+   Row super;
+
+   char* path;                /* below the root of the hierarchy, "/" for the root */
+   const char* name;          /* last component of path */
+
+   unsigned int procs;        /* processes of the cgroup and its descendants */
+   float percent_cpu;         /* of one CPU, over the time since the last scan */
+   uint64_t memory;           /* bytes; UINT64_MAX if not accounted */
+   double io_rate_read_bps;
+   double io_rate_write_bps;
+   float memory_pressure;     /* share of time some tasks stalled on memory over 10s, NAN if unknown */
+
+   uint64_t cpu_usage_usec;
+   uint64_t io_read_bytes;
+   uint64_t io_write_bytes;
+   uint64_t last_scan_ms;     /* realtime of the previous scan, 0 for none */
+} CGroupRow;
+
+extern const RowClass CGroupRow_class;
+
+CGroupRow* CGroupRow_new(const Machine* host, int id, const char* path);
+
+void CGroupRow_setPath(CGroupRow* this, const char* path);
+
+void CGroupRow_done(CGroupRow* this);
+
+#endif
@@ -0,0 +1,244 @@
+/*
+htop - linux/CGroupTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupTable.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Row.h"
+#include "XUtils.h"
+
+#include "linux/CGroupRow.h"
+
+
+#define CGROUP_PATH_MAX 4096
+
+CGroupTable* CGroupTable_new(Machine* host) {
+   CGroupTable* this = xCalloc(1, sizeof(CGroupTable));
+   Object_setClass(this, Class(CGroupTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(CGroupRow), host);
+
+   return this;
+}
+
+void CGroupTable_done(CGroupTable* this) {
+   free(this->root);
+   Table_done(&this->super);
+}
+
+static void CGroupTable_delete(Object* cast) {
+   CGroupTable* this = (CGroupTable*) cast;
+   CGroupTable_done(this);
+   free(this);
+}
+
+/* Undo the octal escapes of blanks and backslashes in mountinfo paths */
+static void CGroupTable_unescapeMountPoint(char* path) {
+   char* out = path;
+   for (const char* in = path; *in; ) {
+      if (in[0] == '\\' &&
+          in[1] >= '0' && in[1] <= '3' &&
+          in[2] >= '0' && in[2] <= '7' &&
+          in[3] >= '0' && in[3] <= '7') {
+         *out++ = (char)(((in[1] - '0') << 6) | ((in[2] - '0') << 3) | (in[3] - '0'));
+         in += 4;
+      } else {
+         *out++ = *in++;
+      }
+   }
+   *out = '\0';
+}
+
+static char* CGroupTable_findRoot(void) {
+   FILE* fp = fopen(PROCDIR "/self/mountinfo", "r");
+   if (!fp)
+      return NULL;
+
+   char* root = NULL;
+   char* line;
+   while (!root && (line = String_readLine(fp))) {
+      char mountPoint[CGROUP_PATH_MAX];
+      if (strstr(line, " - cgroup2 ") && sscanf(line, "%*s %*s %*s %*s %4095s", mountPoint) == 1) {
+         CGroupTable_unescapeMountPoint(mountPoint);
+         root = xStrdup(mountPoint);
+      }
+      free(line);
+   }
+   fclose(fp);
+   return root;
+}
+
+static unsigned int CGroupTable_countLines(int dirfd, const char* name) {
+   int fd = openat(dirfd, name, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return 0;
+
+   unsigned int lines = 0;
+   char buffer[4096];
+   ssize_t len;
+   while ((len = read(fd, buffer, sizeof(buffer))) > 0) {
+      for (const char* nl = buffer; (nl = memchr(nl, '\n', (size_t)(buffer + len - nl))); nl++)
+         lines++;
+   }
+   close(fd);
+   return lines;
+}
+
+static void CGroupTable_readGroup(CGroupRow* cg, int dirfd, uint64_t now) {
+   char buffer[4096];
+   uint64_t timeDelta = cg->last_scan_ms ? saturatingSub(now, cg->last_scan_ms) : 0;
+   const char* value;
+
+   cg->percent_cpu = NAN;
+   if (xReadfileat(dirfd, "cpu.stat", buffer, sizeof(buffer)) > 0 && (value = strstr(buffer, "usage_usec "))) {
+      uint64_t usage = strtoull(value + strlen("usage_usec "), NULL, 10);
+      if (timeDelta)
+         cg->percent_cpu = saturatingSub(usage, cg->cpu_usage_usec) / (double)timeDelta / 10.0;
+      cg->cpu_usage_usec = usage;
+   }
+
+   cg->memory = UINT64_MAX;
+   if (xReadfileat(dirfd, "memory.current", buffer, sizeof(buffer)) > 0)
+      cg->memory = strtoull(buffer, NULL, 10);
+
+   /* one line per device, with keys like rbytes=, wbytes=, rios= and dbytes= */
+   cg->io_rate_read_bps = NAN;
+   cg->io_rate_write_bps = NAN;
+   if (xReadfileat(dirfd, "io.stat", buffer, sizeof(buffer)) >= 0) {
+      uint64_t readBytes = 0;
+      uint64_t writeBytes = 0;
+      for (value = buffer; (value = strstr(value, "rbytes=")); value += strlen("rbytes="))
+         readBytes += strtoull(value + strlen("rbytes="), NULL, 10);
+      for (value = buffer; (value = strstr(value, "wbytes=")); value += strlen("wbytes="))
+         writeBytes += strtoull(value + strlen("wbytes="), NULL, 10);
+
+      if (timeDelta) {
+         cg->io_rate_read_bps = saturatingSub(readBytes, cg->io_read_bytes) * /*ms to s*/1000. / timeDelta;
+         cg->io_rate_write_bps = saturatingSub(writeBytes, cg->io_write_bytes) * /*ms to s*/1000. / timeDelta;
+      }
+      cg->io_read_bytes = readBytes;
+      cg->io_write_bytes = writeBytes;
+   }
+
+   cg->memory_pressure = NAN;
+   if (xReadfileat(dirfd, "memory.pressure", buffer, sizeof(buffer)) > 0) {
+      float avg10;
+      if (sscanf(buffer, "some avg10=%f", &avg10) == 1)
+         cg->memory_pressure = avg10;
+   }
+
+   cg->last_scan_ms = now;
+}
+
+/*
+ * Update the row of the cgroup opened as fd, which this takes over, and
+ * recurse into its children. Returns the processes in the subtree.
+ */
+static unsigned int CGroupTable_scanGroup(CGroupTable* this, int fd, char* path, size_t pathLen, int parent) {
+   Table* super = &this->super;
+   const Machine* host = super->host;
+
+   DIR* dir = fdopendir(fd);
+   if (!dir) {
+      close(fd);
+      return 0;
+   }
+
+   int dfd = dirfd(dir);
+   struct stat sb;
+   if (fstat(dfd, &sb) != 0) {
+      closedir(dir);
+      return 0;
+   }
+
+   int id = (int)(sb.st_ino & INT_MAX);
+   CGroupRow* cg = (CGroupRow*) Hashtable_get(super->table, id);
+   if (!cg) {
+      cg = CGroupRow_new(host, id, path);
+      Table_add(super, &cg->super);
+   } else if (!String_eq(cg->path, path)) {
+      CGroupRow_setPath(cg, path);
+   }
+
+   cg->super.parent = parent;
+   CGroupTable_readGroup(cg, dfd, host->realtimeMs);
+   unsigned int procs = CGroupTable_countLines(dfd, "cgroup.procs");
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN)
+         continue;
+      if (entry->d_name[0] == '.')
+         continue;
+
+      size_t nameLen = strlen(entry->d_name);
+      size_t sepLen = pathLen > 1 ? 1 : 0;
+      if (pathLen + sepLen + nameLen >= CGROUP_PATH_MAX)
+         continue;
+
+      /* fails with ENOTDIR for the control files of unknown type */
+      int childFd = openat(dfd, entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+      if (childFd < 0)
+         continue;
+
+      if (sepLen)
+         path[pathLen] = '/';
+      memcpy(path + pathLen + sepLen, entry->d_name, nameLen + 1);
+      procs += CGroupTable_scanGroup(this, childFd, path, pathLen + sepLen + nameLen, id);
+      path[pathLen] = '\0';
+   }
+   closedir(dir);
+
+   cg->procs = procs;
+   cg->super.updated = true;
+   cg->super.show = true;
+   return procs;
+}
+
+static void CGroupTable_iterateEntries(Table* super) {
+   CGroupTable* this = (CGroupTable*) super;
+
+   if (!this->rootSearched) {
+      this->root = CGroupTable_findRoot();
+      this->rootSearched = true;
+   }
+   if (!this->root)
+      return;
+
+   int fd = open(this->root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (fd < 0)
+      return;
+
+   char path[CGROUP_PATH_MAX] = "/";
+   CGroupTable_scanGroup(this, fd, path, 1, 0);
+}
+
+const TableClass CGroupTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = CGroupTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = CGroupTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
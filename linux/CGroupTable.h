@@ -0,0 +1,33 @@
+#ifndef HEADER_CGroupTable
+#define HEADER_CGroupTable
+/*
+htop - linux/CGroupTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "Machine.h"
+#include "Table.h"
+
+
+/*
+ * One row per cgroup of the unified (v2) hierarchy, read from the
+ * cgroup's own accounting files rather than summed over its tasks.
+ */
+typedef struct CGroupTable_ {
+   Table super;
+
+   char* root;                /* mount point of the unified hierarchy, NULL if none */
+   bool rootSearched;
+} CGroupTable;
+
+extern const TableClass CGroupTable_class;
+
+CGroupTable* CGroupTable_new(Machine* host);
+
+void CGroupTable_done(CGroupTable* this);
+
+#endif
@@ -0,0 +1,245 @@
+/*
+htop - linux/DeviceRow.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/DeviceRow.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+
+#define DEVICE_FIELD(key_) ((int)(key_) - (ROW_DYNAMIC_FIELDS + CGROUP_FIELD_COUNT))
+
+const LinuxDynamicField DeviceRow_fields[DEVICE_FIELD_COUNT] = {
+   [DEVICE_FIELD_READ_RATE] = { .name = "READ_RATE", .heading = "READ/RX", .description = "Bytes read from the disk or received on the interface per second", .width = 11, },
+   [DEVICE_FIELD_WRITE_RATE] = { .name = "WRITE_RATE", .heading = "WRITE/TX", .description = "Bytes written to the disk or sent on the interface per second", .width = 11, },
+   [DEVICE_FIELD_READ_OPS] = { .name = "READ_OPS", .heading = "READS/s", .description = "Read requests completed or packets received per second", .width = 8, },
+   [DEVICE_FIELD_WRITE_OPS] = { .name = "WRITE_OPS", .heading = "WRITES/s", .description = "Write requests completed or packets sent per second", .width = 8, },
+   [DEVICE_FIELD_UTILISATION] = { .name = "UTILISATION", .heading = "UTIL%", .description = "Percentage of time the disk had requests in flight", .width = 5, },
+   [DEVICE_FIELD_QUEUE_DEPTH] = { .name = "QUEUE_DEPTH", .heading = "QUEUE", .description = "Average number of requests in flight on the disk", .width = 6, },
+   [DEVICE_FIELD_TYPE] = { .name = "TYPE", .heading = "TYPE", .description = "Disk, partition or network interface", .width = -9, },
+   [DEVICE_FIELD_NAME] = { .name = "NAME", .heading = "DEVICE", .description = "Name of the block device or network interface", .width = -6, },
+};
+
+static const char* const DeviceRow_kindNames[] = {
+   [IODEVICE_DISK] = "disk",
+   [IODEVICE_PARTITION] = "partition",
+   [IODEVICE_INTERFACE] = "interface",
+};
+
+DeviceRow* DeviceRow_new(const Machine* host, int id) {
+   DeviceRow* this = xCalloc(1, sizeof(DeviceRow));
+   Object_setClass(this, Class(DeviceRow));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+   super->id = id;
+   super->group = id;
+
+   return this;
+}
+
+void DeviceRow_done(DeviceRow* this) {
+   Row_done(&this->super);
+}
+
+static void DeviceRow_delete(Object* cast) {
+   DeviceRow* this = (DeviceRow*) cast;
+   DeviceRow_done(this);
+   free(this);
+}
+
+static void DeviceRow_printOpsRate(double rate, char* buffer, size_t n, int* attr) {
+   if (!isNonnegative(rate)) {
+      *attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "     N/A ");
+      return;
+   }
+
+   if (rate < 0.05)
+      *attr = CRT_colors[PROCESS_SHADOW];
+   xSnprintf(buffer, n, rate < 100000.0 ? "%8.1f " : "%8.0f ", rate);
+}
+
+static void DeviceRow_writeField(const Row* super, RichString* str, RowField field) {
+   const DeviceRow* this = (const DeviceRow*) super;
+   const IODevice* device = &this->device;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   switch (DEVICE_FIELD(field)) {
+   case DEVICE_FIELD_READ_RATE:
+      Row_printRate(str, device->readRate, coloring);
+      return;
+   case DEVICE_FIELD_WRITE_RATE:
+      Row_printRate(str, device->writeRate, coloring);
+      return;
+   case DEVICE_FIELD_READ_OPS:
+      DeviceRow_printOpsRate(device->readOpsRate, buffer, n, &attr);
+      break;
+   case DEVICE_FIELD_WRITE_OPS:
+      DeviceRow_printOpsRate(device->writeOpsRate, buffer, n, &attr);
+      break;
+   case DEVICE_FIELD_UTILISATION:
+      Row_printPercentage((float)device->utilisation, buffer, n, DeviceRow_fields[DEVICE_FIELD_UTILISATION].width, &attr);
+      break;
+   case DEVICE_FIELD_QUEUE_DEPTH:
+      if (isNonnegative(device->queueDepth)) {
+         if (device->queueDepth < 0.005)
+            attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%6.2f ", device->queueDepth);
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "   N/A ");
+      }
+      break;
+   case DEVICE_FIELD_TYPE:
+      xSnprintf(buffer, n, "%-9s ", DeviceRow_kindNames[device->kind]);
+      break;
+   case DEVICE_FIELD_NAME:
+      if (settings->ss->treeView)
+         Row_writeTreeBranches(super, str);
+      RichString_appendWide(str, attr, device->name);
+      return;
+   default:
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static bool DeviceRow_matchesFilter(const Row* super, const Table* table) {
+   const DeviceRow* this = (const DeviceRow*) super;
+   const char* incFilter = table->incFilter;
+
+   return incFilter && !String_contains_i(this->device.name, incFilter, true);
+}
+
+static const char* DeviceRow_sortKeyString(Row* super) {
+   const DeviceRow* this = (const DeviceRow*) super;
+   return this->device.name;
+}
+
+static bool DeviceRow_numericKey(const Row* super, RowField field, uint64_t* result) {
+   const DeviceRow* this = (const DeviceRow*) super;
+   const IODevice* device = &this->device;
+
+   switch (DEVICE_FIELD(field)) {
+   case DEVICE_FIELD_READ_RATE:
+      *result = Row_keyFromReal(device->readRate);
+      return true;
+   case DEVICE_FIELD_WRITE_RATE:
+      *result = Row_keyFromReal(device->writeRate);
+      return true;
+   case DEVICE_FIELD_READ_OPS:
+      *result = Row_keyFromReal(device->readOpsRate);
+      return true;
+   case DEVICE_FIELD_WRITE_OPS:
+      *result = Row_keyFromReal(device->writeOpsRate);
+      return true;
+   case DEVICE_FIELD_UTILISATION:
+      *result = Row_keyFromReal(device->utilisation);
+      return true;
+   case DEVICE_FIELD_QUEUE_DEPTH:
+      *result = Row_keyFromReal(device->queueDepth);
+      return true;
+   case DEVICE_FIELD_TYPE:
+      *result = device->kind;
+      return true;
+   default:
+      return false;
+   }
+}
+
+static bool DeviceRow_machineValue(const Row* super, RowField field, RowValue* value) {
+   const DeviceRow* this = (const DeviceRow*) super;
+   const IODevice* device = &this->device;
+
+   switch (DEVICE_FIELD(field)) {
+   case DEVICE_FIELD_READ_RATE:
+      return Row_valueReal(value, device->readRate);
+   case DEVICE_FIELD_WRITE_RATE:
+      return Row_valueReal(value, device->writeRate);
+   case DEVICE_FIELD_READ_OPS:
+      return Row_valueReal(value, device->readOpsRate);
+   case DEVICE_FIELD_WRITE_OPS:
+      return Row_valueReal(value, device->writeOpsRate);
+   case DEVICE_FIELD_UTILISATION:
+      return Row_valueReal(value, device->utilisation);
+   case DEVICE_FIELD_QUEUE_DEPTH:
+      return Row_valueReal(value, device->queueDepth);
+   default:
+      return false;
+   }
+}
+
+static int DeviceRow_compareByKey(const DeviceRow* d1, const DeviceRow* d2, RowField key) {
+   const IODevice* v1 = &d1->device;
+   const IODevice* v2 = &d2->device;
+
+   switch (DEVICE_FIELD(key)) {
+   case DEVICE_FIELD_READ_RATE:
+      return compareRealNumbers(v1->readRate, v2->readRate);
+   case DEVICE_FIELD_WRITE_RATE:
+      return compareRealNumbers(v1->writeRate, v2->writeRate);
+   case DEVICE_FIELD_READ_OPS:
+      return compareRealNumbers(v1->readOpsRate, v2->readOpsRate);
+   case DEVICE_FIELD_WRITE_OPS:
+      return compareRealNumbers(v1->writeOpsRate, v2->writeOpsRate);
+   case DEVICE_FIELD_UTILISATION:
+      return compareRealNumbers(v1->utilisation, v2->utilisation);
+   case DEVICE_FIELD_QUEUE_DEPTH:
+      return compareRealNumbers(v1->queueDepth, v2->queueDepth);
+   case DEVICE_FIELD_TYPE:
+      return SPACESHIP_NUMBER(v1->kind, v2->kind);
+   case DEVICE_FIELD_NAME:
+      return strcmp(v1->name, v2->name);
+   default:
+      return 0;
+   }
+}
+
+static int DeviceRow_compare(const void* v1, const void* v2) {
+   const DeviceRow* d1 = (const DeviceRow*)v1;
+   const DeviceRow* d2 = (const DeviceRow*)v2;
+   const ScreenSettings* ss = d1->super.host->settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int result = DeviceRow_compareByKey(d1, d2, key);
+
+   // Implement tie-breaker (needed to make tree mode more stable)
+   if (!result)
+      return SPACESHIP_NUMBER(d1->super.id, d2->super.id);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+const RowClass DeviceRow_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = DeviceRow_delete,
+      .compare = DeviceRow_compare,
+   },
+   .writeField = DeviceRow_writeField,
+   .matchesFilter = DeviceRow_matchesFilter,
+   .sortKeyString = DeviceRow_sortKeyString,
+   .numericKey = DeviceRow_numericKey,
+   .machineValue = DeviceRow_machineValue,
+};
@@ -0,0 +1,49 @@
+#ifndef HEADER_DeviceRow
+#define HEADER_DeviceRow
+/*
+htop - linux/DeviceRow.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+#include "Row.h"
+#include "RowField.h"
+
+#include "linux/CGroupRow.h"
+#include "linux/IODevices.h"
+#include "linux/LinuxDynamicScreen.h"
+
+
+/* Columns of the devices screen, following those of the cgroups screen */
+typedef enum DeviceField_ {
+   DEVICE_FIELD_READ_RATE,
+   DEVICE_FIELD_WRITE_RATE,
+   DEVICE_FIELD_READ_OPS,
+   DEVICE_FIELD_WRITE_OPS,
+   DEVICE_FIELD_UTILISATION,
+   DEVICE_FIELD_QUEUE_DEPTH,
+   DEVICE_FIELD_TYPE,
+   DEVICE_FIELD_NAME,
+   DEVICE_FIELD_COUNT
+} DeviceField;
+
+#define DEVICE_ROW_FIELD(f_) ((RowField)(ROW_DYNAMIC_FIELDS + CGROUP_FIELD_COUNT + (f_)))
+
+extern const LinuxDynamicField DeviceRow_fields[DEVICE_FIELD_COUNT];
+
+/* A block device or network interface, as of the last scan */
+typedef struct DeviceRow_ {
+   Row super;
+
+   IODevice device;
+} DeviceRow;
+
+extern const RowClass DeviceRow_class;
+
+DeviceRow* DeviceRow_new(const Machine* host, int id);
+
+void DeviceRow_done(DeviceRow* this);
+
+#endif
@@ -0,0 +1,76 @@
+/*
+htop - linux/DeviceTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/DeviceTable.h"
+
+#include <stdlib.h>
+
+#include "Hashtable.h"
+#include "Object.h"
+#include "Row.h"
+#include "XUtils.h"
+
+#include "linux/DeviceRow.h"
+#include "linux/IODevices.h"
+
+
+DeviceTable* DeviceTable_new(Machine* host) {
+   DeviceTable* this = xCalloc(1, sizeof(DeviceTable));
+   Object_setClass(this, Class(DeviceTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(DeviceRow), host);
+
+   return this;
+}
+
+void DeviceTable_done(DeviceTable* this) {
+   Table_done(&this->super);
+}
+
+static void DeviceTable_delete(Object* cast) {
+   DeviceTable* this = (DeviceTable*) cast;
+   DeviceTable_done(this);
+   free(this);
+}
+
+static void DeviceTable_iterateEntries(Table* super) {
+   const Machine* host = super->host;
+
+   IODevices_update();
+
+   /* the index of a device never changes, so it serves as the row id */
+   for (size_t i = 0; i < IODevices_count(); i++) {
+      const IODevice* device = IODevices_get(i);
+      if (!device->present)
+         continue;
+
+      int id = (int)i + 1;
+      DeviceRow* row = (DeviceRow*) Hashtable_get(super->table, id);
+      if (!row) {
+         row = DeviceRow_new(host, id);
+         Table_add(super, &row->super);
+      }
+
+      row->device = *device;
+      row->super.parent = device->parent + 1;
+      row->super.updated = true;
+      row->super.show = true;
+   }
+}
+
+const TableClass DeviceTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = DeviceTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = DeviceTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
@@ -0,0 +1,28 @@
+#ifndef HEADER_DeviceTable
+#define HEADER_DeviceTable
+/*
+htop - linux/DeviceTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+#include "Table.h"
+
+
+/*
+ * One row per block device of /proc/diskstats and per network interface
+ * of /proc/net/dev, with partitions as children of their disk.
+ */
+typedef struct DeviceTable_ {
+   Table super;
+} DeviceTable;
+
+extern const TableClass DeviceTable_class;
+
+DeviceTable* DeviceTable_new(Machine* host);
+
+void DeviceTable_done(DeviceTable* this);
+
+#endif
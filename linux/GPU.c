@@ -17,9 +17,13 @@ in the source distribution for its full text.
 
 #include "XUtils.h"
 
+#include "linux/BatchReader.h"
 #include "linux/LinuxMachine.h"
 
 
+/* Number of fdinfo files read at once */
+#define GPU_FDINFO_BATCH 16
+
 typedef unsigned long long int ClientID;
 #define INVALID_CLIENT_ID ((ClientID)-1)
 
@@ -74,6 +78,97 @@ static void update_machine_gpu(LinuxProcessTable* lpt, unsigned long long int ti
    lhost->curGpuTime += time;
 }
 
+/* Parse the DRM usage stats of one fdinfo file */
+static void parse_fdinfo(LinuxProcessTable* lpt, char* buffer, ClientInfo** parsed_ids, unsigned long long int* new_gpu_time) {
+   char* pdev = NULL;
+   ClientID client_id = INVALID_CLIENT_ID;
+   enum section_state sstate = SECST_UNKNOWN;
+
+   char* buf = buffer;
+   const char* line;
+   while ((line = strsep(&buf, "\n")) != NULL) {
+      if (!String_startsWith(line, "drm-"))
+         continue;
+      line += strlen("drm-");
+
+      if (line[0] == 'c' && String_startsWith(line, "client-id:")) {
+         if (sstate == SECST_NEW) {
+            assert(client_id != INVALID_CLIENT_ID);
+
+            ClientInfo* new = xMalloc(sizeof(*new));
+            *new = (ClientInfo) {
+               .id = client_id,
+               .pdev = pdev,
+               .next = *parsed_ids,
+            };
+            pdev = NULL;
+
+            *parsed_ids = new;
+         }
+
+         sstate = SECST_UNKNOWN;
+
+         char *endptr;
+         errno = 0;
+         client_id = strtoull(line + strlen("client-id:"), &endptr, 10);
+         if (errno || *endptr != '\0')
+            client_id = INVALID_CLIENT_ID;
+      } else if (line[0] == 'p' && String_startsWith(line, "pdev:")) {
+         const char* p = line + strlen("pdev:");
+
+         while (isspace((unsigned char)*p))
+            p++;
+
+         assert(!pdev || String_eq(pdev, p));
+         if (!pdev)
+            pdev = xStrdup(p);
+      } else if (line[0] == 'e' && String_startsWith(line, "engine-")) {
+         if (sstate == SECST_DUPLICATE)
+            continue;
+
+         const char* engineStart = line + strlen("engine-");
+
+         if (String_startsWith(engineStart, "capacity-"))
+            continue;
+
+         const char* delim = strchr(line, ':');
+
+         char* endptr;
+         errno = 0;
+         unsigned long long int value = strtoull(delim + 1, &endptr, 10);
+         if (errno == 0 && String_startsWith(endptr, " ns")) {
+            if (sstate == SECST_UNKNOWN) {
+               if (client_id != INVALID_CLIENT_ID && !is_duplicate_client(*parsed_ids, client_id, pdev))
+                  sstate = SECST_NEW;
+               else
+                  sstate = SECST_DUPLICATE;
+            }
+
+            if (sstate == SECST_NEW) {
+               *new_gpu_time += value;
+               update_machine_gpu(lpt, value, engineStart, delim - engineStart);
+            }
+         }
+      }
+   } /* finished parsing lines */
+
+   if (sstate == SECST_NEW) {
+      assert(client_id != INVALID_CLIENT_ID);
+
+      ClientInfo* new = xMalloc(sizeof(*new));
+      *new = (ClientInfo) {
+         .id = client_id,
+         .pdev = pdev,
+         .next = *parsed_ids,
+      };
+      pdev = NULL;
+
+      *parsed_ids = new;
+   }
+
+   free(pdev);
+}
+
 /*
  * Documentation reference:
  * https://www.kernel.org/doc/html/latest/gpu/drm-usage-stats.html
@@ -106,113 +201,56 @@ void GPU_readProcessData(LinuxProcessTable* lpt, LinuxProcess* lp, openat_arg_t
    xSnprintf(fdinfoPathBuf, sizeof(fdinfoPathBuf), PROCDIR "/%u/fdinfo", Process_getPid(&lp->super));
 #endif
 
-   while (true) {
-      char* pdev = NULL;
-      ClientID client_id = INVALID_CLIENT_ID;
-      enum section_state sstate = SECST_UNKNOWN;
+   BatchRead reads[GPU_FDINFO_BATCH];
+   char names[GPU_FDINFO_BATCH][16];
+   char buffers[GPU_FDINFO_BATCH][4096];
+   bool done = false;
 
-      const struct dirent* entry = readdir(fdinfoDir);
-      if (!entry)
-         break;
-      const char* ename = entry->d_name;
+   while (!done) {
+      size_t count = 0;
 
-      if (ename[0] == '.' && (ename[1] == '\0' || (ename[1] == '.' && ename[2] == '\0')))
-         continue;
-
-      char buffer[4096];
-#ifdef HAVE_OPENAT
-      ssize_t ret = xReadfileat(dirfd(fdinfoDir), ename, buffer, sizeof(buffer));
-#else
-      ssize_t ret = xReadfileat(fdinfoPathBuf, ename, buffer, sizeof(buffer));
-#endif
-      /* eventfd information can be huge */
-      if (ret <= 0 || (size_t)ret >= sizeof(buffer) - 1)
-         continue;
+      while (count < GPU_FDINFO_BATCH) {
+         const struct dirent* entry = readdir(fdinfoDir);
+         if (!entry) {
+            done = true;
+            break;
+         }
+         const char* ename = entry->d_name;
 
-      char* buf = buffer;
-      const char* line;
-      while ((line = strsep(&buf, "\n")) != NULL) {
-         if (!String_startsWith(line, "drm-"))
+         if (ename[0] == '.' && (ename[1] == '\0' || (ename[1] == '.' && ename[2] == '\0')))
             continue;
-         line += strlen("drm-");
-
-         if (line[0] == 'c' && String_startsWith(line, "client-id:")) {
-            if (sstate == SECST_NEW) {
-               assert(client_id != INVALID_CLIENT_ID);
-
-               ClientInfo* new = xMalloc(sizeof(*new));
-               *new = (ClientInfo) {
-                  .id = client_id,
-                  .pdev = pdev,
-                  .next = parsed_ids,
-               };
-               pdev = NULL;
 
-               parsed_ids = new;
-            }
+         /* Entries are file descriptor numbers */
+         if (strlen(ename) >= sizeof(names[count]))
+            continue;
+         String_safeStrncpy(names[count], ename, sizeof(names[count]));
 
-            sstate = SECST_UNKNOWN;
-
-            char *endptr;
-            errno = 0;
-            client_id = strtoull(line + strlen("client-id:"), &endptr, 10);
-            if (errno || *endptr != '\0')
-               client_id = INVALID_CLIENT_ID;
-         } else if (line[0] == 'p' && String_startsWith(line, "pdev:")) {
-            const char* p = line + strlen("pdev:");
-
-            while (isspace((unsigned char)*p))
-               p++;
-
-            assert(!pdev || String_eq(pdev, p));
-            if (!pdev)
-               pdev = xStrdup(p);
-         } else if (line[0] == 'e' && String_startsWith(line, "engine-")) {
-            if (sstate == SECST_DUPLICATE)
-               continue;
-
-            const char* engineStart = line + strlen("engine-");
-
-            if (String_startsWith(engineStart, "capacity-"))
-               continue;
-
-            const char* delim = strchr(line, ':');
-
-            char* endptr;
-            errno = 0;
-            unsigned long long int value = strtoull(delim + 1, &endptr, 10);
-            if (errno == 0 && String_startsWith(endptr, " ns")) {
-               if (sstate == SECST_UNKNOWN) {
-                  if (client_id != INVALID_CLIENT_ID && !is_duplicate_client(parsed_ids, client_id, pdev))
-                     sstate = SECST_NEW;
-                  else
-                     sstate = SECST_DUPLICATE;
-               }
-
-               if (sstate == SECST_NEW) {
-                  new_gpu_time += value;
-                  update_machine_gpu(lpt, value, engineStart, delim - engineStart);
-               }
-            }
-         }
-      } /* finished parsing lines */
+         reads[count] = (BatchRead) {
+#ifdef HAVE_OPENAT
+            .dir = dirfd(fdinfoDir),
+#else
+            .dir = fdinfoPathBuf,
+#endif
+            .path = names[count],
+            .fd = -1,
+            .buffer = buffers[count],
+            .size = sizeof(buffers[count]),
+            .result = -EINVAL,
+         };
+         count++;
+      }
 
-      if (sstate == SECST_NEW) {
-         assert(client_id != INVALID_CLIENT_ID);
+      BatchReader_run(lpt->batchReader, reads, count);
 
-         ClientInfo* new = xMalloc(sizeof(*new));
-         *new = (ClientInfo) {
-            .id = client_id,
-            .pdev = pdev,
-            .next = parsed_ids,
-         };
-         pdev = NULL;
+      for (size_t i = 0; i < count; i++) {
+         ssize_t ret = reads[i].result;
+         /* eventfd information can be huge */
+         if (ret <= 0 || (size_t)ret >= reads[i].size - 1)
+            continue;
 
-         parsed_ids = new;
+         parse_fdinfo(lpt, reads[i].buffer, &parsed_ids, &new_gpu_time);
       }
-
-      free(pdev);
-   } /* finished parsing fdinfo entries */
+   }
 
    if (new_gpu_time > 0) {
       unsigned long long int gputimeDelta;
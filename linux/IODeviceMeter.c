@@ -0,0 +1,320 @@
+/*
+htop - linux/IODeviceMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/IODeviceMeter.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "RichString.h"
+#include "Row.h"
+#include "XUtils.h"
+
+#include "linux/IODevices.h"
+
+
+typedef struct IODevicesMeterData_ {
+   size_t count;
+   Meter** meters;            /* one per device, the device index as param */
+} IODevicesMeterData;
+
+static const int DiskIODeviceMeter_attributes[] = {
+   METER_VALUE_NOTICE,
+};
+
+static const int NetworkIODeviceMeter_attributes[] = {
+   METER_VALUE_IOREAD,
+   METER_VALUE_IOWRITE,
+};
+
+/* Rows of a single device, only created by the meters listing them */
+
+static void DiskIODeviceMeter_updateValues(Meter* this) {
+   const IODevice* device = IODevices_get(this->param);
+
+   this->values[0] = 0.0;
+   if (!device->present) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
+      return;
+   }
+   if (isnan(device->readRate)) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "init");
+      return;
+   }
+
+   char readStr[6];
+   char writeStr[6];
+   Meter_humanUnit(readStr, device->readRate / ONE_K, sizeof(readStr));
+   Meter_humanUnit(writeStr, device->writeRate / ONE_K, sizeof(writeStr));
+
+   this->values[0] = device->utilisation;
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "r:%siB/s w:%siB/s %.1f%%", readStr, writeStr, device->utilisation);
+}
+
+static void DiskIODeviceMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*) cast;
+   const IODevice* device = IODevices_get(this->param);
+
+   if (!device->present) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
+      return;
+   }
+   if (isnan(device->readRate)) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE], "initializing...");
+      return;
+   }
+
+   char buffer[16];
+
+   int color = device->utilisation > 40.0 ? METER_VALUE_NOTICE : METER_VALUE;
+   int len = xSnprintf(buffer, sizeof(buffer), "%.1f%%", device->utilisation);
+   RichString_appendnAscii(out, CRT_colors[color], buffer, len);
+
+   Meter_humanUnit(buffer, device->readRate / ONE_K, 6);
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], " read: ");
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], "iB/s");
+
+   Meter_humanUnit(buffer, device->writeRate / ONE_K, 6);
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], " write: ");
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], "iB/s");
+
+   len = xSnprintf(buffer, sizeof(buffer), " queue: %.2f", device->queueDepth);
+   RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
+}
+
+static const MeterClass DiskIODeviceMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = DiskIODeviceMeter_display
+   },
+   .updateValues = DiskIODeviceMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .maxItems = 1,
+   .total = 100.0,
+   .attributes = DiskIODeviceMeter_attributes,
+   .name = "DiskIODevice",
+   .uiName = "Disk IO of a device",
+   .caption = "Disk IO: "
+};
+
+static void NetworkIODeviceMeter_updateValues(Meter* this) {
+   const IODevice* device = IODevices_get(this->param);
+
+   this->values[0] = 0.0;
+   this->values[1] = 0.0;
+   if (!device->present) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
+      return;
+   }
+   if (isnan(device->readRate)) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "init");
+      return;
+   }
+
+   char rxStr[6];
+   char txStr[6];
+   Meter_humanUnit(rxStr, device->readRate / ONE_K, sizeof(rxStr));
+   Meter_humanUnit(txStr, device->writeRate / ONE_K, sizeof(txStr));
+
+   this->values[0] = device->readRate;
+   this->values[1] = device->writeRate;
+   if (device->readRate + device->writeRate > this->total)
+      this->total = device->readRate + device->writeRate;
+
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "rx:%siB/s tx:%siB/s %.0f/%.0fpkts/s",
+      rxStr, txStr, device->readOpsRate, device->writeOpsRate);
+}
+
+static void NetworkIODeviceMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*) cast;
+   const IODevice* device = IODevices_get(this->param);
+
+   if (!device->present) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
+      return;
+   }
+   if (isnan(device->readRate)) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE], "initializing...");
+      return;
+   }
+
+   char buffer[64];
+
+   Meter_humanUnit(buffer, device->readRate / ONE_K, 6);
+   RichString_writeAscii(out, CRT_colors[METER_TEXT], "rx: ");
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], "iB/s");
+
+   Meter_humanUnit(buffer, device->writeRate / ONE_K, 6);
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], " tx: ");
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], "iB/s");
+
+   int len = xSnprintf(buffer, sizeof(buffer), " (%.0f/%.0f pkts/s) ", device->readOpsRate, device->writeOpsRate);
+   RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
+}
+
+static const MeterClass NetworkIODeviceMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = NetworkIODeviceMeter_display
+   },
+   .updateValues = NetworkIODeviceMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .maxItems = 2,
+   .total = 100.0,
+   .attributes = NetworkIODeviceMeter_attributes,
+   .name = "NetworkIODevice",
+   .uiName = "Network IO of an interface",
+   .caption = "Network: "
+};
+
+/* The meters listing the devices, one row each */
+
+static bool IODevicesMeter_lists(const Meter* this, const IODevice* device) {
+   if (!device->present || !device->counted)
+      return false;
+
+   if (As_Meter(this) == &NetworkIODevicesMeter_class)
+      return device->kind == IODEVICE_INTERFACE;
+
+   return device->kind == IODEVICE_DISK;
+}
+
+/*
+ * The rows are the devices present when the meter gets created, devices
+ * plugged in later show up once it is added again or htop restarts.
+ */
+static void IODevicesMeter_init(Meter* this) {
+   if (this->meterData)
+      return;
+
+   IODevicesMeterData* data = this->meterData = xCalloc(1, sizeof(IODevicesMeterData));
+   const MeterClass* rowClass = As_Meter(this) == &NetworkIODevicesMeter_class ? &NetworkIODeviceMeter_class : &DiskIODeviceMeter_class;
+
+   IODevices_update();
+
+   size_t nameLen = 0;
+   for (size_t i = 0; i < IODevices_count(); i++) {
+      const IODevice* device = IODevices_get(i);
+      if (IODevicesMeter_lists(this, device)) {
+         data->count++;
+         nameLen = MAXIMUM(nameLen, strlen(device->name));
+      }
+   }
+
+   data->meters = data->count ? xCalloc(data->count, sizeof(Meter*)) : NULL;
+
+   /* captions padded to the longest name, so the values line up */
+   size_t n = 0;
+   for (size_t i = 0; i < IODevices_count() && n < data->count; i++) {
+      const IODevice* device = IODevices_get(i);
+      if (!IODevicesMeter_lists(this, device))
+         continue;
+
+      char caption[IODEVICE_NAME_LEN + 2];
+      xSnprintf(caption, sizeof(caption), "%s:%*s", device->name, (int)(nameLen - strlen(device->name) + 1), "");
+      data->meters[n] = Meter_new(this->host, (unsigned int)i, rowClass);
+      Meter_setCaption(data->meters[n], caption);
+      n++;
+   }
+}
+
+static void IODevicesMeter_updateMode(Meter* this, MeterModeId mode) {
+   IODevicesMeterData* data = this->meterData;
+   this->mode = mode;
+   if (!data->count) {
+      this->h = 1;
+      return;
+   }
+
+   for (size_t i = 0; i < data->count; i++)
+      Meter_setMode(data->meters[i], mode);
+
+   this->h = data->meters[0]->h * (int)data->count;
+}
+
+static void IODevicesMeter_updateValues(Meter* this) {
+   IODevicesMeterData* data = this->meterData;
+
+   IODevices_update();
+   for (size_t i = 0; i < data->count; i++)
+      Meter_updateValues(data->meters[i]);
+}
+
+static void IODevicesMeter_draw(Meter* this, int x, int y, int w) {
+   IODevicesMeterData* data = this->meterData;
+
+   for (size_t i = 0; i < data->count; i++) {
+      Meter* meter = data->meters[i];
+      meter->draw(meter, x, y, w);
+      y += meter->h;
+   }
+}
+
+static void IODevicesMeter_done(Meter* this) {
+   IODevicesMeterData* data = this->meterData;
+
+   for (size_t i = 0; i < data->count; i++)
+      Meter_delete((Object*)data->meters[i]);
+   free(data->meters);
+   free(data);
+}
+
+const MeterClass DiskIODevicesMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+   },
+   .updateValues = IODevicesMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .total = 100.0,
+   .attributes = DiskIODeviceMeter_attributes,
+   .name = "DiskIODevices",
+   .uiName = "Disk IO per device",
+   .description = "Disk IO per device: throughput, utilisation and queue depth of each disk",
+   .caption = "Disk IO: ",
+   .draw = IODevicesMeter_draw,
+   .init = IODevicesMeter_init,
+   .updateMode = IODevicesMeter_updateMode,
+   .done = IODevicesMeter_done
+};
+
+const MeterClass NetworkIODevicesMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+   },
+   .updateValues = IODevicesMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .total = 100.0,
+   .attributes = NetworkIODeviceMeter_attributes,
+   .name = "NetworkIODevices",
+   .uiName = "Network IO per interface",
+   .description = "Network IO per interface: throughput and packets of each interface but loopback",
+   .caption = "Network: ",
+   .draw = IODevicesMeter_draw,
+   .init = IODevicesMeter_init,
+   .updateMode = IODevicesMeter_updateMode,
+   .done = IODevicesMeter_done
+};
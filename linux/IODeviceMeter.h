@@ -0,0 +1,18 @@
+#ifndef HEADER_IODeviceMeter
+#define HEADER_IODeviceMeter
+/*
+htop - linux/IODeviceMeter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+/* One row per disk, and one per network interface but loopback */
+extern const MeterClass DiskIODevicesMeter_class;
+
+extern const MeterClass NetworkIODevicesMeter_class;
+
+#endif
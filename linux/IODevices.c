@@ -0,0 +1,339 @@
+/*
+htop - linux/IODevices.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/IODevices.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/Platform.h"
+#include "linux/ProcTokenizer.h"
+
+
+/* Sectors of /proc/diskstats are always 512 bytes, whatever the device uses */
+#define IODEVICES_SECTOR_SIZE 512
+
+/* Counters read from a line, in the order of /proc/diskstats */
+enum {
+   DISKSTAT_READS,
+   DISKSTAT_READS_MERGED,
+   DISKSTAT_SECTORS_READ,
+   DISKSTAT_READ_MS,
+   DISKSTAT_WRITES,
+   DISKSTAT_WRITES_MERGED,
+   DISKSTAT_SECTORS_WRITTEN,
+   DISKSTAT_WRITE_MS,
+   DISKSTAT_IN_FLIGHT,
+   DISKSTAT_BUSY_MS,
+   DISKSTAT_QUEUE_MS,
+   DISKSTAT_COUNT
+};
+
+/* Counters read from a line, in the order of /proc/net/dev */
+enum {
+   NETDEV_RX_BYTES,
+   NETDEV_RX_PACKETS,
+   NETDEV_TX_BYTES = 8,
+   NETDEV_TX_PACKETS,
+   NETDEV_COUNT
+};
+
+static struct {
+   IODevice* devices;
+   size_t count;
+   size_t size;
+   size_t hint;               /* index after the previous match, the kernel keeps its order */
+
+   char* buffer;              /* kept over reads, grown to the largest file */
+   size_t bufferSize;
+   int diskFd;
+   int netFd;
+
+   uint64_t lastReadMs;
+   unsigned int lastResult;
+} IODevices_state = {
+   .diskFd = -1,
+   .netFd = -1,
+};
+
+size_t IODevices_count(void) {
+   return IODevices_state.count;
+}
+
+const IODevice* IODevices_get(size_t index) {
+   assert(index < IODevices_state.count);
+   return &IODevices_state.devices[index];
+}
+
+void IODevices_done(void) {
+   if (IODevices_state.diskFd >= 0)
+      close(IODevices_state.diskFd);
+   if (IODevices_state.netFd >= 0)
+      close(IODevices_state.netFd);
+
+   free(IODevices_state.devices);
+   free(IODevices_state.buffer);
+   memset(&IODevices_state, 0, sizeof(IODevices_state));
+   IODevices_state.diskFd = -1;
+   IODevices_state.netFd = -1;
+}
+
+/* Read a whole procfs file through a descriptor kept open; returns its length or -1 */
+static ssize_t IODevices_readFile(int* fd, const char* path) {
+   if (*fd < 0) {
+      *fd = open(path, O_RDONLY | O_CLOEXEC);
+      if (*fd < 0)
+         return -1;
+   }
+
+   if (!IODevices_state.buffer) {
+      IODevices_state.bufferSize = 8192;
+      IODevices_state.buffer = xMalloc(IODevices_state.bufferSize);
+   }
+
+   for (;;) {
+      ssize_t len = xPreadfile(*fd, IODevices_state.buffer, IODevices_state.bufferSize);
+      if (len < 0) {
+         close(*fd);
+         *fd = -1;
+         return -1;
+      }
+
+      /* a full buffer may have cut the file short */
+      if ((size_t)len < IODevices_state.bufferSize - 1)
+         return len;
+
+      IODevices_state.bufferSize *= 2;
+      IODevices_state.buffer = xRealloc(IODevices_state.buffer, IODevices_state.bufferSize);
+   }
+}
+
+static IODevice* IODevices_find(const char* name, size_t nameLen, bool interface) {
+   size_t count = IODevices_state.count;
+   nameLen = MINIMUM(nameLen, IODEVICE_NAME_LEN - 1);
+
+   for (size_t n = 0; n < count; n++) {
+      size_t i = (IODevices_state.hint + n) % count;
+      IODevice* device = &IODevices_state.devices[i];
+      if ((device->kind == IODEVICE_INTERFACE) == interface &&
+          strncmp(device->name, name, nameLen) == 0 && device->name[nameLen] == '\0') {
+         IODevices_state.hint = i + 1;
+         return device;
+      }
+   }
+
+   if (count == IODevices_state.size) {
+      IODevices_state.size = count ? count * 2 : 16;
+      IODevices_state.devices = xReallocArray(IODevices_state.devices, IODevices_state.size, sizeof(IODevice));
+   }
+
+   IODevice* device = &IODevices_state.devices[count];
+   memset(device, 0, sizeof(IODevice));
+   memcpy(device->name, name, nameLen);
+   device->name[nameLen] = '\0';
+   device->kind = interface ? IODEVICE_INTERFACE : IODEVICE_DISK;
+   device->parent = -1;
+   device->readRate = NAN;
+   device->writeRate = NAN;
+   device->readOpsRate = NAN;
+   device->writeOpsRate = NAN;
+   device->utilisation = NAN;
+   device->queueDepth = NAN;
+
+   IODevices_state.count = count + 1;
+   IODevices_state.hint = count + 1;
+   return device;
+}
+
+static inline const char* IODevices_skipBlanks(const char* p, const char* end) {
+   while (p < end && (*p == ' ' || *p == '\t'))
+      p++;
+   return p;
+}
+
+/* Parse up to max blank separated numbers from p, returning how many were found */
+static size_t IODevices_parseNumbers(const char* p, const char* end, uint64_t* values, size_t max) {
+   size_t n = 0;
+
+   while (n < max) {
+      p = IODevices_skipBlanks(p, end);
+      if (p == end || *p < '0' || *p > '9')
+         break;
+
+      size_t used;
+      values[n++] = ProcTokenizer_parseDec(p, (size_t)(end - p), &used);
+      p += used;
+   }
+
+   return n;
+}
+
+static void IODevices_sample(IODevice* device, uint64_t readBytes, uint64_t writeBytes, uint64_t readOps, uint64_t writeOps, uint64_t now) {
+   uint64_t timeDelta = device->sampleMs ? saturatingSub(now, device->sampleMs) : 0;
+
+   if (timeDelta) {
+      device->readRate = saturatingSub(readBytes, device->readBytes) * /*ms to s*/1000. / timeDelta;
+      device->writeRate = saturatingSub(writeBytes, device->writeBytes) * /*ms to s*/1000. / timeDelta;
+      device->readOpsRate = saturatingSub(readOps, device->readOps) * /*ms to s*/1000. / timeDelta;
+      device->writeOpsRate = saturatingSub(writeOps, device->writeOps) * /*ms to s*/1000. / timeDelta;
+   }
+
+   device->readBytes = readBytes;
+   device->writeBytes = writeBytes;
+   device->readOps = readOps;
+   device->writeOps = writeOps;
+   device->present = true;
+}
+
+static bool IODevices_readDisks(uint64_t now) {
+   ssize_t len = IODevices_readFile(&IODevices_state.diskFd, PROCDIR "/diskstats");
+   if (len < 0)
+      return false;
+
+   for (size_t i = 0; i < IODevices_state.count; i++) {
+      if (IODevices_state.devices[i].kind != IODEVICE_INTERFACE)
+         IODevices_state.devices[i].present = false;
+   }
+
+   const char* end = IODevices_state.buffer + len;
+   const char* lastTopDisk = NULL;
+   size_t lastTopDiskLen = 0;
+   int lastTopDiskIndex = -1;
+
+   for (const char* line = IODevices_state.buffer; line < end; ) {
+      const char* eol = memchr(line, '\n', (size_t)(end - line));
+      if (!eol)
+         eol = end;
+
+      /* major and minor number, then the name */
+      uint64_t numbers[DISKSTAT_COUNT];
+      const char* p = line;
+      for (int i = 0; i < 2; i++) {
+         p = IODevices_skipBlanks(p, eol);
+         while (p < eol && *p != ' ' && *p != '\t')
+            p++;
+      }
+      const char* name = IODevices_skipBlanks(p, eol);
+      p = name;
+      while (p < eol && *p != ' ' && *p != '\t')
+         p++;
+      size_t nameLen = (size_t)(p - name);
+
+      size_t found = IODevices_parseNumbers(p, eol, numbers, DISKSTAT_COUNT);
+      line = eol + 1;
+      if (nameLen == 0 || found < DISKSTAT_BUSY_MS + 1)
+         continue;
+      if (found < DISKSTAT_COUNT)
+         numbers[DISKSTAT_QUEUE_MS] = 0;
+
+      IODevice* device = IODevices_find(name, nameLen, false);
+      device->kind = IODEVICE_DISK;
+      device->parent = -1;
+      device->counted = false;
+
+      if (String_startsWith(device->name, "dm-") || String_startsWith(device->name, "zram")) {
+         /* neither a disk of its own nor a partition for the totals */
+      } else if (lastTopDisk && nameLen > lastTopDiskLen && memcmp(name, lastTopDisk, lastTopDiskLen) == 0) {
+         /* This assumes disks are listed directly before any of their partitions */
+         device->kind = IODEVICE_PARTITION;
+         device->parent = lastTopDiskIndex;
+      } else {
+         device->counted = true;
+         lastTopDisk = name;
+         lastTopDiskLen = nameLen;
+         lastTopDiskIndex = (int)(device - IODevices_state.devices);
+      }
+
+      uint64_t timeDelta = device->sampleMs ? saturatingSub(now, device->sampleMs) : 0;
+      if (timeDelta) {
+         device->utilisation = MINIMUM(100.0, saturatingSub(numbers[DISKSTAT_BUSY_MS], device->busyMs) * 100. / timeDelta);
+         device->queueDepth = saturatingSub(numbers[DISKSTAT_QUEUE_MS], device->queueMs) / (double)timeDelta;
+      }
+
+      IODevices_sample(device,
+                       numbers[DISKSTAT_SECTORS_READ] * IODEVICES_SECTOR_SIZE,
+                       numbers[DISKSTAT_SECTORS_WRITTEN] * IODEVICES_SECTOR_SIZE,
+                       numbers[DISKSTAT_READS],
+                       numbers[DISKSTAT_WRITES],
+                       now);
+      device->busyMs = numbers[DISKSTAT_BUSY_MS];
+      device->queueMs = numbers[DISKSTAT_QUEUE_MS];
+      device->sampleMs = now;
+   }
+
+   return true;
+}
+
+static bool IODevices_readInterfaces(uint64_t now) {
+   ssize_t len = IODevices_readFile(&IODevices_state.netFd, PROCDIR "/net/dev");
+   if (len < 0)
+      return false;
+
+   for (size_t i = 0; i < IODevices_state.count; i++) {
+      if (IODevices_state.devices[i].kind == IODEVICE_INTERFACE)
+         IODevices_state.devices[i].present = false;
+   }
+
+   const char* end = IODevices_state.buffer + len;
+
+   /* the two heading lines have no colon */
+   for (const char* line = IODevices_state.buffer; line < end; ) {
+      const char* eol = memchr(line, '\n', (size_t)(end - line));
+      if (!eol)
+         eol = end;
+
+      const char* name = IODevices_skipBlanks(line, eol);
+      const char* colon = memchr(name, ':', (size_t)(eol - name));
+      uint64_t numbers[NETDEV_COUNT];
+      size_t found = colon ? IODevices_parseNumbers(colon + 1, eol, numbers, NETDEV_COUNT) : 0;
+      line = eol + 1;
+      if (found < NETDEV_COUNT || colon == name)
+         continue;
+
+      size_t nameLen = (size_t)(colon - name);
+      IODevice* device = IODevices_find(name, nameLen, true);
+      device->counted = !String_eq(device->name, "lo");
+
+      IODevices_sample(device,
+                       numbers[NETDEV_RX_BYTES],
+                       numbers[NETDEV_TX_BYTES],
+                       numbers[NETDEV_RX_PACKETS],
+                       numbers[NETDEV_TX_PACKETS],
+                       now);
+      device->sampleMs = now;
+   }
+
+   return true;
+}
+
+unsigned int IODevices_update(void) {
+   uint64_t monotonicMs;
+   Platform_gettime_monotonic(&monotonicMs);
+
+   if (IODevices_state.lastReadMs && monotonicMs - IODevices_state.lastReadMs < IODEVICES_MIN_INTERVAL_MS)
+      return IODevices_state.lastResult;
+
+   unsigned int result = 0;
+   if (IODevices_readDisks(monotonicMs))
+      result |= IODEVICES_DISKS;
+   if (IODevices_readInterfaces(monotonicMs))
+      result |= IODEVICES_INTERFACES;
+
+   IODevices_state.lastReadMs = monotonicMs;
+   IODevices_state.lastResult = result;
+   return result;
+}
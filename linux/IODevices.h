@@ -0,0 +1,72 @@
+#ifndef HEADER_IODevices
+#define HEADER_IODevices
+/*
+htop - linux/IODevices.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+#define IODEVICE_NAME_LEN 32
+
+typedef enum IODeviceKind_ {
+   IODEVICE_DISK,
+   IODEVICE_PARTITION,        /* or any other block device listed after its disk */
+   IODEVICE_INTERFACE,
+} IODeviceKind;
+
+/*
+ * A block device of /proc/diskstats or a network interface of
+ * /proc/net/dev. For interfaces, reads are what was received and writes
+ * what was transmitted, counted in packets instead of operations.
+ */
+typedef struct IODevice_ {
+   char name[IODEVICE_NAME_LEN];
+   IODeviceKind kind;
+   bool present;              /* listed by the last read */
+   bool counted;              /* part of the totals of Platform_getDiskIO and Platform_getNetworkIO */
+   int parent;                /* index of the disk of a partition, -1 for none */
+
+   uint64_t readBytes;
+   uint64_t writeBytes;
+   uint64_t readOps;
+   uint64_t writeOps;
+   uint64_t busyMs;           /* time with requests in flight */
+   uint64_t queueMs;          /* time requests spent in flight, summed over the requests */
+   uint64_t sampleMs;         /* monotonic time of the previous read, 0 for none */
+
+   /* per second over the time since the previous read, NAN after the first one */
+   double readRate;
+   double writeRate;
+   double readOpsRate;
+   double writeOpsRate;
+   double utilisation;        /* percentage of the time busy, NAN for interfaces */
+   double queueDepth;         /* average number of requests in flight, NAN for interfaces */
+} IODevice;
+
+/* Which of the statistics files could be read */
+#define IODEVICES_DISKS      0x1
+#define IODEVICES_INTERFACES 0x2
+
+#define IODEVICES_MIN_INTERVAL_MS 100
+
+/*
+ * Re-read the statistics of all devices, unless they were read less than
+ * IODEVICES_MIN_INTERVAL_MS before, so the meters and the devices screen
+ * share a refresh. Returns a mask of IODEVICES_DISKS and IODEVICES_INTERFACES.
+ */
+unsigned int IODevices_update(void);
+
+/* Devices keep their index for the lifetime of htop, even when gone */
+size_t IODevices_count(void);
+
+const IODevice* IODevices_get(size_t index);
+
+void IODevices_done(void);
+
+#endif
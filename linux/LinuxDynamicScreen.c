@@ -0,0 +1,197 @@
+/*
+htop - linux/LinuxDynamicScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/LinuxDynamicScreen.h"
+
+#include <stdlib.h>
+
+#include "DynamicColumn.h"
+#include "DynamicScreen.h"
+#include "ListItem.h"
+#include "Macros.h"
+#include "Object.h"
+#include "RowField.h"
+#include "Table.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/CGroupRow.h"
+#include "linux/CGroupTable.h"
+#include "linux/DeviceRow.h"
+#include "linux/DeviceTable.h"
+
+
+typedef struct LinuxDynamicScreenData_ {
+   const char* name;          /* unique, as in the .dynamic setting */
+   const char* heading;       /* default name of the screen tab */
+   const char* caption;
+   const LinuxDynamicField* fields;
+   unsigned int fieldCount;
+   RowField firstKey;         /* key of fields[0], the default sort key */
+   Table* (*newTable)(Machine* host);
+} LinuxDynamicScreenData;
+
+static Table* newCGroupTable(Machine* host) {
+   return (Table*) CGroupTable_new(host);
+}
+
+static Table* newDeviceTable(Machine* host) {
+   return (Table*) DeviceTable_new(host);
+}
+
+static const LinuxDynamicScreenData LinuxDynamicScreen_data[] = {
+   {
+      .name = "cgroups",
+      .heading = "Cgroups",
+      .caption = "Resource usage per control group",
+      .fields = CGroupRow_fields,
+      .fieldCount = CGROUP_FIELD_COUNT,
+      .firstKey = CGROUP_ROW_FIELD(0),
+      .newTable = newCGroupTable,
+   },
+   {
+      .name = "devices",
+      .heading = "Devices",
+      .caption = "Throughput per block device and network interface",
+      .fields = DeviceRow_fields,
+      .fieldCount = DEVICE_FIELD_COUNT,
+      .firstKey = DEVICE_ROW_FIELD(0),
+      .newTable = newDeviceTable,
+   },
+};
+
+static Hashtable* LinuxDynamicScreen_columns;
+static Table* LinuxDynamicScreen_tables[ARRAYSIZE(LinuxDynamicScreen_data)];
+
+Hashtable* LinuxDynamicColumns_new(void) {
+   Hashtable* columns = Hashtable_new(0, true);
+
+   for (size_t i = 0; i < ARRAYSIZE(LinuxDynamicScreen_data); i++) {
+      const LinuxDynamicScreenData* data = &LinuxDynamicScreen_data[i];
+      for (unsigned int j = 0; j < data->fieldCount; j++) {
+         const LinuxDynamicField* field = &data->fields[j];
+         DynamicColumn* column = xCalloc(1, sizeof(DynamicColumn));
+         xSnprintf(column->name, sizeof(column->name), "%s:%s", data->name, field->name);
+         column->heading = xStrdup(field->heading);
+         column->caption = xStrdup(field->heading);
+         column->description = xStrdup(field->description);
+         column->width = field->width;
+         column->enabled = true;
+         Hashtable_put(columns, data->firstKey + j, column);
+      }
+   }
+
+   LinuxDynamicScreen_columns = columns;
+   return columns;
+}
+
+static void LinuxDynamicColumns_free(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   DynamicColumn* column = (DynamicColumn*) value;
+   DynamicColumn_done(column);
+}
+
+void LinuxDynamicColumns_done(Hashtable* columns) {
+   Hashtable_foreach(columns, LinuxDynamicColumns_free, NULL);
+   if (columns == LinuxDynamicScreen_columns)
+      LinuxDynamicScreen_columns = NULL;
+}
+
+const char* LinuxDynamicColumn_name(unsigned int key) {
+   const DynamicColumn* column = Hashtable_get(LinuxDynamicScreen_columns, key);
+   if (!column)
+      return NULL;
+   if (column->caption)
+      return column->caption;
+   return column->heading ? column->heading : column->name;
+}
+
+Hashtable* LinuxDynamicScreens_new(void) {
+   Hashtable* screens = Hashtable_new(0, true);
+
+   for (size_t i = 0; i < ARRAYSIZE(LinuxDynamicScreen_data); i++) {
+      const LinuxDynamicScreenData* data = &LinuxDynamicScreen_data[i];
+      DynamicScreen* screen = xCalloc(1, sizeof(DynamicScreen));
+      xSnprintf(screen->name, sizeof(screen->name), "%s", data->name);
+      screen->heading = xStrdup(data->heading);
+      screen->caption = xStrdup(data->caption);
+      screen->direction = -1;
+
+      /* the first column is the default sort key, see Settings_newDynamicScreen */
+      char* columnKeys = xStrdup("");
+      for (unsigned int j = 0; j < data->fieldCount; j++) {
+         char* prefix = columnKeys;
+         xAsprintf(&columnKeys, "%s%sDynamic(%s:%s)", prefix, j ? " " : "", data->name, data->fields[j].name);
+         free(prefix);
+      }
+      screen->columnKeys = columnKeys;
+
+      Hashtable_put(screens, i, screen);
+   }
+
+   return screens;
+}
+
+static void LinuxDynamicScreens_free(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   DynamicScreen* screen = (DynamicScreen*) value;
+   DynamicScreen_done(screen);
+}
+
+void LinuxDynamicScreens_done(Hashtable* screens) {
+   Hashtable_foreach(screens, LinuxDynamicScreens_free, NULL);
+
+   for (size_t i = 0; i < ARRAYSIZE(LinuxDynamicScreen_tables); i++) {
+      if (LinuxDynamicScreen_tables[i]) {
+         Object_delete(LinuxDynamicScreen_tables[i]);
+         LinuxDynamicScreen_tables[i] = NULL;
+      }
+   }
+}
+
+void LinuxDynamicScreens_appendTables(Machine* host) {
+   for (size_t i = 0; i < ARRAYSIZE(LinuxDynamicScreen_data); i++) {
+      const LinuxDynamicScreenData* data = &LinuxDynamicScreen_data[i];
+      if (LinuxDynamicScreen_tables[i])
+         continue;
+
+      Table* table = data->newTable(host);
+      LinuxDynamicScreen_tables[i] = table;
+
+      if (!LinuxDynamicScreen_columns)
+         continue;
+      for (unsigned int j = 0; j < data->fieldCount; j++) {
+         DynamicColumn* column = Hashtable_get(LinuxDynamicScreen_columns, data->firstKey + j);
+         if (column)
+            column->table = table;
+      }
+   }
+}
+
+void LinuxDynamicScreen_addDynamicScreen(ScreenSettings* ss) {
+   for (size_t i = 0; i < ARRAYSIZE(LinuxDynamicScreen_data); i++) {
+      if (String_eq(ss->dynamic, LinuxDynamicScreen_data[i].name))
+         ss->table = LinuxDynamicScreen_tables[i];
+   }
+}
+
+void LinuxDynamicScreens_addAvailableColumns(Panel* availableColumns, const char* screen) {
+   Vector_prune(availableColumns->items);
+
+   for (size_t i = 0; i < ARRAYSIZE(LinuxDynamicScreen_data); i++) {
+      const LinuxDynamicScreenData* data = &LinuxDynamicScreen_data[i];
+      if (!String_eq(screen, data->name))
+         continue;
+
+      for (unsigned int j = 0; j < data->fieldCount; j++) {
+         const LinuxDynamicField* field = &data->fields[j];
+         char description[256];
+         xSnprintf(description, sizeof(description), "%s - %s", field->heading, field->description);
+         Panel_add(availableColumns, (Object*) ListItem_new(description, data->firstKey + j));
+      }
+   }
+}
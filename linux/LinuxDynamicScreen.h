@@ -0,0 +1,42 @@
+#ifndef HEADER_LinuxDynamicScreen
+#define HEADER_LinuxDynamicScreen
+/*
+htop - linux/LinuxDynamicScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Hashtable.h"
+#include "Machine.h"
+#include "Panel.h"
+#include "Settings.h"
+
+
+/* A column of a built-in screen listing something else than processes */
+typedef struct LinuxDynamicField_ {
+   const char* name;          /* internal name, as in the configuration file */
+   const char* heading;
+   const char* description;
+   int width;                 /* of the heading, negative for left aligned */
+} LinuxDynamicField;
+
+Hashtable* LinuxDynamicColumns_new(void);
+
+void LinuxDynamicColumns_done(Hashtable* columns);
+
+const char* LinuxDynamicColumn_name(unsigned int key);
+
+Hashtable* LinuxDynamicScreens_new(void);
+
+void LinuxDynamicScreens_done(Hashtable* screens);
+
+/* Creates the tables of the screens, once the machine exists */
+void LinuxDynamicScreens_appendTables(Machine* host);
+
+/* Called when htoprc .dynamic line is parsed or a screen is added in setup */
+void LinuxDynamicScreen_addDynamicScreen(ScreenSettings* ss);
+
+void LinuxDynamicScreens_addAvailableColumns(Panel* availableColumns, const char* screen);
+
+#endif
@@ -727,6 +727,10 @@ static void LinuxMachine_scanCPUFrequency(LinuxMachine* this) {
 void Machine_scan(Machine* super) {
    LinuxMachine* this = (LinuxMachine*) super;
 
+   /* Replayed samples are loaded along with the processes */
+   if (this->recording && Recording_isReplay(this->recording))
+      return;
+
    LinuxMachine_scanMemoryInfo(this);
    LinuxMachine_scanHugePages(this);
    LinuxMachine_scanZfsArcstats(this);
@@ -784,6 +788,14 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
    if (this->boottime == -1)
       CRT_fatalError("No btime in " PROCSTATFILE);
 
+   // Open the recording, when replaying this sets up the recorded CPUs
+   this->recording = Recording_open(this);
+   if (this->recording && Recording_isReplay(this->recording))
+      return super;
+
+   // Tables of the dynamic screens, which recordings do not cover
+   Platform_updateTables(super);
+
    // Initialize CPU count
    LinuxMachine_updateCPUcount(this);
 
@@ -803,6 +815,8 @@ void Machine_delete(Machine* super) {
 
    Machine_done(super);
 
+   Recording_delete(this->recording);
+
    while (gpuEngineData) {
       GPUEngineData* next = gpuEngineData->next;
       free(gpuEngineData->key);
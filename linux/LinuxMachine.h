@@ -10,6 +10,7 @@ in the source distribution for its full text.
 #include <stdbool.h>
 
 #include "Machine.h"
+#include "linux/Recording.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapStats.h"
 #include "zfs/ZfsArcStats.h"
@@ -94,6 +95,9 @@ typedef struct LinuxMachine_ {
    ZfsArcStats zfs;
    ZramStats zram;
    ZswapStats zswap;
+
+   /* Samples written to or replayed from a file, NULL if neither */
+   Recording* recording;
 } LinuxMachine;
 
 #ifndef PROCDIR
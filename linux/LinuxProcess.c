@@ -26,6 +26,8 @@ in the source distribution for its full text.
 #include "RowField.h"
 #include "Scheduling.h"
 #include "Settings.h"
+#include "Slab.h"
+#include "StringPool.h"
 #include "XUtils.h"
 #include "linux/IOPriority.h"
 #include "linux/LinuxMachine.h"
@@ -114,24 +116,33 @@ const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
    [GPU_PERCENT] = { .name = "GPU_PERCENT", .title = " GPU% ", .description = "Percentage of the GPU time the process used in the last sampling", .flags = PROCESS_FLAG_LINUX_GPU, .defaultSortDesc = true, },
 };
 
+/* Tasks come and go all the time; recycle their objects */
+static Slab LinuxProcess_slab = SLAB_INITIALIZER(LinuxProcess, 64);
+
 Process* LinuxProcess_new(const Machine* host) {
-   LinuxProcess* this = xCalloc(1, sizeof(LinuxProcess));
+   LinuxProcess* this = Slab_alloc(&LinuxProcess_slab);
    Object_setClass(this, Class(LinuxProcess));
    Process_init(&this->super, host);
+   ProcFdCacheEntry_init(&this->fdCache);
    return (Process*)this;
 }
 
 void Process_delete(Object* cast) {
    LinuxProcess* this = (LinuxProcess*) cast;
    Process_done((Process*)cast);
-   free(this->container_short);
-   free(this->cgroup_short);
-   free(this->cgroup);
+   ProcFdCacheEntry_release(&this->fdCache);
+   StringPool_release(this->container_short);
+   StringPool_release(this->cgroup_short);
+   StringPool_release(this->cgroup);
 #ifdef HAVE_OPENVZ
    free(this->ctid);
 #endif
-   free(this->secattr);
-   free(this);
+   StringPool_release(this->secattr);
+   Slab_free(&LinuxProcess_slab, this);
+}
+
+const SlabStats* LinuxProcess_allocationStats(void) {
+   return Slab_stats(&LinuxProcess_slab);
 }
 
 /*
@@ -242,6 +253,12 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
    int attr = CRT_colors[DEFAULT_COLOR];
    size_t n = sizeof(buffer) - 1;
 
+   /* Not read since the row came into view, its last value may be long outdated */
+   if (field < LAST_PROCESSFIELD && (Process_fields[field].flags & lp->skippedFlags)) {
+      RichString_appendChr(str, attr, ' ', strlen(RowField_alignedTitle(host->settings, field)));
+      return;
+   }
+
    switch (field) {
    case CMINFLT: Row_printCount(str, lp->cminflt, coloring); return;
    case CMAJFLT: Row_printCount(str, lp->cmajflt, coloring); return;
@@ -430,11 +447,11 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
       return SPACESHIP_NUMBER(p1->vxid, p2->vxid);
    #endif
    case CGROUP:
-      return SPACESHIP_NULLSTR(p1->cgroup, p2->cgroup);
+      return StringPool_compare(p1->cgroup, p2->cgroup);
    case CCGROUP:
-      return SPACESHIP_NULLSTR(p1->cgroup_short, p2->cgroup_short);
+      return StringPool_compare(p1->cgroup_short, p2->cgroup_short);
    case CONTAINER:
-      return SPACESHIP_NULLSTR(p1->container_short, p2->container_short);
+      return StringPool_compare(p1->container_short, p2->container_short);
    case OOM:
       return SPACESHIP_NUMBER(p1->oom, p2->oom);
    #ifdef HAVE_DELAYACCT
@@ -450,7 +467,7 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
    case CTXT:
       return SPACESHIP_NUMBER(p1->ctxt_diff, p2->ctxt_diff);
    case SECATTR:
-      return SPACESHIP_NULLSTR(p1->secattr, p2->secattr);
+      return StringPool_compare(p1->secattr, p2->secattr);
    case AUTOGROUP_ID:
       return SPACESHIP_NUMBER(p1->autogroup_id, p2->autogroup_id);
    case AUTOGROUP_NICE:
@@ -471,6 +488,193 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
    }
 }
 
+static bool LinuxProcess_numericKey(const Process* super, ProcessField key, uint64_t* result) {
+   const LinuxProcess* lp = (const LinuxProcess*)super;
+
+   switch (key) {
+   case M_DRS:
+      *result = Row_keyFromSigned(lp->m_drs);
+      return true;
+   case M_LRS:
+      *result = Row_keyFromSigned(lp->m_lrs);
+      return true;
+   case M_TRS:
+      *result = Row_keyFromSigned(lp->m_trs);
+      return true;
+   case M_SHARE:
+      *result = Row_keyFromSigned(lp->m_share);
+      return true;
+   case M_PRIV:
+      *result = Row_keyFromSigned(lp->m_priv);
+      return true;
+   case M_PSS:
+      *result = Row_keyFromSigned(lp->m_pss);
+      return true;
+   case M_SWAP:
+      *result = Row_keyFromSigned(lp->m_swap);
+      return true;
+   case M_PSSWP:
+      *result = Row_keyFromSigned(lp->m_psswp);
+      return true;
+   case UTIME:
+      *result = lp->utime;
+      return true;
+   case CUTIME:
+      *result = lp->cutime;
+      return true;
+   case STIME:
+      *result = lp->stime;
+      return true;
+   case CSTIME:
+      *result = lp->cstime;
+      return true;
+   case RCHAR:
+      *result = lp->io_rchar;
+      return true;
+   case WCHAR:
+      *result = lp->io_wchar;
+      return true;
+   case SYSCR:
+      *result = lp->io_syscr;
+      return true;
+   case SYSCW:
+      *result = lp->io_syscw;
+      return true;
+   case RBYTES:
+      *result = lp->io_read_bytes;
+      return true;
+   case WBYTES:
+      *result = lp->io_write_bytes;
+      return true;
+   case CNCLWB:
+      *result = lp->io_cancelled_write_bytes;
+      return true;
+   case IO_READ_RATE:
+      *result = Row_keyFromReal(lp->io_rate_read_bps);
+      return true;
+   case IO_WRITE_RATE:
+      *result = Row_keyFromReal(lp->io_rate_write_bps);
+      return true;
+   case IO_RATE:
+      *result = Row_keyFromReal(LinuxProcess_totalIORate(lp));
+      return true;
+   #ifdef HAVE_OPENVZ
+   case VPID:
+      *result = Row_keyFromSigned(lp->vpid);
+      return true;
+   #endif
+   #ifdef HAVE_VSERVER
+   case VXID:
+      *result = lp->vxid;
+      return true;
+   #endif
+   case OOM:
+      *result = lp->oom;
+      return true;
+   #ifdef HAVE_DELAYACCT
+   case PERCENT_CPU_DELAY:
+      *result = Row_keyFromReal(lp->cpu_delay_percent);
+      return true;
+   case PERCENT_IO_DELAY:
+      *result = Row_keyFromReal(lp->blkio_delay_percent);
+      return true;
+   case PERCENT_SWAP_DELAY:
+      *result = Row_keyFromReal(lp->swapin_delay_percent);
+      return true;
+   #endif
+   case IO_PRIORITY:
+      *result = Row_keyFromSigned(LinuxProcess_effectiveIOPriority(lp));
+      return true;
+   case CTXT:
+      *result = lp->ctxt_diff;
+      return true;
+   case AUTOGROUP_ID:
+      *result = Row_keyFromSigned(lp->autogroup_id);
+      return true;
+   case AUTOGROUP_NICE:
+      *result = Row_keyFromSigned(lp->autogroup_nice);
+      return true;
+   case GPU_TIME:
+      *result = lp->gpu_time;
+      return true;
+   case ISCONTAINER:
+      *result = Row_keyFromSigned(super->isRunningInContainer);
+      return true;
+   #ifdef HAVE_OPENVZ
+   case CTID:
+   #endif
+   case CGROUP:
+   case CCGROUP:
+   case CONTAINER:
+   case SECATTR:
+   case GPU_PERCENT:
+      return false;
+   default:
+      return Process_numericKeyBase(super, key, result);
+   }
+}
+
+static bool LinuxProcess_machineValue(const Process* super, ProcessField field, RowValue* value) {
+   const LinuxProcess* lp = (const LinuxProcess*)super;
+   const LinuxMachine* lhost = (const LinuxMachine*)super->super.host;
+
+   switch (field) {
+   case CMINFLT: return Row_valueUnsigned(value, lp->cminflt);
+   case CMAJFLT: return Row_valueUnsigned(value, lp->cmajflt);
+   /* Pages, in KiB */
+   case M_DRS: return Row_valueSigned(value, lp->m_drs * lhost->pageSizeKB);
+   case M_LRS:
+      if (!lp->m_lrs)
+         return Row_valueNone(value);
+      return Row_valueSigned(value, lp->m_lrs * lhost->pageSizeKB);
+   case M_TRS: return Row_valueSigned(value, lp->m_trs * lhost->pageSizeKB);
+   case M_SHARE: return Row_valueSigned(value, lp->m_share * lhost->pageSizeKB);
+   case M_PRIV: return Row_valueSigned(value, lp->m_priv);
+   case M_PSS: return Row_valueSigned(value, lp->m_pss);
+   case M_SWAP: return Row_valueSigned(value, lp->m_swap);
+   case M_PSSWP: return Row_valueSigned(value, lp->m_psswp);
+   case UTIME: return Row_valueUnsigned(value, lp->utime);
+   case STIME: return Row_valueUnsigned(value, lp->stime);
+   case CUTIME: return Row_valueUnsigned(value, lp->cutime);
+   case CSTIME: return Row_valueUnsigned(value, lp->cstime);
+   case RCHAR: return Row_valueUnsigned(value, lp->io_rchar);
+   case WCHAR: return Row_valueUnsigned(value, lp->io_wchar);
+   case SYSCR: return Row_valueUnsigned(value, lp->io_syscr);
+   case SYSCW: return Row_valueUnsigned(value, lp->io_syscw);
+   case RBYTES: return Row_valueUnsigned(value, lp->io_read_bytes);
+   case WBYTES: return Row_valueUnsigned(value, lp->io_write_bytes);
+   case CNCLWB: return Row_valueUnsigned(value, lp->io_cancelled_write_bytes);
+   case IO_READ_RATE: return Row_valueReal(value, lp->io_rate_read_bps);
+   case IO_WRITE_RATE: return Row_valueReal(value, lp->io_rate_write_bps);
+   case IO_RATE: return Row_valueReal(value, LinuxProcess_totalIORate(lp));
+   #ifdef HAVE_OPENVZ
+   case VPID: return Row_valueSigned(value, lp->vpid);
+   #endif
+   #ifdef HAVE_VSERVER
+   case VXID: return Row_valueUnsigned(value, lp->vxid);
+   #endif
+   case OOM: return Row_valueUnsigned(value, lp->oom);
+   #ifdef HAVE_DELAYACCT
+   case PERCENT_CPU_DELAY: return Row_valueReal(value, lp->cpu_delay_percent);
+   case PERCENT_IO_DELAY: return Row_valueReal(value, lp->blkio_delay_percent);
+   case PERCENT_SWAP_DELAY: return Row_valueReal(value, lp->swapin_delay_percent);
+   #endif
+   case CTXT: return Row_valueUnsigned(value, lp->ctxt_diff);
+   case AUTOGROUP_ID:
+      if (lp->autogroup_id == -1)
+         return Row_valueNone(value);
+      return Row_valueSigned(value, lp->autogroup_id);
+   case AUTOGROUP_NICE:
+      if (lp->autogroup_id == -1)
+         return Row_valueNone(value);
+      return Row_valueSigned(value, lp->autogroup_nice);
+   case GPU_TIME: return Row_valueUnsigned(value, lp->gpu_time);
+   case GPU_PERCENT: return Row_valueReal(value, lp->gpu_percent);
+   default:
+      return Process_machineValueBase(super, field, value);
+   }
+}
+
 const ProcessClass LinuxProcess_class = {
    .super = {
       .super = {
@@ -484,7 +688,11 @@ const ProcessClass LinuxProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .numericKey = Process_rowNumericKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = LinuxProcess_rowWriteField
    },
-   .compareByKey = LinuxProcess_compareByKey
+   .compareByKey = LinuxProcess_compareByKey,
+   .numericKey = LinuxProcess_numericKey,
+   .machineValue = LinuxProcess_machineValue
 };
@@ -14,8 +14,10 @@ in the source distribution for its full text.
 #include "Object.h"
 #include "Process.h"
 #include "Row.h"
+#include "Slab.h"
 
 #include "linux/IOPriority.h"
+#include "linux/ProcFdCache.h"
 
 
 #define PROCESS_FLAG_LINUX_IOPRIO    0x00000100
@@ -32,6 +34,13 @@ in the source distribution for its full text.
 #define PROCESS_FLAG_LINUX_GPU       0x00100000
 #define PROCESS_FLAG_LINUX_CONTAINER 0x00200000
 
+/*
+ * LinuxProcessTable_shownDigest() hashes ranges of members by offset, from
+ * ioPriority up to io_last_scan_time_ms, from io_rate_read_bps up to
+ * last_mlrs_calctime, from gpu_time up to gpu_activityMs and from
+ * autogroup_id up to fdCache. Keep members shown for a process within these
+ * ranges and the scan bookkeeping outside of them when reordering.
+ */
 typedef struct LinuxProcess_ {
    Process super;
    IOPriority ioPriority;
@@ -53,6 +62,9 @@ typedef struct LinuxProcess_ {
    /* Process flags */
    unsigned long int flags;
 
+   /* Column flags left out by the last scan as the row was off screen, shown blank */
+   uint32_t skippedFlags;
+
    /* Data read (in bytes) */
    unsigned long long io_rchar;
 
@@ -90,9 +102,9 @@ typedef struct LinuxProcess_ {
    #ifdef HAVE_VSERVER
    unsigned int vxid;
    #endif
-   char* cgroup;
-   char* cgroup_short;
-   char* container_short;
+   const char* cgroup;                 /* StringPool strings */
+   const char* cgroup_short;
+   const char* container_short;
    unsigned int oom;
    #ifdef HAVE_DELAYACCT
    unsigned long long int delay_read_time;
@@ -105,7 +117,7 @@ typedef struct LinuxProcess_ {
    #endif
    unsigned long ctxt_total;
    unsigned long ctxt_diff;
-   char* secattr;
+   const char* secattr;                /* StringPool string */
    unsigned long long int last_mlrs_calctime;
 
    /* Total GPU time used in nano seconds */
@@ -118,6 +130,18 @@ typedef struct LinuxProcess_ {
    /* Autogroup scheduling (CFS) information */
    long int autogroup_id;
    int autogroup_nice;
+
+   /* Start time in clock ticks after boot, identifies the task behind the PID */
+   unsigned long long int starttime;
+
+   /* procfs descriptors kept open between refreshes */
+   ProcFdCacheEntry fdCache;
+
+   /* Consecutive scans without CPU time, context switches, IO or RSS change */
+   unsigned int idleScans;
+
+   /* Scan of the last read of the context switches, see LinuxProcessTable_readStatusFile() */
+   unsigned int ctxt_scan;
 } LinuxProcess;
 
 extern int pageSize;
@@ -132,6 +156,9 @@ Process* LinuxProcess_new(const Machine* host);
 
 void Process_delete(Object* cast);
 
+/* Usage of the memory holding the LinuxProcess objects */
+const SlabStats* LinuxProcess_allocationStats(void);
+
 IOPriority LinuxProcess_updateIOPriority(Process* proc);
 
 bool LinuxProcess_rowSetIOPriority(Row* super, Arg ioprio);
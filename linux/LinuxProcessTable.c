@@ -12,11 +12,13 @@ in the source distribution for its full text.
 #include <assert.h>
 #include <ctype.h>
 #include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
 #include <limits.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,28 +29,43 @@ in the source distribution for its full text.
 
 #include "Compat.h"
 #include "Hashtable.h"
+#include "Instrument.h"
 #include "Machine.h"
 #include "Macros.h"
 #include "Object.h"
 #include "Process.h"
+#include "ProcessFilter.h"
 #include "Row.h"
 #include "RowField.h"
 #include "Scheduling.h"
 #include "Settings.h"
+#include "StringPool.h"
 #include "Table.h"
 #include "UsersTable.h"
+#include "Vector.h"
 #include "XUtils.h"
+#include "linux/BatchReader.h"
 #include "linux/CGroupUtils.h"
 #include "linux/GPU.h"
 #include "linux/GPUMeter.h"
 #include "linux/LinuxMachine.h"
 #include "linux/LinuxProcess.h"
+#include "linux/ProcFdCache.h"
+#include "linux/ProcTokenizer.h"
 #include "linux/Platform.h" // needed for GNU/hurd to get PATH_MAX  // IWYU pragma: keep
 
 #ifdef HAVE_DELAYACCT
 #include "linux/LibNl.h"
 #endif
 
+#ifdef HAVE_PROC_CONNECTOR
+#include "linux/ProcConnector.h"
+#endif
+
+#ifdef HAVE_SCAN_THREADS
+#include "linux/ProcScanPool.h"
+#endif
+
 #if defined(MAJOR_IN_MKDEV)
 #include <sys/mkdev.h>
 #elif defined(MAJOR_IN_SYSMACROS)
@@ -78,70 +95,164 @@ static FILE* fopenat(openat_arg_t openatArg, const char* pathname, const char* m
    return fp;
 }
 
-static inline uint64_t fast_strtoull_dec(char** str, int maxlen) {
-   uint64_t result = 0;
+#ifdef HAVE_OPENAT
 
-   if (!maxlen)
-      maxlen = 20; // length of maximum value of 18446744073709551615
+/* Files read ahead by LinuxProcessTable_readBatch */
+typedef enum LinuxBatchFile_ {
+   BATCH_STAT,
+   BATCH_TASK_STAT,
+   BATCH_STATM,
+   BATCH_IO,
+   BATCH_STATUS,
+   BATCH_FILES
+} LinuxBatchFile;
+
+/* Buffer sizes, matching the ones of the respective readers */
+static const size_t batchFileSizes[BATCH_FILES] = {
+   [BATCH_STAT] = MAX_READ + 1,
+   [BATCH_TASK_STAT] = MAX_READ + 1,
+   [BATCH_STATM] = 128,
+   [BATCH_IO] = 1024,
+   [BATCH_STATUS] = 2 * PROC_LINE_LENGTH,
+};
+
+typedef struct LinuxBatchedTask_ {
+   /* Index into the batch reads or -1 */
+   int reads[BATCH_FILES];
+} LinuxBatchedTask;
+
+static bool LinuxProcessTable_takeBatched(LinuxProcessTable* this, pid_t tid, LinuxBatchFile file, char* buffer, size_t count, ssize_t* result) {
+   const LinuxReadBatch* batch = &this->readBatch;
+   if (batch->count == 0 || count == 0)
+      return false;
 
-   while (maxlen-- && **str >= '0' && **str <= '9') {
-      result *= 10;
-      result += **str - '0';
-      (*str)++;
+   LinuxBatchedTask* task = Hashtable_get(batch->index, (ht_key_t)tid);
+   if (!task || task->reads[file] < 0)
+      return false;
+
+   const BatchRead* read = &batch->reads[task->reads[file]];
+   task->reads[file] = -1;
+
+   if (read->result < 0) {
+      buffer[0] = '\0';
+      *result = read->result;
+      return true;
    }
 
-   return result;
+   size_t len = MINIMUM((size_t)read->result, count - 1);
+   memcpy(buffer, read->buffer, len);
+   buffer[len] = '\0';
+   *result = (ssize_t)len;
+   return true;
 }
 
-static long long fast_strtoll_dec(char** str, int maxlen) {
-   bool neg = false;
+#endif /* HAVE_OPENAT */
 
-   if (**str == '-') {
-      neg = true;
-      (*str)++;
-   }
+/*
+ * Read a per-task procfs file, preferring the data prefetched by the scan
+ * workers or read ahead in the batch of the current refresh
+ */
+static ssize_t LinuxProcessTable_readProcFile(LinuxProcessTable* this, openat_arg_t procFd, pid_t tid, const char* pathname, char* buffer, size_t count) {
+#ifdef HAVE_SCAN_THREADS
+   ssize_t r;
+   if (this->scanPool && ProcScanPool_read(this->scanPool, tid, pathname, buffer, count, &r))
+      return r;
+#endif
 
-   unsigned long long res = fast_strtoull_dec(str, maxlen);
-   assert(res <= LLONG_MAX);
-   long long result = (long long)res;
+#ifdef HAVE_OPENAT
+   ssize_t br;
+   if (String_eq(pathname, "status")) {
+      if (LinuxProcessTable_takeBatched(this, tid, BATCH_STATUS, buffer, count, &br))
+         return br;
+   } else if (String_eq(pathname, "io")) {
+      if (LinuxProcessTable_takeBatched(this, tid, BATCH_IO, buffer, count, &br))
+         return br;
+   }
+#else
+   (void) this;
+   (void) tid;
+#endif
 
-   return neg ? -result : result;
+   return xReadfileat(procFd, pathname, buffer, count);
 }
 
-static long fast_strtol_dec(char** str, int maxlen) {
-   long long result = fast_strtoll_dec(str, maxlen);
-   assert(result <= LONG_MAX);
-   assert(result >= LONG_MIN);
-   return (long)result;
+/*
+ * Re-read a file that filled the buffer of the given size, like a status
+ * file with a long list of groups, doubling the buffer until it fits.
+ * Returns a buffer to free, or NULL if the file could not be read again.
+ */
+static char* LinuxProcessTable_readLongProcFile(openat_arg_t procFd, const char* pathname, size_t size, ssize_t* result) {
+   char* buffer = NULL;
+
+   for (;;) {
+      size *= 2;
+      buffer = xRealloc(buffer, size);
+
+      ssize_t r = xReadfileat(procFd, pathname, buffer, size);
+      if (r < 0) {
+         free(buffer);
+         return NULL;
+      }
+      if ((size_t)r < size - 1) {
+         *result = r;
+         return buffer;
+      }
+   }
 }
 
-static unsigned long fast_strtoul_dec(char** str, int maxlen) {
-   unsigned long long result = fast_strtoull_dec(str, maxlen);
-   assert(result <= ULONG_MAX);
-   return (unsigned long)result;
+/*
+ * Read a per-task procfs file needed on every refresh, keeping it open
+ * between refreshes in the descriptor cache of the task
+ */
+static ssize_t LinuxProcessTable_readHotProcFile(LinuxProcessTable* this, LinuxProcess* lp, ProcFdSlot slot, openat_arg_t procFd, const char* pathname, char* buffer, size_t count) {
+#ifdef HAVE_OPENAT
+#ifdef HAVE_SCAN_THREADS
+   ssize_t pr;
+   if (this->scanPool && ProcScanPool_read(this->scanPool, Process_getPid(&lp->super), pathname, buffer, count, &pr))
+      return pr;
+#endif
+
+   static const LinuxBatchFile slotFiles[PROC_FD_SLOTS] = {
+      [PROC_FD_DIR] = BATCH_FILES,
+      [PROC_FD_STAT] = BATCH_STAT,
+      [PROC_FD_TASK_STAT] = BATCH_TASK_STAT,
+      [PROC_FD_STATM] = BATCH_STATM,
+   };
+
+   int fd = ProcFdCache_get(&this->fdCache, &lp->fdCache, slot);
+   if (fd >= 0) {
+      ssize_t br;
+      if (slotFiles[slot] != BATCH_FILES && LinuxProcessTable_takeBatched(this, Process_getPid(&lp->super), slotFiles[slot], buffer, count, &br))
+         return br;
+
+      /* Fails with ESRCH once the task is gone, even if its PID got reused */
+      return xPreadfile(fd, buffer, count);
+   }
+
+   fd = openat(procFd, pathname, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return -errno;
+
+   ssize_t r = xPreadfile(fd, buffer, count);
+   if (r < 0 || !ProcFdCache_put(&this->fdCache, &lp->fdCache, slot, fd))
+      close(fd);
+
+   return r;
+#else
+   (void) slot;
+   return LinuxProcessTable_readProcFile(this, procFd, Process_getPid(&lp->super), pathname, buffer, count);
+#endif
 }
 
-static inline uint64_t fast_strtoull_hex(char** str, int maxlen) {
-   register uint64_t result = 0;
-   register int nibble, letter;
-   const long valid_mask = 0x03FF007E;
+static inline uint64_t fast_strtoull_dec(char** str, int maxlen) {
+   uint64_t result = 0;
 
    if (!maxlen)
-      --maxlen;
+      maxlen = 20; // length of maximum value of 18446744073709551615
 
-   while (maxlen--) {
-      nibble = (unsigned char)**str;
-      if (!(valid_mask & (1 << (nibble & 0x1F))))
-         break;
-      if ((nibble < '0') || (nibble & ~0x20) > 'F')
-         break;
-      letter = (nibble & 0x40) ? 'A' - '9' - 1 : 0;
-      nibble &=~0x20; // to upper
-      nibble ^= 0x10; // switch letters and digits
-      nibble -= letter;
-      nibble &= 0x0f;
-      result <<= 4;
-      result += (uint64_t)nibble;
+   while (maxlen-- && **str >= '0' && **str <= '9') {
+      result *= 10;
+      result += **str - '0';
       (*str)++;
    }
 
@@ -243,9 +354,18 @@ ProcessTable* ProcessTable_new(Machine* host, Hashtable* pidMatchList) {
 
    ProcessTable* super = &this->super;
    ProcessTable_init(super, Class(LinuxProcess), host, pidMatchList);
+   super->super.tracksChanges = true;
 
    LinuxProcessTable_initTtyDrivers(this);
 
+   this->batchReader = BatchReader_new();
+
+   Instrument_watchSlab("Process objects", LinuxProcess_allocationStats());
+
+#ifdef HAVE_OPENAT
+   ProcFdCache_init(&this->fdCache);
+#endif
+
    // Test /proc/PID/smaps_rollup availability (faster to parse, Linux 4.14+)
    this->haveSmapsRollup = (access(PROCDIR "/self/smaps_rollup", R_OK) == 0);
 
@@ -266,6 +386,15 @@ ProcessTable* ProcessTable_new(Machine* host, Hashtable* pidMatchList) {
 void ProcessTable_delete(Object* cast) {
    LinuxProcessTable* this = (LinuxProcessTable*) cast;
    ProcessTable_done(&this->super);
+#ifdef HAVE_OPENAT
+   ProcFdCache_done(&this->fdCache);
+   free(this->readBatch.reads);
+   free(this->readBatch.buffer);
+   free(this->readBatch.tasks);
+   if (this->readBatch.index)
+      Hashtable_delete(this->readBatch.index);
+#endif
+   BatchReader_delete(this->batchReader);
    if (this->ttyDrivers) {
       for (int i = 0; this->ttyDrivers[i].path; i++) {
          free(this->ttyDrivers[i].path);
@@ -275,6 +404,14 @@ void ProcessTable_delete(Object* cast) {
    #ifdef HAVE_DELAYACCT
    LibNl_destroyNetlinkSocket(this);
    #endif
+   #ifdef HAVE_PROC_CONNECTOR
+   ProcConnector_delete(this->procConnector);
+   free(this->taskRefs);
+   #endif
+   #ifdef HAVE_SCAN_THREADS
+   if (this->scanPool)
+      ProcScanPool_delete(this->scanPool);
+   #endif
    free(this);
 }
 
@@ -301,17 +438,52 @@ static inline ProcessState LinuxProcessTable_getProcessState(char state) {
 /*
  * Read /proc/<pid>/stat (thread-specific data)
  */
-static bool LinuxProcessTable_readStatFile(LinuxProcess* lp, openat_arg_t procFd, const LinuxMachine* lhost, bool scanMainThread, char* command, size_t commLen) {
-   Process* process = &lp->super;
+/* Fields of /proc/<pid>/stat following the command, from (3) state up to (39) processor */
+#define STAT_FIRST_FIELD 3
+#define STAT_LAST_FIELD 39
+
+typedef struct StatFields_ {
+   const char* data;
+   size_t len;
+   size_t nSeps;
+   uint32_t seps[STAT_LAST_FIELD - STAT_FIRST_FIELD + 1];
+} StatFields;
+
+static bool StatFields_split(StatFields* this, const char* data, size_t len) {
+   this->data = data;
+   this->len = len;
+   this->nSeps = ProcTokenizer_split(data, len, ' ', this->seps, ARRAYSIZE(this->seps));
+
+   /* The last field needed must at least have started */
+   return this->nSeps >= STAT_LAST_FIELD - STAT_FIRST_FIELD;
+}
 
-   char buf[MAX_READ + 1];
-   char path[22] = "stat";
-   if (scanMainThread) {
-      xSnprintf(path, sizeof(path), "task/%"PRIi32"/stat", (int32_t)Process_getPid(process));
-   }
-   ssize_t r = xReadfileat(procFd, path, buf, sizeof(buf));
-   if (r < 0)
-      return false;
+/* Field number n as documented in proc(5) */
+static inline const char* StatFields_get(const StatFields* this, int n, size_t* len) {
+   assert(n >= STAT_FIRST_FIELD && n <= STAT_LAST_FIELD);
+
+   const size_t i = (size_t)(n - STAT_FIRST_FIELD);
+   const size_t start = i ? this->seps[i - 1] + 1 : 0;
+   const size_t end = i < this->nSeps ? this->seps[i] : this->len;
+   *len = end - start;
+   return this->data + start;
+}
+
+static inline uint64_t StatFields_unsigned(const StatFields* this, int n) {
+   size_t len;
+   const char* str = StatFields_get(this, n, &len);
+   return ProcTokenizer_parseDec(str, len, NULL);
+}
+
+static inline int64_t StatFields_signed(const StatFields* this, int n) {
+   size_t len;
+   const char* str = StatFields_get(this, n, &len);
+   return ProcTokenizer_parseSignedDec(str, len);
+}
+
+/* Parse the NUL-terminated contents of /proc/<pid>/stat */
+static bool LinuxProcessTable_parseStat(LinuxProcess* lp, char* buf, size_t r, const LinuxMachine* lhost, char* command, size_t commLen) {
+   Process* process = &lp->super;
 
    /* (1) pid   -  %d */
    assert(Process_getPid(process) == atoi(buf));
@@ -338,182 +510,77 @@ static bool LinuxProcessTable_readStatFile(LinuxProcess* lp, openat_arg_t procFd
 
    location = end + 2;
 
-   /* (3) state  -  %c */
-   process->state = LinuxProcessTable_getProcessState(location[0]);
-
-   if (!location[0] || !location[1])
+   StatFields fields;
+   if (!StatFields_split(&fields, location, (size_t)(buf + r - location)))
       return false;
 
-   location += 2;
+   /* (3) state  -  %c */
+   process->state = LinuxProcessTable_getProcessState(location[0]);
 
    /* (4) ppid  -  %d */
-   Process_setParent(process, fast_strtol_dec(&location, 0));
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   Process_setParent(process, (pid_t)StatFields_signed(&fields, 4));
 
    /* (5) pgrp  -  %d */
-   process->pgrp = fast_strtol_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->pgrp = (pid_t)StatFields_signed(&fields, 5);
 
    /* (6) session  -  %d */
-   process->session = fast_strtol_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->session = (pid_t)StatFields_signed(&fields, 6);
 
    /* (7) tty_nr  -  %d */
-   process->tty_nr = fast_strtoul_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->tty_nr = (unsigned long)StatFields_unsigned(&fields, 7);
 
    /* (8) tpgid  -  %d */
-   process->tpgid = fast_strtol_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->tpgid = (pid_t)StatFields_signed(&fields, 8);
 
    /* (9) flags  -  %u */
-   lp->flags = fast_strtoul_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->flags = (unsigned long)StatFields_unsigned(&fields, 9);
 
    /* (10) minflt  -  %lu */
-   process->minflt = fast_strtoull_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->minflt = StatFields_unsigned(&fields, 10);
 
    /* (11) cminflt  -  %lu */
-   lp->cminflt = fast_strtoull_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->cminflt = StatFields_unsigned(&fields, 11);
 
    /* (12) majflt  -  %lu */
-   process->majflt = fast_strtoull_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->majflt = StatFields_unsigned(&fields, 12);
 
    /* (13) cmajflt  -  %lu */
-   lp->cmajflt = fast_strtoull_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->cmajflt = StatFields_unsigned(&fields, 13);
 
    /* (14) utime  -  %lu */
-   lp->utime = LinuxProcessTable_adjustTime(lhost, fast_strtoull_dec(&location, 0));
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->utime = LinuxProcessTable_adjustTime(lhost, StatFields_unsigned(&fields, 14));
 
    /* (15) stime  -  %lu */
-   lp->stime = LinuxProcessTable_adjustTime(lhost, fast_strtoull_dec(&location, 0));
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->stime = LinuxProcessTable_adjustTime(lhost, StatFields_unsigned(&fields, 15));
 
    /* (16) cutime  -  %ld */
-   lp->cutime = LinuxProcessTable_adjustTime(lhost, fast_strtoull_dec(&location, 0));
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->cutime = LinuxProcessTable_adjustTime(lhost, StatFields_unsigned(&fields, 16));
 
    /* (17) cstime  -  %ld */
-   lp->cstime = LinuxProcessTable_adjustTime(lhost, fast_strtoull_dec(&location, 0));
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   lp->cstime = LinuxProcessTable_adjustTime(lhost, StatFields_unsigned(&fields, 17));
 
    /* (18) priority  -  %ld */
-   process->priority = fast_strtol_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->priority = (long)StatFields_signed(&fields, 18);
 
    /* (19) nice  -  %ld */
-   process->nice = fast_strtol_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->nice = (long)StatFields_signed(&fields, 19);
 
    /* (20) num_threads  -  %ld */
-   process->nlwp = fast_strtol_dec(&location, 0);
-
-   if (!location[0])
-      return false;
-
-   location += 1;
+   process->nlwp = (long)StatFields_signed(&fields, 20);
 
    /* Skip (21) itrealvalue  -  %ld */
-   location = strchr(location, ' ');
-
-   if (!location)
-      return false;
-
-   location += 1;
 
    /* (22) starttime  -  %llu */
-   if (process->starttime_ctime == 0) {
-      process->starttime_ctime = lhost->boottime + LinuxProcessTable_adjustTime(lhost, fast_strtoll_dec(&location, 0)) / 100;
-   } else {
-      location = strchr(location, ' ');
-      if (!location)
-         return false;
+   unsigned long long int starttime = StatFields_unsigned(&fields, 22);
+   if (process->starttime_ctime == 0 || starttime != lp->starttime) {
+      process->starttime_ctime = lhost->boottime + LinuxProcessTable_adjustTime(lhost, starttime) / 100;
+      lp->starttime = starttime;
    }
-   location += 1;
 
    /* Skip (23) - (38) */
-   for (int i = 0; i < 16; i++) {
-      location = strchr(location, ' ');
-
-      if (!location)
-         return false;
-
-      location += 1;
-   }
-
-   assert(location != NULL);
 
    /* (39) processor  -  %d */
-   process->processor = fast_strtol_dec(&location, 0);
+   process->processor = (int)StatFields_signed(&fields, 39);
 
    /* Ignore further fields */
 
@@ -522,10 +589,23 @@ static bool LinuxProcessTable_readStatFile(LinuxProcess* lp, openat_arg_t procFd
    return true;
 }
 
+static bool LinuxProcessTable_readStatFile(LinuxProcessTable* this, LinuxProcess* lp, openat_arg_t procFd, const LinuxMachine* lhost, bool scanMainThread, char* command, size_t commLen) {
+   char buf[MAX_READ + 1];
+   char path[22] = "stat";
+   if (scanMainThread) {
+      xSnprintf(path, sizeof(path), "task/%"PRIi32"/stat", (int32_t)Process_getPid(&lp->super));
+   }
+   ssize_t r = LinuxProcessTable_readHotProcFile(this, lp, scanMainThread ? PROC_FD_TASK_STAT : PROC_FD_STAT, procFd, path, buf, sizeof(buf));
+   if (r < 0)
+      return false;
+
+   return LinuxProcessTable_parseStat(lp, buf, (size_t)r, lhost, command, commLen);
+}
+
 /*
  * Read /proc/<pid>/status (thread-specific data)
  */
-static bool LinuxProcessTable_readStatusFile(Process* process, openat_arg_t procFd) {
+static bool LinuxProcessTable_readStatusFile(LinuxProcessTable* this, Process* process, openat_arg_t procFd) {
    LinuxProcess* lp = (LinuxProcess*) process;
 
    unsigned long ctxt = 0;
@@ -534,57 +614,62 @@ static bool LinuxProcessTable_readStatusFile(Process* process, openat_arg_t proc
    lp->vxid = 0;
 #endif
 
-   FILE* statusfile = fopenat(procFd, "status", "r");
-   if (!statusfile)
+   char buffer[2 * PROC_LINE_LENGTH];
+   ssize_t r = LinuxProcessTable_readProcFile(this, procFd, Process_getPid(process), "status", buffer, sizeof(buffer));
+   if (r < 0)
       return false;
 
-   char buffer[PROC_LINE_LENGTH + 1] = {0};
+   char* longBuffer = NULL;
+   if ((size_t)r >= sizeof(buffer) - 1)
+      longBuffer = LinuxProcessTable_readLongProcFile(procFd, "status", sizeof(buffer), &r);
 
-   while (fgets(buffer, sizeof(buffer), statusfile)) {
+   char* buf = longBuffer ? longBuffer : buffer;
+   const char* line;
+   while ((line = strsep(&buf, "\n")) != NULL) {
 
-      if (String_startsWith(buffer, "NSpid:")) {
-         const char* ptr = buffer;
+      if (String_startsWith(line, "NSpid:")) {
+         const char* ptr = line;
          int pid_ns_count = 0;
-         while (*ptr && *ptr != '\n' && !isdigit((unsigned char)*ptr))
+         while (*ptr && !isdigit((unsigned char)*ptr))
             ++ptr;
 
-         while (*ptr && *ptr != '\n') {
+         while (*ptr) {
             if (isdigit(*ptr))
                pid_ns_count++;
             while (isdigit((unsigned char)*ptr))
                ++ptr;
-            while (*ptr && *ptr != '\n' && !isdigit((unsigned char)*ptr))
+            while (*ptr && !isdigit((unsigned char)*ptr))
                ++ptr;
          }
 
          if (pid_ns_count > 1)
             process->isRunningInContainer = TRI_ON;
 
-      } else if (String_startsWith(buffer, "voluntary_ctxt_switches:")) {
+      } else if (String_startsWith(line, "voluntary_ctxt_switches:")) {
          unsigned long vctxt;
-         int ok = sscanf(buffer, "voluntary_ctxt_switches:\t%lu", &vctxt);
+         int ok = sscanf(line, "voluntary_ctxt_switches:\t%lu", &vctxt);
          if (ok == 1) {
             ctxt += vctxt;
          }
 
-      } else if (String_startsWith(buffer, "nonvoluntary_ctxt_switches:")) {
+      } else if (String_startsWith(line, "nonvoluntary_ctxt_switches:")) {
          unsigned long nvctxt;
-         int ok = sscanf(buffer, "nonvoluntary_ctxt_switches:\t%lu", &nvctxt);
+         int ok = sscanf(line, "nonvoluntary_ctxt_switches:\t%lu", &nvctxt);
          if (ok == 1) {
             ctxt += nvctxt;
          }
 
 #ifdef HAVE_VSERVER
-      } else if (String_startsWith(buffer, "VxID:")) {
+      } else if (String_startsWith(line, "VxID:")) {
          int vxid;
-         int ok = sscanf(buffer, "VxID:\t%32d", &vxid);
+         int ok = sscanf(line, "VxID:\t%32d", &vxid);
          if (ok == 1) {
             lp->vxid = vxid;
          }
 #ifdef HAVE_ANCIENT_VSERVER
-      } else if (String_startsWith(buffer, "s_context:")) {
+      } else if (String_startsWith(line, "s_context:")) {
          int vxid;
-         int ok = sscanf(buffer, "s_context:\t%32d", &vxid);
+         int ok = sscanf(line, "s_context:\t%32d", &vxid);
          if (ok == 1) {
             lp->vxid = vxid;
          }
@@ -593,10 +678,16 @@ static bool LinuxProcessTable_readStatusFile(Process* process, openat_arg_t proc
       }
    }
 
-   fclose(statusfile);
+   free(longBuffer);
 
-   lp->ctxt_diff = (ctxt > lp->ctxt_total) ? (ctxt - lp->ctxt_total) : 0;
+   /* Idle tasks skip reads, spread their switches over the scans since the last read */
+   unsigned int scans = lp->ctxt_scan ? this->scanCount - lp->ctxt_scan : 1;
+   if (scans == 0)
+      scans = 1;
+
+   lp->ctxt_diff = (ctxt > lp->ctxt_total) ? (ctxt - lp->ctxt_total) / scans : 0;
    lp->ctxt_total = ctxt;
+   lp->ctxt_scan = this->scanCount;
 
    return true;
 }
@@ -631,7 +722,7 @@ static bool LinuxProcessTable_updateUser(const Machine* host, Process* process,
 /*
  * Read /proc/<pid>/io (thread-specific data)
  */
-static void LinuxProcessTable_readIoFile(LinuxProcess* lp, openat_arg_t procFd, bool scanMainThread) {
+static void LinuxProcessTable_readIoFile(LinuxProcessTable* this, LinuxProcess* lp, openat_arg_t procFd, bool scanMainThread) {
    Process* process = &lp->super;
    const Machine* host = process->super.host;
    char path[20] = "io";
@@ -639,7 +730,7 @@ static void LinuxProcessTable_readIoFile(LinuxProcess* lp, openat_arg_t procFd,
    if (scanMainThread) {
       xSnprintf(path, sizeof(path), "task/%"PRIi32"/io", (int32_t)Process_getPid(process));
    }
-   ssize_t r = xReadfileat(procFd, path, buffer, sizeof(buffer));
+   ssize_t r = LinuxProcessTable_readProcFile(this, procFd, Process_getPid(process), path, buffer, sizeof(buffer));
    if (r < 0) {
       lp->io_rate_read_bps = NAN;
       lp->io_rate_write_bps = NAN;
@@ -721,107 +812,139 @@ static void LinuxProcessTable_calcLibSize_helper(ATTR_UNUSED ht_key_t key, void*
 /*
  * Read /proc/<pid>/maps (process-shared data)
  */
-static void LinuxProcessTable_readMaps(LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* host, bool calcSize, bool checkDeletedLib) {
+/* Parse one line of /proc/<pid>/maps, without its newline */
+static void LinuxProcessTable_parseMapsLine(LinuxProcess* process, Hashtable* ht, bool checkDeletedLib, const char* line, size_t len) {
    Process* proc = (Process*)process;
 
-   proc->usesDeletedLib = false;
+   // Short circuit test: Look for a slash
+   const char* path = memchr(line, '/', len);
+   if (!path)
+      return;
 
-   FILE* mapsfile = fopenat(procFd, "maps", "r");
-   if (!mapsfile)
+   // Parse format: "%Lx-%Lx %4s %x %2x:%2x %Ld"
+   uint32_t seps[5];
+   if (ProcTokenizer_split(line, (size_t)(path - line), ' ', seps, ARRAYSIZE(seps)) < ARRAYSIZE(seps))
       return;
 
-   Hashtable* ht = NULL;
-   if (calcSize)
-      ht = Hashtable_new(64, true);
+   const char* dash = memchr(line, '-', seps[0]);
+   if (!dash)
+      return;
 
-   char buffer[1024];
-   while (fgets(buffer, sizeof(buffer), mapsfile)) {
-      uint64_t map_start;
-      uint64_t map_end;
-      bool map_execute;
-      unsigned int map_devmaj;
-      unsigned int map_devmin;
-      uint64_t map_inode;
-
-      // Short circuit test: Look for a slash
-      if (!strchr(buffer, '/'))
-         continue;
+   /* Permissions */
+   if (seps[1] - seps[0] != 5)
+      return;
 
-      // Parse format: "%Lx-%Lx %4s %x %2x:%2x %Ld"
-      char* readptr = buffer;
+   bool map_execute = line[seps[0] + 3] == 'x';
 
-      map_start = fast_strtoull_hex(&readptr, 16);
-      if ('-' != *readptr++)
-         continue;
+   /* Device */
+   const char* dev = line + seps[2] + 1;
+   size_t devLen = seps[3] - seps[2] - 1;
+   const char* colon = memchr(dev, ':', devLen);
+   if (!colon)
+      return;
 
-      map_end = fast_strtoull_hex(&readptr, 16);
-      if (' ' != *readptr++)
-         continue;
+   uint64_t map_devmaj = ProcTokenizer_parseHex(dev, (size_t)(colon - dev));
+   uint64_t map_devmin = ProcTokenizer_parseHex(colon + 1, (size_t)(dev + devLen - colon - 1));
 
-      if (!readptr[0] || !readptr[1] || !readptr[2] || !readptr[3])
-         continue;
+   //Minor shortcut: Once we know there's no file for this region, we skip
+   if (!map_devmaj && !map_devmin)
+      return;
 
-      map_execute = (readptr[2] == 'x');
-      readptr += 4;
-      if (' ' != *readptr++)
-         continue;
+   uint64_t map_inode = ProcTokenizer_parseDec(line + seps[3] + 1, seps[4] - seps[3] - 1, NULL);
+   if (!map_inode)
+      return;
 
-      while (*readptr > ' ')
-         readptr++; // Skip parsing this hex value
-      if (' ' != *readptr++)
-         continue;
+   if (ht) {
+      uint64_t map_start = ProcTokenizer_parseHex(line, (size_t)(dash - line));
+      uint64_t map_end = ProcTokenizer_parseHex(dash + 1, (size_t)(line + seps[0] - dash - 1));
 
-      map_devmaj = fast_strtoull_hex(&readptr, 4);
-      if (':' != *readptr++)
-         continue;
+      LibraryData* libdata = Hashtable_get(ht, map_inode);
+      if (!libdata) {
+         libdata = xCalloc(1, sizeof(LibraryData));
+         Hashtable_put(ht, map_inode, libdata);
+      }
 
-      map_devmin = fast_strtoull_hex(&readptr, 4);
-      if (' ' != *readptr++)
-         continue;
+      libdata->size += map_end - map_start;
+      libdata->exec |= map_execute;
+   }
 
-      //Minor shortcut: Once we know there's no file for this region, we skip
-      if (!map_devmaj && !map_devmin)
-         continue;
+   if (checkDeletedLib && map_execute && !proc->usesDeletedLib) {
+      size_t pathLen = (size_t)(line + len - path);
 
-      map_inode = fast_strtoull_dec(&readptr, 0);
-      if (!map_inode)
-         continue;
+      if (pathLen >= strlen("/memfd:") && String_startsWith(path, "/memfd:"))
+         return;
 
-      if (calcSize) {
-         LibraryData* libdata = Hashtable_get(ht, map_inode);
-         if (!libdata) {
-            libdata = xCalloc(1, sizeof(LibraryData));
-            Hashtable_put(ht, map_inode, libdata);
-         }
+      /* Virtualbox maps /dev/zero for memory allocation. That results in
+       * false positive, so ignore. */
+      static const char devZero[] = "/dev/zero (deleted)";
+      if (pathLen == strlen(devZero) && memcmp(path, devZero, pathLen) == 0)
+         return;
 
-         libdata->size += map_end - map_start;
-         libdata->exec |= map_execute;
-      }
+      static const char deleted[] = " (deleted)";
+      if (pathLen >= strlen(deleted) && memcmp(path + pathLen - strlen(deleted), deleted, strlen(deleted)) == 0)
+         proc->usesDeletedLib = true;
+   }
+}
 
-      if (checkDeletedLib && map_execute && !proc->usesDeletedLib) {
-         while (*readptr == ' ')
-            readptr++;
+static void LinuxProcessTable_readMaps(LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* host, bool calcSize, bool checkDeletedLib) {
+   Process* proc = (Process*)process;
 
-         if (*readptr != '/')
-            continue;
+   proc->usesDeletedLib = false;
 
-         if (String_startsWith(readptr, "/memfd:"))
-            continue;
+   int fd = Compat_openat(procFd, "maps", O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return;
 
-         /* Virtualbox maps /dev/zero for memory allocation. That results in
-          * false positive, so ignore. */
-         if (String_eq(readptr, "/dev/zero (deleted)\n"))
-            continue;
+   Hashtable* ht = NULL;
+   if (calcSize)
+      ht = Hashtable_new(64, true);
+
+   /* Processes like JVMs have tens of thousands of mappings; read in large blocks */
+   char buffer[65536];
+   uint32_t newlines[512];
+   size_t filled = 0;
+   bool skipLine = false;
+
+   for (;;) {
+      ssize_t res = read(fd, buffer + filled, sizeof(buffer) - filled);
+      if (res < 0 && errno == EINTR)
+         continue;
+      if (res <= 0)
+         break;
+
+      const size_t len = filled + (size_t)res;
+      size_t lineStart = 0;
 
-         if (strstr(readptr, " (deleted)\n")) {
-            proc->usesDeletedLib = true;
-            if (!calcSize)
-               break;
+      for (;;) {
+         const size_t base = lineStart;
+         size_t n = ProcTokenizer_split(buffer + base, len - base, '\n', newlines, ARRAYSIZE(newlines));
+
+         for (size_t i = 0; i < n; i++) {
+            size_t lineEnd = base + newlines[i];
+            if (!skipLine)
+               LinuxProcessTable_parseMapsLine(process, ht, checkDeletedLib, buffer + lineStart, lineEnd - lineStart);
+            skipLine = false;
+            lineStart = lineEnd + 1;
          }
+
+         if (n < ARRAYSIZE(newlines))
+            break;
+      }
+
+      if (!calcSize && proc->usesDeletedLib)
+         break;
+
+      /* Keep the incomplete last line; drop it if it fills the whole buffer */
+      filled = len - lineStart;
+      if (filled == sizeof(buffer)) {
+         filled = 0;
+         skipLine = true;
+      } else if (filled > 0) {
+         memmove(buffer, buffer + lineStart, filled);
       }
    }
 
-   fclose(mapsfile);
+   close(fd);
 
    if (calcSize) {
       uint64_t total_size = 0;
@@ -836,7 +959,7 @@ static void LinuxProcessTable_readMaps(LinuxProcess* process, openat_arg_t procF
 /*
  * Read /proc/<pid>/statm (process-shared data)
  */
-static bool LinuxProcessTable_readStatmFile(LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* host, const LinuxProcess* mainTask) {
+static bool LinuxProcessTable_readStatmFile(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* host, const LinuxProcess* mainTask) {
    if (mainTask) {
       process->super.m_virt     = mainTask->super.m_virt;
       process->super.m_resident = mainTask->super.m_resident;
@@ -845,7 +968,7 @@ static bool LinuxProcessTable_readStatmFile(LinuxProcess* process, openat_arg_t
 
    char statmdata[128] = {0};
 
-   if (xReadfileat(procFd, "statm", statmdata, sizeof(statmdata)) < 1) {
+   if (LinuxProcessTable_readHotProcFile(this, process, PROC_FD_STATM, procFd, "statm", statmdata, sizeof(statmdata)) < 1) {
       return false;
    }
 
@@ -1000,34 +1123,31 @@ static void LinuxProcessTable_readOpenVZData(LinuxProcess* process, openat_arg_t
 /*
  * Read /proc/<pid>/cgroup (thread-specific data)
  */
-static void LinuxProcessTable_readCGroupFile(LinuxProcess* process, openat_arg_t procFd) {
-   FILE* file = fopenat(procFd, "cgroup", "r");
-   if (!file) {
-      if (process->cgroup) {
-         free(process->cgroup);
-         process->cgroup = NULL;
-      }
-      if (process->cgroup_short) {
-         free(process->cgroup_short);
-         process->cgroup_short = NULL;
-      }
-      if (process->container_short) {
-         free(process->container_short);
-         process->container_short = NULL;
-      }
+static void LinuxProcessTable_readCGroupFile(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd) {
+   char buffer[2 * PROC_LINE_LENGTH];
+   ssize_t r = LinuxProcessTable_readProcFile(this, procFd, Process_getPid(&process->super), "cgroup", buffer, sizeof(buffer));
+   if (r < 0) {
+      StringPool_replace(&process->cgroup, NULL);
+      StringPool_replace(&process->cgroup_short, NULL);
+      StringPool_replace(&process->container_short, NULL);
       return;
    }
+
+   char* longBuffer = NULL;
+   if ((size_t)r >= sizeof(buffer) - 1)
+      longBuffer = LinuxProcessTable_readLongProcFile(procFd, "cgroup", sizeof(buffer), &r);
+
    char output[PROC_LINE_LENGTH + 1];
    output[0] = '\0';
    char* at = output;
    int left = PROC_LINE_LENGTH;
-   while (!feof(file) && left > 0) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      const char* ok = fgets(buffer, PROC_LINE_LENGTH, file);
-      if (!ok)
-         break;
+   char* buf = longBuffer ? longBuffer : buffer;
+   char* line;
+   while (left > 0 && (line = strsep(&buf, "\n")) != NULL) {
+      if (!line[0])
+         continue;
 
-      char* group = buffer;
+      char* group = line;
       for (size_t i = 0; i < 2; i++) {
          group = String_strchrnul(group, ':');
          if (!*group)
@@ -1035,9 +1155,6 @@ static void LinuxProcessTable_readCGroupFile(LinuxProcess* process, openat_arg_t
          group++;
       }
 
-      char* eol = String_strchrnul(group, '\n');
-      *eol = '\0';
-
       if (at != output) {
          *at = ';';
          at++;
@@ -1046,12 +1163,10 @@ static void LinuxProcessTable_readCGroupFile(LinuxProcess* process, openat_arg_t
       int wrote = snprintf(at, left, "%s", group);
       left -= wrote;
    }
-   fclose(file);
-
-   bool changed = !process->cgroup || !String_eq(process->cgroup, output);
+   free(longBuffer);
 
    Row_updateFieldWidth(CGROUP, strlen(output));
-   free_and_xStrdup(&process->cgroup, output);
+   bool changed = StringPool_replace(&process->cgroup, output);
 
    if (!changed) {
       if (process->cgroup_short) {
@@ -1071,25 +1186,23 @@ static void LinuxProcessTable_readCGroupFile(LinuxProcess* process, openat_arg_t
    char* cgroup_short = CGroup_filterName(process->cgroup);
    if (cgroup_short) {
       Row_updateFieldWidth(CCGROUP, strlen(cgroup_short));
-      free_and_xStrdup(&process->cgroup_short, cgroup_short);
+      StringPool_replace(&process->cgroup_short, cgroup_short);
       free(cgroup_short);
    } else {
       //CCGROUP is alias to normal CGROUP if shortening fails
       Row_updateFieldWidth(CCGROUP, strlen(process->cgroup));
-      free(process->cgroup_short);
-      process->cgroup_short = NULL;
+      StringPool_replace(&process->cgroup_short, NULL);
    }
 
    char* container_short = CGroup_filterContainer(process->cgroup);
    if (container_short) {
       Row_updateFieldWidth(CONTAINER, strlen(container_short));
-      free_and_xStrdup(&process->container_short, container_short);
+      StringPool_replace(&process->container_short, container_short);
       free(container_short);
    } else {
       //CONTAINER is just "N/A" if shortening fails
       Row_updateFieldWidth(CONTAINER, strlen("N/A"));
-      free(process->container_short);
-      process->container_short = NULL;
+      StringPool_replace(&process->container_short, NULL);
    }
 }
 
@@ -1152,13 +1265,7 @@ static void LinuxProcessTable_readAutogroup(LinuxProcess* process, openat_arg_t
  */
 static void LinuxProcessTable_readSecattrData(LinuxProcess* process, openat_arg_t procFd, const LinuxProcess* mainTask) {
    if (mainTask) {
-      const char* mainSecAttr = mainTask->secattr;
-      if (mainSecAttr) {
-         free_and_xStrdup(&process->secattr, mainSecAttr);
-      } else {
-         free(process->secattr);
-         process->secattr = NULL;
-      }
+      StringPool_replace(&process->secattr, mainTask->secattr);
       return;
    }
 
@@ -1166,8 +1273,7 @@ static void LinuxProcessTable_readSecattrData(LinuxProcess* process, openat_arg_
 
    ssize_t attrdata = xReadfileat(procFd, "attr/current", buffer, sizeof(buffer));
    if (attrdata < 1) {
-      free(process->secattr);
-      process->secattr = NULL;
+      StringPool_replace(&process->secattr, NULL);
       return;
    }
 
@@ -1178,7 +1284,7 @@ static void LinuxProcessTable_readSecattrData(LinuxProcess* process, openat_arg_
 
    Row_updateFieldWidth(SECATTR, strlen(buffer));
 
-   free_and_xStrdup(&process->secattr, buffer);
+   StringPool_replace(&process->secattr, buffer);
 }
 
 /*
@@ -1186,13 +1292,7 @@ static void LinuxProcessTable_readSecattrData(LinuxProcess* process, openat_arg_
  */
 static void LinuxProcessTable_readCwd(LinuxProcess* process, openat_arg_t procFd, const LinuxProcess* mainTask) {
    if (mainTask) {
-      const char* mainCwd = mainTask->super.procCwd;
-      if (mainCwd) {
-         free_and_xStrdup(&process->super.procCwd, mainCwd);
-      } else {
-         free(process->super.procCwd);
-         process->super.procCwd = NULL;
-      }
+      Process_updateCwd(&process->super, mainTask->super.procCwd);
       return;
    }
 
@@ -1205,14 +1305,13 @@ static void LinuxProcessTable_readCwd(LinuxProcess* process, openat_arg_t procFd
 #endif
 
    if (r < 0) {
-      free(process->super.procCwd);
-      process->super.procCwd = NULL;
+      Process_updateCwd(&process->super, NULL);
       return;
    }
 
    pathBuffer[r] = '\0';
 
-   free_and_xStrdup(&process->super.procCwd, pathBuffer);
+   Process_updateCwd(&process->super, pathBuffer);
 }
 
 /*
@@ -1265,14 +1364,8 @@ static void LinuxProcessList_readExe(Process* process, openat_arg_t procFd, cons
 /*
  * Read /proc/<pid>/cmdline (process-shared data)
  */
-static bool LinuxProcessTable_readCmdlineFile(Process* process, openat_arg_t procFd, const LinuxProcess* mainTask) {
-   LinuxProcessList_readExe(process, procFd, mainTask);
-
-   char command[4096 + 1]; // max cmdline length on Linux
-   ssize_t amtRead = xReadfileat(procFd, "cmdline", command, sizeof(command));
-   if (amtRead <= 0)
-      return false;
-
+/* Parse amtRead bytes of /proc/<pid>/cmdline; command must have room for one byte more */
+static void LinuxProcessTable_parseCmdline(Process* process, char* command, ssize_t amtRead) {
    int tokenEnd = -1;
    int tokenStart = -1;
    int lastChar = 0;
@@ -1434,16 +1527,26 @@ static bool LinuxProcessTable_readCmdlineFile(Process* process, openat_arg_t pro
    }
 
    Process_updateCmdline(process, command, tokenStart, tokenEnd);
+}
+
+static bool LinuxProcessTable_readCmdlineFile(LinuxProcessTable* this, Process* process, openat_arg_t procFd, const LinuxProcess* mainTask) {
+   LinuxProcessList_readExe(process, procFd, mainTask);
+
+   char command[4096 + 1]; // max cmdline length on Linux
+   ssize_t amtRead = LinuxProcessTable_readProcFile(this, procFd, Process_getPid(process), "cmdline", command, sizeof(command));
+   if (amtRead <= 0)
+      return false;
 
+   LinuxProcessTable_parseCmdline(process, command, amtRead);
    return true;
 }
 
 /*
  * Read /proc/<pid>/comm (thread-specific data)
  */
-static void LinuxProcessList_readComm(Process* process, openat_arg_t procFd) {
+static void LinuxProcessList_readComm(LinuxProcessTable* this, Process* process, openat_arg_t procFd) {
    char command[4096 + 1]; // max cmdline length on Linux
-   ssize_t amtRead = xReadfileat(procFd, "comm", command, sizeof(command));
+   ssize_t amtRead = LinuxProcessTable_readProcFile(this, procFd, Process_getPid(process), "comm", command, sizeof(command));
    if (amtRead > 0) {
       command[amtRead - 1] = '\0';
       Process_updateComm(process, command);
@@ -1522,11 +1625,610 @@ static bool isOlderThan(const Process* proc, unsigned int seconds) {
    return realtime - proc->starttime_ctime > seconds;
 }
 
-static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_arg_t parentFd, const LinuxMachine* lhost, const char* dirname, const LinuxProcess* mainTask) {
-   ProcessTable* pt = (ProcessTable*) this;
-   const Machine* host = &lhost->super;
-   const Settings* settings = host->settings;
-   const ScreenSettings* ss = settings->ss;
+/* Data that is normally read only once, re-read when it is known or suspected to have changed */
+#define TASK_REFRESH_NAMES 0x1
+#define TASK_REFRESH_USER  0x2
+
+typedef struct LinuxTaskRef_ {
+   pid_t tgid;
+   pid_t tid;
+   unsigned int refresh;
+} LinuxTaskRef;
+
+/*
+ * Columns only refreshed for rows on screen, unless needed for sorting or
+ * filtering. Columns derived from the difference to the last scan are not
+ * included, as skipping scans would distort their values.
+ */
+#define LINUX_LAZY_FLAGS ( \
+   PROCESS_FLAG_CWD | \
+   PROCESS_FLAG_SCHEDPOL | \
+   PROCESS_FLAG_LINUX_IOPRIO | \
+   PROCESS_FLAG_LINUX_VSERVER | \
+   PROCESS_FLAG_LINUX_CGROUP | \
+   PROCESS_FLAG_LINUX_OOM | \
+   PROCESS_FLAG_LINUX_SMAPS | \
+   PROCESS_FLAG_LINUX_SECATTR | \
+   PROCESS_FLAG_LINUX_LRS_FIX | \
+   PROCESS_FLAG_LINUX_AUTOGROUP \
+)
+
+/*
+ * Tasks count as idle after LINUX_IDLE_SCANS scans without CPU time,
+ * context switches, IO or change of resident memory. Their stat file is
+ * still read on every scan, telling when they wake up, but the files
+ * below only every LINUX_IDLE_INTERVAL scans, spread over the scans by
+ * PID. Rates computed on such a read cover the time since the last one,
+ * and the context switches counted are averaged over the scans since then;
+ * both are kept until the next read.
+ */
+#define LINUX_IDLE_SCANS 4
+#define LINUX_IDLE_INTERVAL 4
+
+#define LINUX_IDLE_FLAGS ( \
+   LINUX_LAZY_FLAGS | \
+   PROCESS_FLAG_IO | \
+   PROCESS_FLAG_LINUX_CTXT \
+)
+
+/*
+ * Decide which data to collect: the columns shown and filtered on, and for
+ * rows that are not on screen only the cheap fields and everything the
+ * active sort key and filter depend on.
+ */
+static void LinuxProcessTable_prepareLazyFields(LinuxProcessTable* this) {
+   const Table* table = &this->super.super;
+   const Settings* settings = table->host->settings;
+   const ScreenSettings* ss = settings->ss;
+
+   const ProcessFilter* filter = ProcessTable_getFilter(&this->super);
+   const uint32_t filterFlags = filter ? filter->flags : 0;
+   this->scanFlags = ss->flags | filterFlags;
+
+   /* Recorded samples hold every process in full */
+   const bool recording = ((const LinuxMachine*) table->host)->recording;
+   this->lazyFields = settings->lazyProcessFields && table->panel && table->viewportKnown && !recording;
+   this->tieredSampling = settings->tieredProcessSampling && !recording;
+   this->scanCount++;
+   this->offscreenFlags = this->scanFlags;
+   this->offscreenNames = true;
+
+   if (!this->lazyFields)
+      return;
+
+   const RowField sortKey = ScreenSettings_getActiveSortKey(ss);
+   const uint32_t sortFlags = (sortKey > 0 && sortKey < LAST_PROCESSFIELD) ? Process_fields[sortKey].flags : 0;
+   /* rows the filter hides are never on screen, so its columns stay current for all */
+   this->offscreenFlags = (ss->flags & ~(LINUX_LAZY_FLAGS & ~sortFlags)) | filterFlags;
+   this->offscreenNames = table->incFilter || sortKey == COMM || sortKey == PROC_COMM || sortKey == PROC_EXE;
+}
+
+/* Whether a known task is idle and skips its costly files in this scan */
+static bool LinuxProcessTable_skipsIdle(const LinuxProcessTable* this, const Process* proc) {
+   if (!this->tieredSampling || !proc)
+      return false;
+
+   if (((const LinuxProcess*) proc)->idleScans < LINUX_IDLE_SCANS)
+      return false;
+
+   /* Hashed, as the PIDs of tasks started together often share a stride */
+   uint32_t slot = ((uint32_t)Process_getPid(proc) * UINT32_C(2654435761)) >> 16;
+   return (this->scanCount + slot) % LINUX_IDLE_INTERVAL != 0;
+}
+
+/* Column flags to collect for a known row, or for a new one if proc is NULL */
+static uint32_t LinuxProcessTable_rowFlags(const LinuxProcessTable* this, const Process* proc) {
+   uint32_t flags = this->scanFlags;
+   if (this->lazyFields && proc && !proc->super.inViewport)
+      flags = this->offscreenFlags;
+
+   if (LinuxProcessTable_skipsIdle(this, proc))
+      flags &= ~LINUX_IDLE_FLAGS;
+
+   return flags;
+}
+
+/* Account the reads an idle task leaves out, as flags and names would have had them */
+static void LinuxProcessTable_countIdleSkips(uint32_t flags, bool names, bool process) {
+   if (!Instrument_users)
+      return;
+
+   if (process)
+      Instrument_skip(INSTRUMENT_PROC_STATM);
+   if (names)
+      Instrument_skip(INSTRUMENT_PROC_CMDLINE);
+   if (flags & PROCESS_FLAG_LINUX_CTXT)
+      Instrument_skip(INSTRUMENT_PROC_STATUS);
+   if (flags & PROCESS_FLAG_LINUX_CGROUP)
+      Instrument_skip(INSTRUMENT_PROC_CGROUP);
+   if ((flags & PROCESS_FLAG_LINUX_SMAPS) && process)
+      Instrument_skip(INSTRUMENT_PROC_SMAPS);
+   if ((flags & PROCESS_FLAG_LINUX_LRS_FIX) && process)
+      Instrument_skip(INSTRUMENT_PROC_MAPS);
+   if (flags & PROCESS_FLAG_IO)
+      Instrument_skip(INSTRUMENT_PROC_IO);
+}
+
+typedef struct LinuxProcessSpan_ {
+   size_t from;
+   size_t to;
+} LinuxProcessSpan;
+
+#define LINUX_PROCESS_SPAN(from_, to_) { offsetof(LinuxProcess, from_), offsetof(LinuxProcess, to_) }
+
+/*
+ * Members holding the values shown for a process, leaving out the time
+ * stamps of the previous reads and the merged command, which is tracked
+ * by its own stamp. Strings are hashed by content in addition, as a
+ * replaced string may end up at the address of the one it replaces.
+ */
+static const LinuxProcessSpan LinuxProcessTable_shownSpans[] = {
+   LINUX_PROCESS_SPAN(super.pgrp, super.mergedCommand),
+   LINUX_PROCESS_SPAN(ioPriority, io_last_scan_time_ms),
+   LINUX_PROCESS_SPAN(io_rate_read_bps, last_mlrs_calctime),
+   LINUX_PROCESS_SPAN(gpu_time, gpu_activityMs),
+   LINUX_PROCESS_SPAN(autogroup_id, fdCache),
+};
+
+/* The spans above rely on the member order of LinuxProcess */
+static_assert(offsetof(LinuxProcess, super.pgrp) < offsetof(LinuxProcess, super.mergedCommand), "Process members hashed out of order");
+static_assert(offsetof(LinuxProcess, ioPriority) < offsetof(LinuxProcess, io_last_scan_time_ms), "LinuxProcess members hashed out of order");
+static_assert(offsetof(LinuxProcess, io_last_scan_time_ms) < offsetof(LinuxProcess, io_rate_read_bps), "LinuxProcess members hashed out of order");
+static_assert(offsetof(LinuxProcess, io_rate_read_bps) < offsetof(LinuxProcess, last_mlrs_calctime), "LinuxProcess members hashed out of order");
+static_assert(offsetof(LinuxProcess, last_mlrs_calctime) < offsetof(LinuxProcess, gpu_time), "LinuxProcess members hashed out of order");
+static_assert(offsetof(LinuxProcess, gpu_time) < offsetof(LinuxProcess, gpu_activityMs), "LinuxProcess members hashed out of order");
+static_assert(offsetof(LinuxProcess, gpu_activityMs) < offsetof(LinuxProcess, autogroup_id), "LinuxProcess members hashed out of order");
+static_assert(offsetof(LinuxProcess, autogroup_id) < offsetof(LinuxProcess, fdCache), "LinuxProcess members hashed out of order");
+
+static inline uint64_t LinuxProcessTable_hashBytes(uint64_t hash, const void* data, size_t size) {
+   const unsigned char* bytes = data;
+
+   for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes, sizeof(word));
+      hash = (hash ^ word) * 0x100000001b3ULL;
+   }
+   for (; size > 0; bytes++, size--)
+      hash = (hash ^ *bytes) * 0x100000001b3ULL;
+
+   return hash;
+}
+
+static inline uint64_t LinuxProcessTable_hashString(uint64_t hash, const char* str) {
+   return str ? LinuxProcessTable_hashBytes(hash, str, strlen(str)) : hash * 0x100000001b3ULL;
+}
+
+/* Changes whenever a value shown for the process changes */
+static uint64_t LinuxProcessTable_shownDigest(const LinuxProcess* lp) {
+   const Row* row = &lp->super.super;
+   uint64_t hash = 0xcbf29ce484222325ULL;
+
+   hash = LinuxProcessTable_hashBytes(hash, &row->parent, sizeof(row->parent));
+   hash = LinuxProcessTable_hashBytes(hash, &row->group, sizeof(row->group));
+
+   for (size_t i = 0; i < ARRAYSIZE(LinuxProcessTable_shownSpans); i++) {
+      const LinuxProcessSpan* span = &LinuxProcessTable_shownSpans[i];
+      hash = LinuxProcessTable_hashBytes(hash, (const char*)lp + span->from, span->to - span->from);
+   }
+
+   hash = LinuxProcessTable_hashString(hash, lp->super.tty_name);
+   hash = LinuxProcessTable_hashString(hash, lp->super.procCwd);
+   hash = LinuxProcessTable_hashString(hash, lp->cgroup);
+   hash = LinuxProcessTable_hashString(hash, lp->cgroup_short);
+   hash = LinuxProcessTable_hashString(hash, lp->container_short);
+   hash = LinuxProcessTable_hashString(hash, lp->secattr);
+#ifdef HAVE_OPENVZ
+   hash = LinuxProcessTable_hashString(hash, lp->ctid);
+#endif
+
+   return hash;
+}
+
+static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_arg_t parentFd, const LinuxMachine* lhost, const char* dirname, const LinuxProcess* mainTask);
+
+static void LinuxProcessTable_scanThreadList(LinuxProcessTable* this, openat_arg_t procFd, const LinuxMachine* lhost, const LinuxProcess* mainTask, const LinuxTaskRef* threads, size_t nThreads);
+
+static void LinuxProcessTable_scanTask(LinuxProcessTable* this, openat_arg_t dirFd, const LinuxMachine* lhost, const char* name, int pid, const LinuxProcess* mainTask, const LinuxTaskRef* threads, size_t nThreads, unsigned int refresh) {
+   ProcessTable* pt = (ProcessTable*) this;
+   const Machine* host = &lhost->super;
+   const Settings* settings = host->settings;
+   const bool hideKernelThreads = settings->hideKernelThreads;
+   const bool hideUserlandThreads = settings->hideUserlandThreads;
+   const bool hideRunningInContainer = settings->hideRunningInContainer;
+
+   bool preExisting;
+   Process* proc = ProcessTable_getProcess(pt, pid, &preExisting, LinuxProcess_new);
+   LinuxProcess* lp = (LinuxProcess*) proc;
+   /* Rows without a rendered line are drawn anew anyway, so spare hashing them */
+   const bool cached = preExisting && Row_hasLineCache(&proc->super);
+   const uint64_t shownDigest = cached ? LinuxProcessTable_shownDigest(lp) : 0;
+
+#ifdef HAVE_OPENAT
+   int procFd = ProcFdCache_get(&this->fdCache, &lp->fdCache, PROC_FD_DIR);
+   bool procFdCached = procFd >= 0;
+   if (!procFdCached) {
+      procFd = openat(dirFd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+      if (procFd < 0) {
+         if (!preExisting)
+            Process_delete((Object*)proc);
+         return;
+      }
+      procFdCached = ProcFdCache_put(&this->fdCache, &lp->fdCache, PROC_FD_DIR, procFd);
+   }
+#else
+   char procFd[4096];
+   xSnprintf(procFd, sizeof(procFd), "%s/%s", dirFd, name);
+   const bool procFdCached = false;
+#endif
+
+   Process_setThreadGroup(proc, mainTask ? Process_getPid(&mainTask->super) : pid);
+   proc->isUserlandThread = Process_getPid(proc) != Process_getThreadGroup(proc);
+   assert(proc->isUserlandThread == (mainTask != NULL));
+
+   if (!mainTask) {
+      if (threads)
+         LinuxProcessTable_scanThreadList(this, procFd, lhost, lp, threads, nThreads);
+      else
+         LinuxProcessTable_recurseProcTree(this, procFd, lhost, "task", lp);
+   }
+
+   /*
+    * These conditions will not trigger on first occurrence, cause we need to
+    * add the process to the ProcessTable and do all one time scans
+    * (e.g. parsing the cmdline to detect a kernel thread)
+    * But it will short-circuit subsequent scans.
+    */
+   if (preExisting && hideKernelThreads && Process_isKernelThread(proc)) {
+      proc->super.updated = true;
+      proc->super.show = false;
+      pt->kernelThreads++;
+      pt->totalTasks++;
+      if (!procFdCached)
+         Compat_openatArgClose(procFd);
+      return;
+   }
+   if (preExisting && hideUserlandThreads && Process_isUserlandThread(proc)) {
+      proc->super.updated = true;
+      proc->super.show = false;
+      pt->userlandThreads++;
+      pt->totalTasks++;
+      if (!procFdCached)
+         Compat_openatArgClose(procFd);
+      return;
+   }
+   if (preExisting && hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
+      proc->super.updated = true;
+      proc->super.show = false;
+      if (!procFdCached)
+         Compat_openatArgClose(procFd);
+      return;
+   }
+
+   const bool scanMainThread = !hideUserlandThreads && !Process_isKernelThread(proc) && !mainTask;
+
+   /* Rows off screen only get the costly columns needed to sort them */
+   const bool offscreen = this->lazyFields && preExisting && !proc->super.inViewport;
+   /* Idle tasks only get their stat file read in most scans */
+   const bool idle = preExisting && LinuxProcessTable_skipsIdle(this, proc);
+   const uint32_t flags = LinuxProcessTable_rowFlags(this, preExisting ? proc : NULL);
+   lp->skippedFlags = offscreen ? this->scanFlags & ~this->offscreenFlags : 0;
+   const bool updateNames = settings->updateProcessNames && (!offscreen || this->offscreenNames);
+
+   if (idle) {
+      const uint32_t busyFlags = offscreen ? this->offscreenFlags : this->scanFlags;
+      LinuxProcessTable_countIdleSkips(busyFlags & LINUX_IDLE_FLAGS, updateNames && !proc->isKernelThread, !mainTask);
+   }
+
+   /* Activity since the last scan, telling whether the task is idle */
+   const long int lastResident = proc->m_resident;
+   const unsigned long lastCtxt = lp->ctxt_total;
+   const unsigned long long lastRchar = lp->io_rchar;
+   const unsigned long long lastWchar = lp->io_wchar;
+
+   uint64_t start;
+   bool ok;
+   if (!idle || mainTask) {
+      start = Instrument_start();
+      ok = LinuxProcessTable_readStatmFile(this, lp, procFd, lhost, mainTask);
+      Instrument_stop(INSTRUMENT_PROC_STATM, start);
+      if (!ok)
+         goto errorReadingProcess;
+   }
+
+   {
+      bool prev = proc->usesDeletedLib;
+
+      if ((offscreen || idle) && !(flags & PROCESS_FLAG_LINUX_LRS_FIX)) {
+         /* Keep the values of the last scan on screen */
+      } else if (!proc->isKernelThread && !proc->isUserlandThread &&
+          ((flags & PROCESS_FLAG_LINUX_LRS_FIX) || (settings->highlightDeletedExe && !proc->procExeDeleted && isOlderThan(proc, 10)))) {
+
+         // Check if we really should recalculate the M_LRS value for this process
+         uint64_t passedTimeInMs = host->realtimeMs - lp->last_mlrs_calctime;
+
+         uint64_t recheck = ((uint64_t)rand()) % 2048;
+
+         if (passedTimeInMs > recheck) {
+            lp->last_mlrs_calctime = host->realtimeMs;
+            start = Instrument_start();
+            LinuxProcessTable_readMaps(lp, procFd, lhost, flags & PROCESS_FLAG_LINUX_LRS_FIX, settings->highlightDeletedExe);
+            Instrument_stop(INSTRUMENT_PROC_MAPS, start);
+         }
+      } else {
+         /* Copy from process structure in threads and reset if setting got disabled */
+         proc->usesDeletedLib = (proc->isUserlandThread && mainTask) ? mainTask->super.usesDeletedLib : false;
+         lp->m_lrs = (proc->isUserlandThread && mainTask) ? mainTask->m_lrs : 0;
+      }
+
+      if (prev != proc->usesDeletedLib)
+         proc->mergedCommand.lastUpdate = 0;
+   }
+
+   char statCommand[MAX_NAME + 1];
+   unsigned long long int lasttimes = (lp->utime + lp->stime);
+   unsigned long int last_tty_nr = proc->tty_nr;
+   unsigned long long int laststarttime = lp->starttime;
+   start = Instrument_start();
+   ok = LinuxProcessTable_readStatFile(this, lp, procFd, lhost, scanMainThread, statCommand, sizeof(statCommand));
+   Instrument_stop(INSTRUMENT_PROC_STAT, start);
+   if (!ok)
+      goto errorReadingProcess;
+
+   if (preExisting && laststarttime != lp->starttime) {
+      /* The PID has been reused by another task since the last scan */
+      refresh |= TASK_REFRESH_NAMES | TASK_REFRESH_USER;
+      Process_fillStarttimeBuffer(proc);
+   }
+
+   if (lp->flags & PF_KTHREAD) {
+      proc->isKernelThread = true;
+   }
+
+   if (last_tty_nr != proc->tty_nr && this->ttyDrivers) {
+      free(proc->tty_name);
+      proc->tty_name = LinuxProcessTable_updateTtyDevice(this->ttyDrivers, proc->tty_nr);
+   }
+
+   proc->percent_cpu = NAN;
+   /* lhost->period might be 0 after system sleep */
+   if (lhost->period > 0.0) {
+      float percent_cpu = saturatingSub(lp->utime + lp->stime, lasttimes) / lhost->period * 100.0;
+      proc->percent_cpu = MINIMUM(percent_cpu, host->activeCPUs * 100.0F);
+   }
+   proc->percent_mem = proc->m_resident / (double)(host->totalMem) * 100.0;
+   Process_updateCPUFieldWidths(proc->percent_cpu);
+
+   if ((mainTask || !preExisting || (refresh & TASK_REFRESH_USER)) && !LinuxProcessTable_updateUser(host, proc, procFd, mainTask))
+      goto errorReadingProcess;
+
+   /* Check if the process is inside a different PID namespace. */
+   if (proc->isRunningInContainer == TRI_INITIAL && rootPidNs != (ino_t)-1) {
+      struct stat sb;
+#if defined(HAVE_OPENAT) && defined(HAVE_FSTATAT)
+      int res = fstatat(procFd, "ns/pid", &sb, 0);
+#else
+      char path[PATH_MAX];
+      xSnprintf(path, sizeof(path), "%s/ns/pid", procFd);
+      int res = stat(path, &sb);
+#endif
+      if (res == 0) {
+         proc->isRunningInContainer = (sb.st_ino != rootPidNs) ? TRI_ON : TRI_OFF;
+      }
+   }
+
+   if (flags & PROCESS_FLAG_LINUX_CTXT
+      || ((hideRunningInContainer || flags & PROCESS_FLAG_LINUX_CONTAINER) && proc->isRunningInContainer == TRI_INITIAL)
+#ifdef HAVE_VSERVER
+      || flags & PROCESS_FLAG_LINUX_VSERVER
+#endif
+   ) {
+      proc->isRunningInContainer = TRI_OFF;
+      start = Instrument_start();
+      ok = LinuxProcessTable_readStatusFile(this, proc, procFd);
+      Instrument_stop(INSTRUMENT_PROC_STATUS, start);
+      if (!ok)
+         goto errorReadingProcess;
+   }
+
+   if (!preExisting) {
+
+      #ifdef HAVE_OPENVZ
+      if (flags & PROCESS_FLAG_LINUX_OPENVZ) {
+         LinuxProcessTable_readOpenVZData(lp, procFd);
+      }
+      #endif
+
+      if (proc->isKernelThread) {
+         Process_updateCmdline(proc, NULL, 0, 0);
+      } else {
+         start = Instrument_start();
+         ok = LinuxProcessTable_readCmdlineFile(this, proc, procFd, mainTask);
+         Instrument_stop(INSTRUMENT_PROC_CMDLINE, start);
+         if (!ok) {
+            Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
+         }
+         LinuxProcessList_readComm(this, proc, procFd);
+      }
+
+      Process_fillStarttimeBuffer(proc);
+
+      ProcessTable_add(pt, proc);
+   } else {
+      if (((updateNames && !idle) || (refresh & TASK_REFRESH_NAMES)) && proc->state != ZOMBIE) {
+         if (proc->isKernelThread) {
+            Process_updateCmdline(proc, NULL, 0, 0);
+         } else {
+            start = Instrument_start();
+            ok = LinuxProcessTable_readCmdlineFile(this, proc, procFd, mainTask);
+            Instrument_stop(INSTRUMENT_PROC_CMDLINE, start);
+            if (!ok) {
+               Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
+            }
+            LinuxProcessList_readComm(this, proc, procFd);
+         }
+      }
+   }
+
+   /*
+    * Section gathering non-critical information that is independent from
+    * each other.
+    */
+
+   /* Gather permitted capabilities (thread-specific data) for non-root process. */
+   if (proc->st_uid != 0 && proc->elevated_priv != TRI_OFF) {
+      struct __user_cap_header_struct header = { .version = _LINUX_CAPABILITY_VERSION_3, .pid = Process_getPid(proc) };
+      struct __user_cap_data_struct data;
+
+      long res = syscall(SYS_capget, &header, &data);
+      if (res == 0) {
+         proc->elevated_priv = (data.permitted != 0) ? TRI_ON : TRI_OFF;
+      } else {
+         proc->elevated_priv = TRI_OFF;
+      }
+   }
+
+   if (flags & PROCESS_FLAG_LINUX_CGROUP) {
+      start = Instrument_start();
+      LinuxProcessTable_readCGroupFile(this, lp, procFd);
+      Instrument_stop(INSTRUMENT_PROC_CGROUP, start);
+   }
+
+   if ((flags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
+      if (!mainTask) {
+         // Read smaps file of each process only every second pass to improve performance
+         static int smaps_flag = 0;
+         if ((pid & 1) == smaps_flag) {
+            start = Instrument_start();
+            LinuxProcessTable_readSmapsFile(lp, procFd, this->haveSmapsRollup);
+            Instrument_stop(INSTRUMENT_PROC_SMAPS, start);
+         }
+         if (pid == 1) {
+            smaps_flag = !smaps_flag;
+         }
+      } else {
+         lp->m_pss   = mainTask->m_pss;
+         lp->m_swap  = mainTask->m_swap;
+         lp->m_psswp = mainTask->m_psswp;
+      }
+   }
+
+   if (flags & PROCESS_FLAG_IO) {
+      start = Instrument_start();
+      LinuxProcessTable_readIoFile(this, lp, procFd, scanMainThread);
+      Instrument_stop(INSTRUMENT_PROC_IO, start);
+   }
+
+   #ifdef HAVE_DELAYACCT
+   if (flags & PROCESS_FLAG_LINUX_DELAYACCT) {
+      LibNl_readDelayAcctData(this, lp);
+   }
+   #endif
+
+   if (flags & PROCESS_FLAG_LINUX_OOM) {
+      LinuxProcessTable_readOomData(lp, procFd, mainTask);
+   }
+
+   if (flags & PROCESS_FLAG_LINUX_IOPRIO) {
+      LinuxProcess_updateIOPriority(proc);
+   }
+
+   if (flags & PROCESS_FLAG_LINUX_SECATTR) {
+      LinuxProcessTable_readSecattrData(lp, procFd, mainTask);
+   }
+
+   if (flags & PROCESS_FLAG_CWD) {
+      LinuxProcessTable_readCwd(lp, procFd, mainTask);
+   }
+
+   if ((flags & PROCESS_FLAG_LINUX_AUTOGROUP) && this->haveAutogroup) {
+      LinuxProcessTable_readAutogroup(lp, procFd, mainTask);
+   }
+
+   #ifdef SCHEDULER_SUPPORT
+   if (flags & PROCESS_FLAG_SCHEDPOL) {
+      Scheduling_readProcessPolicy(proc);
+   }
+   #endif
+
+   if (flags & PROCESS_FLAG_LINUX_GPU || GPUMeter_active()) {
+      if (mainTask) {
+         lp->gpu_time = mainTask->gpu_time;
+      } else {
+         start = Instrument_start();
+         GPU_readProcessData(this, lp, procFd);
+         Instrument_stop(INSTRUMENT_PROC_GPU, start);
+      }
+   }
+
+   /*
+    * Final section after all data has been gathered
+    */
+
+   if (!proc->cmdline && statCommand[0] &&
+       (proc->state == ZOMBIE || Process_isKernelThread(proc) || settings->showThreadNames)) {
+      Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
+   }
+
+   if (!preExisting || lp->utime + lp->stime != lasttimes || proc->state == RUNNING ||
+       proc->m_resident != lastResident || lp->ctxt_total != lastCtxt ||
+       lp->io_rchar != lastRchar || lp->io_wchar != lastWchar) {
+      lp->idleScans = 0;
+   } else if (lp->idleScans < LINUX_IDLE_SCANS) {
+      lp->idleScans++;
+   }
+
+   if (!preExisting || (cached && LinuxProcessTable_shownDigest(lp) != shownDigest))
+      Row_markDirty(&proc->super);
+
+   proc->super.updated = true;
+   if (!procFdCached)
+      Compat_openatArgClose(procFd);
+
+   if (hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
+      proc->super.show = false;
+      return;
+   }
+
+   if (Process_isKernelThread(proc)) {
+      pt->kernelThreads++;
+   } else if (Process_isUserlandThread(proc)) {
+      pt->userlandThreads++;
+   }
+
+   /* Set at the end when we know if a new entry is a thread */
+   proc->super.show = ! ((hideKernelThreads && Process_isKernelThread(proc)) || (hideUserlandThreads && Process_isUserlandThread(proc)));
+
+   pt->totalTasks++;
+   /* runningTasks is set in Machine_scanCPUTime() from /proc/stat */
+   return;
+
+   // Exception handler.
+
+errorReadingProcess:
+   {
+#ifdef HAVE_OPENAT
+      if (!procFdCached)
+         close(procFd);
+      /* The cached descriptors refer to a task that went away */
+      ProcFdCacheEntry_release(&lp->fdCache);
+#endif
+
+      if (preExisting) {
+         /*
+          * The only real reason for coming here (apart from Linux violating the /proc API)
+          * would be the process going away with its /proc files disappearing (!HAVE_OPENAT).
+          * However, we want to keep in the process list for now for the "highlight dying" mode.
+          */
+      } else {
+         /* A really short-lived process that we don't have full info about */
+         assert(ProcessTable_findProcess(pt, Process_getPid(proc)) == NULL);
+         Process_delete((Object*)proc);
+      }
+   }
+}
+
+static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_arg_t parentFd, const LinuxMachine* lhost, const char* dirname, const LinuxProcess* mainTask) {
+   ProcessTable* pt = (ProcessTable*) this;
    const struct dirent* entry;
 
    /* set runningTasks from /proc/stat (from Machine_scanCPUTime) */
@@ -1547,9 +2249,6 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       return false;
    }
 
-   const bool hideKernelThreads = settings->hideKernelThreads;
-   const bool hideUserlandThreads = settings->hideUserlandThreads;
-   const bool hideRunningInContainer = settings->hideRunningInContainer;
    while ((entry = readdir(dir)) != NULL) {
       const char* name = entry->d_name;
 
@@ -1583,314 +2282,477 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       if (mainTask && pid == Process_getPid(&mainTask->super))
          continue;
 
+      LinuxProcessTable_scanTask(this, dirFd, lhost, entry->d_name, pid, mainTask, NULL, 0, TASK_REFRESH_USER);
+   }
+   closedir(dir);
+   return true;
+}
+
+static void LinuxProcessTable_scanThreadList(LinuxProcessTable* this, openat_arg_t procFd, const LinuxMachine* lhost, const LinuxProcess* mainTask, const LinuxTaskRef* threads, size_t nThreads) {
+   if (nThreads == 0)
+      return;
+
 #ifdef HAVE_OPENAT
-      int procFd = openat(dirFd, entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
-      if (procFd < 0)
-         continue;
+   int taskFd = openat(procFd, "task", O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+   if (taskFd < 0)
+      return;
 #else
-      char procFd[4096];
-      xSnprintf(procFd, sizeof(procFd), "%s/%s", dirFd, entry->d_name);
+   char taskFd[4096];
+   xSnprintf(taskFd, sizeof(taskFd), "%s/task", procFd);
 #endif
 
-      bool preExisting;
-      Process* proc = ProcessTable_getProcess(pt, pid, &preExisting, LinuxProcess_new);
-      LinuxProcess* lp = (LinuxProcess*) proc;
+   for (size_t i = 0; i < nThreads; i++) {
+      char name[16];
+      xSnprintf(name, sizeof(name), "%d", (int)threads[i].tid);
+      LinuxProcessTable_scanTask(this, taskFd, lhost, name, threads[i].tid, mainTask, NULL, 0, threads[i].refresh);
+   }
 
-      Process_setThreadGroup(proc, mainTask ? Process_getPid(&mainTask->super) : pid);
-      proc->isUserlandThread = Process_getPid(proc) != Process_getThreadGroup(proc);
-      assert(proc->isUserlandThread == (mainTask != NULL));
+   Compat_openatArgClose(taskFd);
+}
 
-      LinuxProcessTable_recurseProcTree(this, procFd, lhost, "task", lp);
+#ifdef HAVE_PROC_CONNECTOR
 
-      /*
-       * These conditions will not trigger on first occurrence, cause we need to
-       * add the process to the ProcessTable and do all one time scans
-       * (e.g. parsing the cmdline to detect a kernel thread)
-       * But it will short-circuit subsequent scans.
-       */
-      if (preExisting && hideKernelThreads && Process_isKernelThread(proc)) {
-         proc->super.updated = true;
-         proc->super.show = false;
-         pt->kernelThreads++;
-         pt->totalTasks++;
-         Compat_openatArgClose(procFd);
-         continue;
-      }
-      if (preExisting && hideUserlandThreads && Process_isUserlandThread(proc)) {
-         proc->super.updated = true;
-         proc->super.show = false;
-         pt->userlandThreads++;
-         pt->totalTasks++;
-         Compat_openatArgClose(procFd);
-         continue;
-      }
-      if (preExisting && hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
-         proc->super.updated = true;
-         proc->super.show = false;
-         Compat_openatArgClose(procFd);
-         continue;
-      }
+static int LinuxTaskRef_compare(const void* va, const void* vb) {
+   const LinuxTaskRef* a = va;
+   const LinuxTaskRef* b = vb;
 
-      const bool scanMainThread = !hideUserlandThreads && !Process_isKernelThread(proc) && !mainTask;
+   if (a->tgid != b->tgid)
+      return a->tgid < b->tgid ? -1 : 1;
 
-      if (!LinuxProcessTable_readStatmFile(lp, procFd, lhost, mainTask))
-         goto errorReadingProcess;
+   /* The main thread comes first within its thread group */
+   bool aMain = a->tid == a->tgid;
+   bool bMain = b->tid == b->tgid;
+   if (aMain != bMain)
+      return aMain ? -1 : 1;
 
-      {
-         bool prev = proc->usesDeletedLib;
+   return (a->tid > b->tid) - (a->tid < b->tid);
+}
 
-         if (!proc->isKernelThread && !proc->isUserlandThread &&
-             ((ss->flags & PROCESS_FLAG_LINUX_LRS_FIX) || (settings->highlightDeletedExe && !proc->procExeDeleted && isOlderThan(proc, 10)))) {
+static unsigned int LinuxProcessTable_eventRefresh(uint32_t events) {
+   unsigned int refresh = 0;
+   if (events & (PROC_CONNECTOR_FORK | PROC_CONNECTOR_EXEC | PROC_CONNECTOR_COMM))
+      refresh |= TASK_REFRESH_NAMES;
+   if (events & (PROC_CONNECTOR_FORK | PROC_CONNECTOR_EXEC | PROC_CONNECTOR_ID))
+      refresh |= TASK_REFRESH_USER;
+   return refresh;
+}
 
-            // Check if we really should recalculate the M_LRS value for this process
-            uint64_t passedTimeInMs = host->realtimeMs - lp->last_mlrs_calctime;
+static void LinuxProcessTable_addTaskRef(LinuxProcessTable* this, pid_t tgid, pid_t tid, unsigned int refresh) {
+   if (this->taskRefsCount == this->taskRefsSize) {
+      this->taskRefsSize = this->taskRefsSize ? this->taskRefsSize * 2 : 256;
+      this->taskRefs = xReallocArray(this->taskRefs, this->taskRefsSize, sizeof(LinuxTaskRef));
+   }
 
-            uint64_t recheck = ((uint64_t)rand()) % 2048;
+   this->taskRefs[this->taskRefsCount++] = (LinuxTaskRef) {
+      .tgid = tgid,
+      .tid = tid,
+      .refresh = refresh,
+   };
+}
 
-            if (passedTimeInMs > recheck) {
-               lp->last_mlrs_calctime = host->realtimeMs;
-               LinuxProcessTable_readMaps(lp, procFd, lhost, ss->flags & PROCESS_FLAG_LINUX_LRS_FIX, settings->highlightDeletedExe);
-            }
-         } else {
-            /* Copy from process structure in threads and reset if setting got disabled */
-            proc->usesDeletedLib = (proc->isUserlandThread && mainTask) ? mainTask->super.usesDeletedLib : false;
-            lp->m_lrs = (proc->isUserlandThread && mainTask) ? mainTask->m_lrs : 0;
-         }
+/*
+ * Add a row for a process that forked or executed and exited since the last
+ * scan, from the files read right after the event. It shows as dead until
+ * the next scan finds it gone like any other exited process.
+ */
+static void LinuxProcessTable_addExitedTask(LinuxProcessTable* this, const ProcConnectorTask* task) {
+   ProcessTable* pt = &this->super;
+   const LinuxMachine* lhost = (const LinuxMachine*) pt->super.host;
+   const Machine* host = &lhost->super;
+   const Settings* settings = host->settings;
+   const ProcConnectorSnapshot* snapshot = task->snapshot;
 
-         if (prev != proc->usesDeletedLib)
-            proc->mergedCommand.lastUpdate = 0;
-      }
+   bool preExisting;
+   Process* proc = ProcessTable_getProcess(pt, task->tid, &preExisting, LinuxProcess_new);
+   LinuxProcess* lp = (LinuxProcess*) proc;
+   assert(!preExisting);
 
-      char statCommand[MAX_NAME + 1];
-      unsigned long long int lasttimes = (lp->utime + lp->stime);
-      unsigned long int last_tty_nr = proc->tty_nr;
-      if (!LinuxProcessTable_readStatFile(lp, procFd, lhost, scanMainThread, statCommand, sizeof(statCommand)))
-         goto errorReadingProcess;
+   char stat[MAX_READ + 1];
+   memcpy(stat, snapshot->data, snapshot->statLen + 1);
 
-      if (lp->flags & PF_KTHREAD) {
-         proc->isKernelThread = true;
-      }
+   char statCommand[MAX_NAME + 1];
+   if (!LinuxProcessTable_parseStat(lp, stat, snapshot->statLen, lhost, statCommand, sizeof(statCommand))) {
+      Process_delete((Object*)proc);
+      return;
+   }
+
+   Process_setThreadGroup(proc, task->tgid);
+   proc->isUserlandThread = false;
+   proc->isKernelThread = lp->flags & PF_KTHREAD;
+   proc->state = DEFUNCT;
+   proc->st_uid = snapshot->uid;
+   proc->user = UsersTable_getRef(host->usersTable, snapshot->uid);
+
+   if (proc->tty_nr != 0 && this->ttyDrivers)
+      proc->tty_name = LinuxProcessTable_updateTtyDevice(this->ttyDrivers, proc->tty_nr);
+
+   /* Nothing is known of the time it ran after the snapshot */
+   proc->percent_cpu = NAN;
+   proc->percent_mem = 0.0;
+
+   if (proc->isKernelThread) {
+      Process_updateCmdline(proc, NULL, 0, 0);
+   } else if (snapshot->cmdlineLen > 0) {
+      char command[4096 + 1];
+      const size_t len = MINIMUM(snapshot->cmdlineLen, sizeof(command) - 1);
+      memcpy(command, snapshot->data + snapshot->statLen + 1, len);
+      LinuxProcessTable_parseCmdline(proc, command, (ssize_t)len);
+   } else {
+      Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
+   }
+   Process_updateComm(proc, snapshot->comm[0] ? snapshot->comm : NULL);
+
+   Process_fillStarttimeBuffer(proc);
+   ProcessTable_add(pt, proc);
+   Row_markDirty(&proc->super);
+
+   proc->super.updated = true;
+   proc->super.show = !(settings->hideKernelThreads && proc->isKernelThread);
+   if (proc->isKernelThread)
+      pt->kernelThreads++;
+   pt->totalTasks++;
+}
+
+static void LinuxProcessTable_addNewTask(const ProcConnectorTask* task, void* data) {
+   LinuxProcessTable* this = data;
+   const bool known = Hashtable_get(this->super.super.table, (ht_key_t)task->tid);
+
+   if (task->events & PROC_CONNECTOR_EXIT) {
+      /* Gone before this scan, so only known from what was read at its fork or exec */
+      if (!known && task->snapshot && task->tid == task->tgid)
+         LinuxProcessTable_addExitedTask(this, task);
+      return;
+   }
+
+   /* Tasks already known are added while walking the process table */
+   if (known)
+      return;
+
+   LinuxProcessTable_addTaskRef(this, task->tgid, task->tid, TASK_REFRESH_NAMES | TASK_REFRESH_USER);
+}
+
+/*
+ * Update the process table from the tasks known from the last scan and the
+ * events reported by the proc connector since, without enumerating /proc.
+ * Processes both forked and exited since are added from the files read when
+ * they forked or executed; threads doing so are left out.
+ * Returns false if a full scan is needed, e.g. when the connector is not
+ * available or events got lost.
+ */
+static bool LinuxProcessTable_scanTrackedTasks(LinuxProcessTable* this, openat_arg_t rootFd, const LinuxMachine* lhost) {
+   ProcessTable* pt = &this->super;
+   const Settings* settings = lhost->super.settings;
+
+   if (!settings->trackProcessEvents) {
+      ProcConnector_delete(this->procConnector);
+      this->procConnector = NULL;
+      this->procConnectorFailed = false;
+      return false;
+   }
 
-      if (last_tty_nr != proc->tty_nr && this->ttyDrivers) {
-         free(proc->tty_name);
-         proc->tty_name = LinuxProcessTable_updateTtyDevice(this->ttyDrivers, proc->tty_nr);
+   if (!this->procConnector) {
+      if (this->procConnectorFailed)
+         return false;
+
+      this->procConnector = ProcConnector_new();
+      if (!this->procConnector) {
+         this->procConnectorFailed = true;
+         return false;
       }
+   }
 
-      proc->percent_cpu = NAN;
-      /* lhost->period might be 0 after system sleep */
-      if (lhost->period > 0.0) {
-         float percent_cpu = saturatingSub(lp->utime + lp->stime, lasttimes) / lhost->period * 100.0;
-         proc->percent_cpu = MINIMUM(percent_cpu, host->activeCPUs * 100.0F);
+   ProcConnector* connector = this->procConnector;
+   if (!ProcConnector_drain(connector)) {
+      ProcConnector_clear(connector);
+      return false;
+   }
+
+   this->taskRefsCount = 0;
+
+   const Vector* rows = pt->super.rows;
+   for (int i = 0; i < Vector_size(rows); i++) {
+      const Process* proc = (const Process*) Vector_get(rows, i);
+
+      /* Already gone, only kept for highlighting */
+      if (proc->super.tombStampMs > 0)
+         continue;
+
+      pid_t tid = Process_getPid(proc);
+      pid_t tgid = Process_getThreadGroup(proc);
+      unsigned int refresh = 0;
+
+      const ProcConnectorTask* task = ProcConnector_getTask(connector, tid);
+      if (task) {
+         if (task->events & PROC_CONNECTOR_EXIT)
+            continue;
+
+         tgid = task->tgid;
+         refresh = LinuxProcessTable_eventRefresh(task->events);
       }
-      proc->percent_mem = proc->m_resident / (double)(host->totalMem) * 100.0;
-      Process_updateCPUFieldWidths(proc->percent_cpu);
 
-      if (!LinuxProcessTable_updateUser(host, proc, procFd, mainTask))
-         goto errorReadingProcess;
+      LinuxProcessTable_addTaskRef(this, tgid, tid, refresh);
+   }
 
-      /* Check if the process is inside a different PID namespace. */
-      if (proc->isRunningInContainer == TRI_INITIAL && rootPidNs != (ino_t)-1) {
-         struct stat sb;
-#if defined(HAVE_OPENAT) && defined(HAVE_FSTATAT)
-         int res = fstatat(procFd, "ns/pid", &sb, 0);
+   ProcConnector_foreach(connector, LinuxProcessTable_addNewTask, this);
+   ProcConnector_clear(connector);
+
+   qsort(this->taskRefs, this->taskRefsCount, sizeof(LinuxTaskRef), LinuxTaskRef_compare);
+
+   pt->runningTasks = lhost->runningTasks;
+
+#ifdef HAVE_OPENAT
+   int dirFd = openat(rootFd, PROCDIR, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+   if (dirFd < 0)
+      return false;
 #else
-         char path[PATH_MAX];
-         xSnprintf(path, sizeof(path), "%s/ns/pid", procFd);
-         int res = stat(path, &sb);
+   char dirFd[4096];
+   xSnprintf(dirFd, sizeof(dirFd), "%s/%s", rootFd, PROCDIR);
 #endif
-         if (res == 0) {
-            proc->isRunningInContainer = (sb.st_ino != rootPidNs) ? TRI_ON : TRI_OFF;
-         }
-      }
 
-      if (ss->flags & PROCESS_FLAG_LINUX_CTXT
-         || ((hideRunningInContainer || ss->flags & PROCESS_FLAG_LINUX_CONTAINER) && proc->isRunningInContainer == TRI_INITIAL)
+   for (size_t i = 0; i < this->taskRefsCount; ) {
+      pid_t tgid = this->taskRefs[i].tgid;
+
+      /* Scan the main thread even if only other threads of the group are known */
+      unsigned int refresh = TASK_REFRESH_NAMES | TASK_REFRESH_USER;
+      if (this->taskRefs[i].tid == tgid)
+         refresh = this->taskRefs[i++].refresh;
+
+      size_t first = i;
+      while (i < this->taskRefsCount && this->taskRefs[i].tgid == tgid)
+         i++;
+
+      char name[16];
+      xSnprintf(name, sizeof(name), "%d", (int)tgid);
+      LinuxProcessTable_scanTask(this, dirFd, lhost, name, tgid, NULL, &this->taskRefs[first], i - first, refresh);
+   }
+
+   Compat_openatArgClose(dirFd);
+   return true;
+}
+
+#endif /* HAVE_PROC_CONNECTOR */
+
+#ifdef HAVE_SCAN_THREADS
+
+/*
+ * Decide which files a scan worker prefetches for a task, mirroring the
+ * conditions of LinuxProcessTable_recurseProcTree. Runs in the worker
+ * threads, so only reads the process table and settings.
+ */
+static uint32_t LinuxProcessTable_selectPrefetch(void* data, pid_t tid, pid_t tgid) {
+   LinuxProcessTable* this = data;
+   ProcessTable* pt = &this->super;
+   const Settings* settings = pt->super.host->settings;
+   const bool isThread = tid != tgid;
+
+   const Process* proc = (const Process*) Hashtable_get(pt->super.table, (ht_key_t)tid);
+   if (proc) {
+      if (settings->hideKernelThreads && Process_isKernelThread(proc))
+         return 0;
+      if (settings->hideUserlandThreads && Process_isUserlandThread(proc))
+         return 0;
+      if (settings->hideRunningInContainer && proc->isRunningInContainer == TRI_ON)
+         return 0;
+   }
+
+   const bool isKernelThread = proc && Process_isKernelThread(proc);
+   const bool idle = LinuxProcessTable_skipsIdle(this, proc);
+   const uint32_t flags = LinuxProcessTable_rowFlags(this, proc);
+   const bool updateNames = settings->updateProcessNames && !idle && (!this->lazyFields || this->offscreenNames || (proc && proc->super.inViewport));
+
+   uint32_t files = PROCSCAN_STAT;
+   if (!isThread && !settings->hideUserlandThreads && !isKernelThread)
+      files |= PROCSCAN_MAIN_THREAD;
+   if (!isThread && !idle)
+      files |= PROCSCAN_STATM;
+
+   if (flags & PROCESS_FLAG_LINUX_CTXT
+      || ((settings->hideRunningInContainer || flags & PROCESS_FLAG_LINUX_CONTAINER) && (!proc || proc->isRunningInContainer == TRI_INITIAL))
 #ifdef HAVE_VSERVER
-         || ss->flags & PROCESS_FLAG_LINUX_VSERVER
+      || flags & PROCESS_FLAG_LINUX_VSERVER
 #endif
-      ) {
-         proc->isRunningInContainer = TRI_OFF;
-         if (!LinuxProcessTable_readStatusFile(proc, procFd))
-            goto errorReadingProcess;
-      }
+   ) {
+      files |= PROCSCAN_STATUS;
+   }
 
-      if (!preExisting) {
+   if (!isKernelThread && (!proc || (updateNames && proc->state != ZOMBIE)))
+      files |= PROCSCAN_CMDLINE | PROCSCAN_COMM;
+   if (flags & PROCESS_FLAG_LINUX_CGROUP)
+      files |= PROCSCAN_CGROUP;
+   if (flags & PROCESS_FLAG_IO)
+      files |= PROCSCAN_IO;
 
-         #ifdef HAVE_OPENVZ
-         if (ss->flags & PROCESS_FLAG_LINUX_OPENVZ) {
-            LinuxProcessTable_readOpenVZData(lp, procFd);
-         }
-         #endif
+   return files;
+}
 
-         if (proc->isKernelThread) {
-            Process_updateCmdline(proc, NULL, 0, 0);
-         } else {
-            if (!LinuxProcessTable_readCmdlineFile(proc, procFd, mainTask)) {
-               Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
-            }
-            LinuxProcessList_readComm(proc, procFd);
-         }
+static void LinuxProcessTable_prefetch(LinuxProcessTable* this, unsigned int threads) {
+   if (this->scanPool && (threads <= 1 || ProcScanPool_threads(this->scanPool) != threads)) {
+      ProcScanPool_delete(this->scanPool);
+      this->scanPool = NULL;
+   }
 
-         Process_fillStarttimeBuffer(proc);
+   if (threads <= 1)
+      return;
 
-         ProcessTable_add(pt, proc);
-      } else {
-         if (settings->updateProcessNames && proc->state != ZOMBIE) {
-            if (proc->isKernelThread) {
-               Process_updateCmdline(proc, NULL, 0, 0);
-            } else {
-               if (!LinuxProcessTable_readCmdlineFile(proc, procFd, mainTask)) {
-                  Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
-               }
-               LinuxProcessList_readComm(proc, procFd);
-            }
-         }
-      }
+   if (!this->scanPool)
+      this->scanPool = ProcScanPool_new(threads);
 
-      /*
-       * Section gathering non-critical information that is independent from
-       * each other.
-       */
+   ProcScanPool_run(this->scanPool, PROCDIR, LinuxProcessTable_selectPrefetch, this);
+}
 
-      /* Gather permitted capabilities (thread-specific data) for non-root process. */
-      if (proc->st_uid != 0 && proc->elevated_priv != TRI_OFF) {
-         struct __user_cap_header_struct header = { .version = _LINUX_CAPABILITY_VERSION_3, .pid = Process_getPid(proc) };
-         struct __user_cap_data_struct data;
+#endif /* HAVE_SCAN_THREADS */
 
-         long res = syscall(SYS_capget, &header, &data);
-         if (res == 0) {
-            proc->elevated_priv = (data.permitted != 0) ? TRI_ON : TRI_OFF;
-         } else {
-            proc->elevated_priv = TRI_OFF;
-         }
-      }
+#ifdef HAVE_OPENAT
 
-      if (ss->flags & PROCESS_FLAG_LINUX_CGROUP)
-         LinuxProcessTable_readCGroupFile(lp, procFd);
+static void LinuxProcessTable_addBatchRead(LinuxReadBatch* batch, LinuxBatchedTask* task, LinuxBatchFile file, int dir, const char* path, int fd) {
+   assert(batch->count < batch->size);
+
+   task->reads[file] = (int)batch->count;
+   batch->reads[batch->count++] = (BatchRead) {
+      .dir = dir,
+      .path = path,
+      .fd = fd,
+      .buffer = NULL,
+      .size = batchFileSizes[file],
+      .result = -EINVAL,
+   };
+}
 
-      if ((ss->flags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
-         if (!mainTask) {
-            // Read smaps file of each process only every second pass to improve performance
-            static int smaps_flag = 0;
-            if ((pid & 1) == smaps_flag) {
-               LinuxProcessTable_readSmapsFile(lp, procFd, this->haveSmapsRollup);
-            }
-            if (pid == 1) {
-               smaps_flag = !smaps_flag;
-            }
-         } else {
-            lp->m_pss   = mainTask->m_pss;
-            lp->m_swap  = mainTask->m_swap;
-            lp->m_psswp = mainTask->m_psswp;
-         }
-      }
+/*
+ * Read the per-refresh files of all known tasks, whose descriptors are
+ * cached, in one batch. Only worth it with an asynchronous reader and
+ * when no scan workers prefetch the files anyway.
+ */
+static void LinuxProcessTable_readBatch(LinuxProcessTable* this) {
+   LinuxReadBatch* batch = &this->readBatch;
+   const Table* table = &this->super.super;
+   const Settings* settings = table->host->settings;
 
-      if (ss->flags & PROCESS_FLAG_IO) {
-         LinuxProcessTable_readIoFile(lp, procFd, scanMainThread);
-      }
+   if (!BatchReader_isAsync(this->batchReader))
+      return;
 
-      #ifdef HAVE_DELAYACCT
-      if (ss->flags & PROCESS_FLAG_LINUX_DELAYACCT) {
-         LibNl_readDelayAcctData(this, lp);
-      }
-      #endif
+#ifdef HAVE_SCAN_THREADS
+   if (settings->scanThreads > 1)
+      return;
+#endif
 
-      if (ss->flags & PROCESS_FLAG_LINUX_OOM) {
-         LinuxProcessTable_readOomData(lp, procFd, mainTask);
-      }
+   size_t nRows = (size_t)Vector_size(table->rows);
+   if (nRows == 0)
+      return;
 
-      if (ss->flags & PROCESS_FLAG_LINUX_IOPRIO) {
-         LinuxProcess_updateIOPriority(proc);
-      }
+   if (batch->tasksSize < nRows) {
+      batch->tasksSize = nRows;
+      batch->tasks = xReallocArray(batch->tasks, nRows, sizeof(LinuxBatchedTask));
+   }
+   if (batch->size < nRows * BATCH_FILES) {
+      batch->size = nRows * BATCH_FILES;
+      batch->reads = xReallocArray(batch->reads, batch->size, sizeof(BatchRead));
+   }
+   if (!batch->index)
+      batch->index = Hashtable_new(nRows, false);
 
-      if (ss->flags & PROCESS_FLAG_LINUX_SECATTR) {
-         LinuxProcessTable_readSecattrData(lp, procFd, mainTask);
-      }
+   size_t nTasks = 0;
+   batch->count = 0;
+   for (size_t i = 0; i < nRows; i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(table->rows, (int)i);
+      const Process* proc = &lp->super;
 
-      if (ss->flags & PROCESS_FLAG_CWD) {
-         LinuxProcessTable_readCwd(lp, procFd, mainTask);
-      }
+      if (!lp->fdCache.cache)
+         continue;
+      if (settings->hideKernelThreads && Process_isKernelThread(proc))
+         continue;
+      if (settings->hideUserlandThreads && Process_isUserlandThread(proc))
+         continue;
+      if (settings->hideRunningInContainer && proc->isRunningInContainer == TRI_ON)
+         continue;
 
-      if ((ss->flags & PROCESS_FLAG_LINUX_AUTOGROUP) && this->haveAutogroup) {
-         LinuxProcessTable_readAutogroup(lp, procFd, mainTask);
-      }
+      const uint32_t flags = LinuxProcessTable_rowFlags(this, proc);
+      const bool needStatus = flags & PROCESS_FLAG_LINUX_CTXT
+         || ((settings->hideRunningInContainer || flags & PROCESS_FLAG_LINUX_CONTAINER) && proc->isRunningInContainer == TRI_INITIAL)
+#ifdef HAVE_VSERVER
+         || flags & PROCESS_FLAG_LINUX_VSERVER
+#endif
+         ;
 
-      #ifdef SCHEDULER_SUPPORT
-      if (ss->flags & PROCESS_FLAG_SCHEDPOL) {
-         Scheduling_readProcessPolicy(proc);
-      }
-      #endif
+      LinuxBatchedTask* task = &batch->tasks[nTasks];
+      for (size_t f = 0; f < BATCH_FILES; f++)
+         task->reads[f] = -1;
 
-      if (ss->flags & PROCESS_FLAG_LINUX_GPU || GPUMeter_active()) {
-         if (mainTask) {
-            lp->gpu_time = mainTask->gpu_time;
-         } else {
-            GPU_readProcessData(this, lp, procFd);
-         }
-      }
+      const size_t first = batch->count;
 
-      /*
-       * Final section after all data has been gathered
-       */
+      /* Not touching the cache entries; that happens when the batched data is used */
+      int fd = lp->fdCache.fds[PROC_FD_STAT];
+      if (fd >= 0)
+         LinuxProcessTable_addBatchRead(batch, task, BATCH_STAT, AT_FDCWD, NULL, fd);
 
-      if (!proc->cmdline && statCommand[0] &&
-          (proc->state == ZOMBIE || Process_isKernelThread(proc) || settings->showThreadNames)) {
-         Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
-      }
+      fd = lp->fdCache.fds[PROC_FD_TASK_STAT];
+      const bool mainThreadStat = fd >= 0;
+      if (fd >= 0)
+         LinuxProcessTable_addBatchRead(batch, task, BATCH_TASK_STAT, AT_FDCWD, NULL, fd);
 
-      proc->super.updated = true;
-      Compat_openatArgClose(procFd);
+      fd = lp->fdCache.fds[PROC_FD_STATM];
+      if (fd >= 0 && !LinuxProcessTable_skipsIdle(this, proc))
+         LinuxProcessTable_addBatchRead(batch, task, BATCH_STATM, AT_FDCWD, NULL, fd);
 
-      if (hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
-         proc->super.show = false;
-         continue;
+      int dirFd = lp->fdCache.fds[PROC_FD_DIR];
+      if (dirFd >= 0) {
+         /* Processes showing their main thread separately read the io file of that */
+         if (flags & PROCESS_FLAG_IO && !mainThreadStat)
+            LinuxProcessTable_addBatchRead(batch, task, BATCH_IO, dirFd, "io", -1);
+
+         if (needStatus)
+            LinuxProcessTable_addBatchRead(batch, task, BATCH_STATUS, dirFd, "status", -1);
       }
 
-      if (Process_isKernelThread(proc)) {
-         pt->kernelThreads++;
-      } else if (Process_isUserlandThread(proc)) {
-         pt->userlandThreads++;
+      if (batch->count > first) {
+         Hashtable_put(batch->index, (ht_key_t)Process_getPid(proc), task);
+         nTasks++;
       }
+   }
 
-      /* Set at the end when we know if a new entry is a thread */
-      proc->super.show = ! ((hideKernelThreads && Process_isKernelThread(proc)) || (hideUserlandThreads && Process_isUserlandThread(proc)));
+   size_t bufferSize = 0;
+   for (size_t i = 0; i < batch->count; i++)
+      bufferSize += batch->reads[i].size;
 
-      pt->totalTasks++;
-      /* runningTasks is set in Machine_scanCPUTime() from /proc/stat */
-      continue;
+   if (batch->bufferSize < bufferSize) {
+      batch->bufferSize = bufferSize;
+      free(batch->buffer);
+      batch->buffer = xMalloc(bufferSize);
+   }
 
-      // Exception handler.
+   char* buffer = batch->buffer;
+   for (size_t i = 0; i < batch->count; i++) {
+      batch->reads[i].buffer = buffer;
+      buffer += batch->reads[i].size;
+   }
 
-errorReadingProcess:
-      {
-#ifdef HAVE_OPENAT
-         if (procFd >= 0)
-            close(procFd);
-#endif
+   BatchReader_run(this->batchReader, batch->reads, batch->count);
+}
 
-         if (preExisting) {
-            /*
-             * The only real reason for coming here (apart from Linux violating the /proc API)
-             * would be the process going away with its /proc files disappearing (!HAVE_OPENAT).
-             * However, we want to keep in the process list for now for the "highlight dying" mode.
-             */
-         } else {
-            /* A really short-lived process that we don't have full info about */
-            assert(ProcessTable_findProcess(pt, Process_getPid(proc)) == NULL);
-            Process_delete((Object*)proc);
-         }
-      }
-   }
-   closedir(dir);
-   return true;
+static void LinuxProcessTable_clearBatch(LinuxProcessTable* this) {
+   LinuxReadBatch* batch = &this->readBatch;
+   if (batch->count == 0)
+      return;
+
+   batch->count = 0;
+   Hashtable_clear(batch->index);
 }
 
+#endif /* HAVE_OPENAT */
+
 void ProcessTable_goThroughEntries(ProcessTable* super) {
    LinuxProcessTable* this = (LinuxProcessTable*) super;
    Machine* host = super->super.host;
    const Settings* settings = host->settings;
    LinuxMachine* lhost = (LinuxMachine*) host;
 
+   if (lhost->recording && Recording_isReplay(lhost->recording)) {
+      Recording_readFrame(lhost->recording, lhost, super);
+      return;
+   }
+
+   LinuxProcessTable_prepareLazyFields(this);
+
    if (settings->ss->flags & PROCESS_FLAG_LINUX_AUTOGROUP) {
       // Refer to sched(7) 'autogroup feature' section
       // The kernel feature can be enabled/disabled through procfs at
@@ -1912,6 +2774,10 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
       }
    }
 
+#ifdef HAVE_OPENAT
+   ProcFdCache_newCycle(&this->fdCache);
+#endif
+
    /* PROCDIR is an absolute path */
    assert(PROCDIR[0] == '/');
 #ifdef HAVE_OPENAT
@@ -1920,5 +2786,33 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
    openat_arg_t rootFd = "";
 #endif
 
-   LinuxProcessTable_recurseProcTree(this, rootFd, lhost, PROCDIR, NULL);
+#ifdef HAVE_OPENAT
+   LinuxProcessTable_readBatch(this);
+#endif
+
+   bool scanned = false;
+
+#ifdef HAVE_PROC_CONNECTOR
+   scanned = LinuxProcessTable_scanTrackedTasks(this, rootFd, lhost);
+#endif
+
+   if (!scanned) {
+#ifdef HAVE_SCAN_THREADS
+      LinuxProcessTable_prefetch(this, (unsigned int)settings->scanThreads);
+#endif
+
+      LinuxProcessTable_recurseProcTree(this, rootFd, lhost, PROCDIR, NULL);
+
+#ifdef HAVE_SCAN_THREADS
+      if (this->scanPool)
+         ProcScanPool_reset(this->scanPool);
+#endif
+   }
+
+#ifdef HAVE_OPENAT
+   LinuxProcessTable_clearBatch(this);
+#endif
+
+   if (lhost->recording)
+      Recording_writeFrame(lhost->recording, lhost, super);
 }
@@ -8,9 +8,15 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "Hashtable.h"
 #include "ProcessTable.h"
 
+#include "linux/BatchReader.h"
+#include "linux/ProcFdCache.h"
+
 
 typedef struct TtyDriver_ {
    char* path;
@@ -19,6 +25,18 @@ typedef struct TtyDriver_ {
    unsigned int minorTo;
 } TtyDriver;
 
+/* Per-task files of known tasks read ahead in one batch at the start of a refresh */
+typedef struct LinuxReadBatch_ {
+   BatchRead* reads;
+   size_t count;
+   size_t size;
+   char* buffer;
+   size_t bufferSize;
+   struct LinuxBatchedTask_* tasks;
+   size_t tasksSize;
+   Hashtable* index;             /* tid to LinuxBatchedTask */
+} LinuxReadBatch;
+
 typedef struct LinuxProcessTable_ {
    ProcessTable super;
 
@@ -26,10 +44,39 @@ typedef struct LinuxProcessTable_ {
    bool haveSmapsRollup;
    bool haveAutogroup;
 
+   /* Data collected for rows on and off screen during the current scan */
+   uint32_t scanFlags;
+   bool lazyFields;
+   uint32_t offscreenFlags;
+   bool offscreenNames;
+
+   /* Idle tasks re-read their costly files only every few scans */
+   bool tieredSampling;
+   unsigned int scanCount;
+
+   BatchReader* batchReader;
+
+   #ifdef HAVE_OPENAT
+   ProcFdCache fdCache;
+   LinuxReadBatch readBatch;
+   #endif
+
    #ifdef HAVE_DELAYACCT
    struct nl_sock* netlink_socket;
    int netlink_family;
    #endif
+
+   #ifdef HAVE_PROC_CONNECTOR
+   struct ProcConnector_* procConnector;
+   bool procConnectorFailed;
+   struct LinuxTaskRef_* taskRefs;
+   size_t taskRefsCount;
+   size_t taskRefsSize;
+   #endif
+
+   #ifdef HAVE_SCAN_THREADS
+   struct ProcScanPool_* scanPool;
+   #endif
 } LinuxProcessTable;
 
 #endif
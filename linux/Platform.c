@@ -45,6 +45,7 @@ in the source distribution for its full text.
 #include "Panel.h"
 #include "PressureStallMeter.h"
 #include "ProvideCurses.h"
+#include "SelfMeter.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -52,12 +53,17 @@ in the source distribution for its full text.
 #include "UptimeMeter.h"
 #include "XUtils.h"
 #include "linux/GPUMeter.h"
+#include "linux/IODeviceMeter.h"
+#include "linux/IODevices.h"
 #include "linux/IOPriority.h"
 #include "linux/IOPriorityPanel.h"
+#include "linux/LinuxDynamicScreen.h"
 #include "linux/LinuxMachine.h"
 #include "linux/LinuxProcess.h"
+#include "linux/Recording.h"
 #include "linux/SELinuxMeter.h"
 #include "linux/SystemdMeter.h"
+#include "linux/TerminalOutputMeter.h"
 #include "linux/ZramMeter.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapStats.h"
@@ -201,12 +207,48 @@ static Htop_Reaction Platform_actionLowerAutogroupPriority(State* st) {
    return changed ? HTOP_REFRESH : HTOP_OK;
 }
 
+static Htop_Reaction Platform_stepRecording(State* st, long frames) {
+   LinuxMachine* host = (LinuxMachine*) st->host;
+
+   Recording_step(host->recording, frames);
+
+   /* Load the sample right away, also while updates are paused */
+   Machine_scanTables(st->host);
+   st->host->activeTable->needsSort = true;
+   return HTOP_RECALCULATE | HTOP_KEEP_FOLLOWING;
+}
+
+static Htop_Reaction Platform_actionRecordingPrevious(State* st) {
+   return Platform_stepRecording(st, -1);
+}
+
+static Htop_Reaction Platform_actionRecordingNext(State* st) {
+   return Platform_stepRecording(st, 1);
+}
+
+static Htop_Reaction Platform_actionRecordingBackward(State* st) {
+   const LinuxMachine* host = (const LinuxMachine*) st->host;
+   return Platform_stepRecording(st, -(long)Recording_keyframeInterval(host->recording));
+}
+
+static Htop_Reaction Platform_actionRecordingForward(State* st) {
+   const LinuxMachine* host = (const LinuxMachine*) st->host;
+   return Platform_stepRecording(st, (long)Recording_keyframeInterval(host->recording));
+}
+
 void Platform_setBindings(Htop_Action* keys) {
    keys['i'] = Platform_actionSetIOPriority;
    keys['{'] = Platform_actionLowerAutogroupPriority;
    keys['}'] = Platform_actionHigherAutogroupPriority;
    keys[KEY_F(19)] = Platform_actionLowerAutogroupPriority;  // Shift-F7
    keys[KEY_F(20)] = Platform_actionHigherAutogroupPriority; // Shift-F8
+
+   if (Recording_configuredMode() == RECORDING_REPLAY) {
+      keys['('] = Platform_actionRecordingPrevious;
+      keys[')'] = Platform_actionRecordingNext;
+      keys['b'] = Platform_actionRecordingBackward;
+      keys['f'] = Platform_actionRecordingForward;
+   }
 }
 
 const MeterClass* const Platform_meterTypes[] = {
@@ -249,15 +291,23 @@ const MeterClass* const Platform_meterTypes[] = {
    &ZramMeter_class,
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
+   &DiskIODevicesMeter_class,
+   &NetworkIODevicesMeter_class,
    &SELinuxMeter_class,
    &SystemdMeter_class,
    &SystemdUserMeter_class,
    &FileDescriptorMeter_class,
+   &SelfMeter_class,
    &GPUMeter_class,
+   &TerminalOutputMeter_class,
    NULL
 };
 
 int Platform_getUptime(void) {
+   int recorded;
+   if (Recording_getUptime(&recorded))
+      return recorded;
+
    char uptimedata[64] = {0};
 
    ssize_t uptimeread = xReadfile(PROCDIR "/uptime", uptimedata, sizeof(uptimedata));
@@ -277,6 +327,9 @@ int Platform_getUptime(void) {
 }
 
 void Platform_getLoadAverage(double* one, double* five, double* fifteen) {
+   if (Recording_getLoadAverage(one, five, fifteen))
+      return;
+
    char loaddata[128] = {0};
 
    *one = NAN;
@@ -607,76 +660,46 @@ void Platform_getFileDescriptors(double* used, double* max) {
 }
 
 bool Platform_getDiskIO(DiskIOData* data) {
-   FILE* fp = fopen(PROCDIR "/diskstats", "r");
-   if (!fp)
+   if (!(IODevices_update() & IODEVICES_DISKS))
       return false;
 
-   char lastTopDisk[32] = { '\0' };
-
    uint64_t read_sum = 0, write_sum = 0, timeSpend_sum = 0;
    uint64_t numDisks = 0;
 
-   char lineBuffer[256];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char diskname[32];
-      unsigned long long int read_tmp, write_tmp, timeSpend_tmp;
-      if (sscanf(lineBuffer, "%*d %*d %31s %*u %*u %llu %*u %*u %*u %llu %*u %*u %llu", diskname, &read_tmp, &write_tmp, &timeSpend_tmp) == 4) {
-         if (String_startsWith(diskname, "dm-"))
-            continue;
-
-         if (String_startsWith(diskname, "zram"))
-            continue;
-
-         /* only count root disks, e.g. do not count IO from sda and sda1 twice */
-         if (lastTopDisk[0] && String_startsWith(diskname, lastTopDisk))
-            continue;
-
-         /* This assumes disks are listed directly before any of their partitions */
-         String_safeStrncpy(lastTopDisk, diskname, sizeof(lastTopDisk));
+   /* only count root disks, e.g. do not count IO from sda and sda1 twice */
+   for (size_t i = 0; i < IODevices_count(); i++) {
+      const IODevice* device = IODevices_get(i);
+      if (!device->present || !device->counted || device->kind != IODEVICE_DISK)
+         continue;
 
-         read_sum += read_tmp;
-         write_sum += write_tmp;
-         timeSpend_sum += timeSpend_tmp;
-         numDisks++;
-      }
+      read_sum += device->readBytes;
+      write_sum += device->writeBytes;
+      timeSpend_sum += device->busyMs;
+      numDisks++;
    }
-   fclose(fp);
-   /* multiply with sector size */
-   data->totalBytesRead = 512 * read_sum;
-   data->totalBytesWritten = 512 * write_sum;
+
+   data->totalBytesRead = read_sum;
+   data->totalBytesWritten = write_sum;
    data->totalMsTimeSpend = timeSpend_sum;
    data->numDisks = numDisks;
    return true;
 }
 
 bool Platform_getNetworkIO(NetworkIOData* data) {
-   FILE* fp = fopen(PROCDIR "/net/dev", "r");
-   if (!fp)
+   if (!(IODevices_update() & IODEVICES_INTERFACES))
       return false;
 
-   char lineBuffer[512];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char interfaceName[32];
-      unsigned long long int bytesReceived, packetsReceived, bytesTransmitted, packetsTransmitted;
-      if (sscanf(lineBuffer, "%31s %llu %llu %*u %*u %*u %*u %*u %*u %llu %llu",
-                             interfaceName,
-                             &bytesReceived,
-                             &packetsReceived,
-                             &bytesTransmitted,
-                             &packetsTransmitted) != 5)
+   for (size_t i = 0; i < IODevices_count(); i++) {
+      const IODevice* device = IODevices_get(i);
+      if (!device->present || !device->counted || device->kind != IODEVICE_INTERFACE)
          continue;
 
-      if (String_eq(interfaceName, "lo:"))
-         continue;
-
-      data->bytesReceived += bytesReceived;
-      data->packetsReceived += packetsReceived;
-      data->bytesTransmitted += bytesTransmitted;
-      data->packetsTransmitted += packetsTransmitted;
+      data->bytesReceived += device->readBytes;
+      data->packetsReceived += device->readOps;
+      data->bytesTransmitted += device->writeBytes;
+      data->packetsTransmitted += device->writeOps;
    }
 
-   fclose(fp);
-
    return true;
 }
 
@@ -933,6 +956,9 @@ void Platform_longOptionsUsage(const char* name)
 #else
    (void) name;
 #endif
+   printf(
+"   --record=FILE                Append each sample of machine and processes to FILE\n"
+"   --replay=FILE                Show the samples recorded in FILE instead of live data\n");
 }
 
 CommandLineStatus Platform_getLongOption(int opt, int argc, char** argv) {
@@ -942,6 +968,22 @@ CommandLineStatus Platform_getLongOption(int opt, int argc, char** argv) {
 #endif
 
    switch (opt) {
+      case 161:
+      case 162:
+         if (Recording_configuredMode() != RECORDING_OFF) {
+            fprintf(stderr, "Error: only one of --record and --replay can be used.\n");
+            return STATUS_ERROR_EXIT;
+         }
+
+         if (opt == 161) {
+            Recording_configure(RECORDING_WRITE, optarg);
+         } else {
+            Recording_configure(RECORDING_REPLAY, optarg);
+            /* Nothing shown belongs to processes running now */
+            Settings_enableReadonly();
+         }
+         return STATUS_OK;
+
 #ifdef HAVE_LIBCAP
       case 160: {
          const char* mode = optarg;
@@ -1102,4 +1144,38 @@ void Platform_done(void) {
 #ifdef HAVE_SENSORS_SENSORS_H
    LibSensors_cleanup();
 #endif
+
+   IODevices_done();
+}
+
+Hashtable* Platform_dynamicColumns(void) {
+   return LinuxDynamicColumns_new();
+}
+
+void Platform_dynamicColumnsDone(Hashtable* columns) {
+   LinuxDynamicColumns_done(columns);
+}
+
+const char* Platform_dynamicColumnName(unsigned int key) {
+   return LinuxDynamicColumn_name(key);
+}
+
+Hashtable* Platform_dynamicScreens(void) {
+   return LinuxDynamicScreens_new();
+}
+
+void Platform_addDynamicScreen(ScreenSettings* ss) {
+   LinuxDynamicScreen_addDynamicScreen(ss);
+}
+
+void Platform_addDynamicScreenAvailableColumns(Panel* availableColumns, const char* screen) {
+   LinuxDynamicScreens_addAvailableColumns(availableColumns, screen);
+}
+
+void Platform_dynamicScreensDone(Hashtable* screens) {
+   LinuxDynamicScreens_done(screens);
+}
+
+void Platform_updateTables(Machine* host) {
+   LinuxDynamicScreens_appendTables(host);
 }
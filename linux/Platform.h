@@ -97,12 +97,17 @@ static inline void Platform_getRelease(char** string) {
 }
 
 #ifdef HAVE_LIBCAP
-   #define PLATFORM_LONG_OPTIONS \
+   #define PLATFORM_LONG_OPTIONS_LIBCAP \
       {"drop-capabilities", optional_argument, 0, 160},
 #else
-   #define PLATFORM_LONG_OPTIONS
+   #define PLATFORM_LONG_OPTIONS_LIBCAP
 #endif
 
+#define PLATFORM_LONG_OPTIONS \
+   PLATFORM_LONG_OPTIONS_LIBCAP \
+   {"record", required_argument, 0, 161}, \
+   {"replay", required_argument, 0, 162},
+
 void Platform_longOptionsUsage(const char* name);
 
 CommandLineStatus Platform_getLongOption(int opt, int argc, char** argv);
@@ -127,30 +132,26 @@ static inline void Platform_dynamicMeterUpdateValues(ATTR_UNUSED Meter* meter) {
 
 static inline void Platform_dynamicMeterDisplay(ATTR_UNUSED const Meter* meter, ATTR_UNUSED RichString* out) { }
 
-static inline Hashtable* Platform_dynamicColumns(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicColumns(void);
 
-static inline void Platform_dynamicColumnsDone(ATTR_UNUSED Hashtable* table) { }
+void Platform_dynamicColumnsDone(Hashtable* columns);
 
-static inline const char* Platform_dynamicColumnName(ATTR_UNUSED unsigned int key) {
-   return NULL;
-}
+const char* Platform_dynamicColumnName(unsigned int key);
 
 static inline bool Platform_dynamicColumnWriteField(ATTR_UNUSED const Process* proc, ATTR_UNUSED RichString* str, ATTR_UNUSED unsigned int key) {
    return false;
 }
 
-static inline Hashtable* Platform_dynamicScreens(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicScreens(void);
 
 static inline void Platform_defaultDynamicScreens(ATTR_UNUSED Settings* settings) { }
 
-static inline void Platform_addDynamicScreen(ATTR_UNUSED ScreenSettings* ss) { }
+void Platform_addDynamicScreen(ScreenSettings* ss);
+
+void Platform_addDynamicScreenAvailableColumns(Panel* availableColumns, const char* screen);
 
-static inline void Platform_addDynamicScreenAvailableColumns(ATTR_UNUSED Panel* availableColumns, ATTR_UNUSED const char* screen) { }
+void Platform_dynamicScreensDone(Hashtable* screens);
 
-static inline void Platform_dynamicScreensDone(ATTR_UNUSED Hashtable* screens) { }
+void Platform_updateTables(Machine* host);
 
 #endif
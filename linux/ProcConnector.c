@@ -0,0 +1,468 @@
+/*
+htop - linux/ProcConnector.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#ifndef HAVE_PROC_CONNECTOR
+#error Compiling this file requires HAVE_PROC_CONNECTOR
+#endif
+
+#include "linux/ProcConnector.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include <linux/capability.h> // raw syscall, no libcap  // IWYU pragma: keep // IWYU pragma: no_include <sys/capability.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+/* Inode numbers of the initial namespaces, see include/linux/proc_ns.h */
+#define PROC_CONNECTOR_INIT_PID_NS_INO  0xEFFFFFFCU
+#define PROC_CONNECTOR_INIT_USER_NS_INO 0xEFFFFFFDU
+
+/* Socket receive buffer to hold the events arriving while the listener reads files */
+#define PROC_CONNECTOR_RCVBUF (4 * 1024 * 1024)
+
+/* Longest command line kept for a process, as much as Linux shows in /proc/<pid>/cmdline */
+#define PROC_CONNECTOR_CMDLINE_SIZE 4096
+
+struct ProcConnector_ {
+   int fd;
+   int wakeFds[2];            /* written to stop the listener */
+   pthread_t thread;
+
+   pthread_mutex_t lock;
+   bool lost;                 /* guarded by lock */
+   Hashtable* tasks;          /* guarded by lock, filled by the listener */
+
+   Hashtable* taken;          /* handed to the caller by ProcConnector_drain */
+};
+
+static bool ProcConnector_inInitNamespace(const char* name, ino_t ino) {
+   char path[64];
+   xSnprintf(path, sizeof(path), "%s/self/ns/%s", PROCDIR, name);
+
+   struct stat sb;
+   if (stat(path, &sb) != 0)
+      return false;
+
+   return sb.st_ino == ino;
+}
+
+static bool ProcConnector_hasNetAdmin(void) {
+   struct __user_cap_header_struct header = { .version = _LINUX_CAPABILITY_VERSION_3, .pid = 0 };
+   struct __user_cap_data_struct data[_LINUX_CAPABILITY_U32S_3];
+
+   if (syscall(SYS_capget, &header, data) != 0)
+      return false;
+
+   return data[CAP_TO_INDEX(CAP_NET_ADMIN)].effective & CAP_TO_MASK(CAP_NET_ADMIN);
+}
+
+static bool ProcConnector_send(int fd, enum proc_cn_mcast_op op) {
+   union {
+      struct nlmsghdr hdr;
+      char buffer[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+   } msg;
+   memset(&msg, 0, sizeof(msg));
+
+   msg.hdr.nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(op));
+   msg.hdr.nlmsg_type = NLMSG_DONE;
+   msg.hdr.nlmsg_pid = (__u32)getpid();
+
+   struct cn_msg* cn = NLMSG_DATA(&msg.hdr);
+   cn->id.idx = CN_IDX_PROC;
+   cn->id.val = CN_VAL_PROC;
+   cn->len = sizeof(op);
+   memcpy(cn->data, &op, sizeof(op));
+
+   return send(fd, &msg, msg.hdr.nlmsg_len, 0) == (ssize_t)msg.hdr.nlmsg_len;
+}
+
+static void* ProcConnector_listen(void* data);
+
+ProcConnector* ProcConnector_new(void) {
+   /* The kernel only accepts listeners from the initial namespaces */
+   if (!ProcConnector_inInitNamespace("pid", PROC_CONNECTOR_INIT_PID_NS_INO) ||
+       !ProcConnector_inInitNamespace("user", PROC_CONNECTOR_INIT_USER_NS_INO))
+      return NULL;
+
+   if (!ProcConnector_hasNetAdmin())
+      return NULL;
+
+   int fd = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+   if (fd < 0)
+      return NULL;
+
+   int rcvbuf = PROC_CONNECTOR_RCVBUF;
+   if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) != 0)
+      (void) setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+   struct sockaddr_nl addr = {
+      .nl_family = AF_NETLINK,
+      .nl_groups = CN_IDX_PROC,
+      .nl_pid = 0,
+   };
+   if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || !ProcConnector_send(fd, PROC_CN_MCAST_LISTEN)) {
+      close(fd);
+      return NULL;
+   }
+
+   ProcConnector* this = xMalloc(sizeof(ProcConnector));
+   this->fd = fd;
+   /* Processes seen by a full scan before the subscription took effect are unknown */
+   this->lost = true;
+   this->tasks = Hashtable_new(64, true);
+   this->taken = Hashtable_new(64, true);
+   pthread_mutex_init(&this->lock, NULL);
+
+   if (pipe2(this->wakeFds, O_CLOEXEC) != 0)
+      goto fail;
+
+   /* Signals are handled by the main thread only; faults are still delivered to the faulting thread */
+   sigset_t blocked;
+   sigset_t previous;
+   sigfillset(&blocked);
+   sigdelset(&blocked, SIGSEGV);
+   sigdelset(&blocked, SIGBUS);
+   sigdelset(&blocked, SIGFPE);
+   sigdelset(&blocked, SIGILL);
+   sigdelset(&blocked, SIGABRT);
+   pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+   int res = pthread_create(&this->thread, NULL, ProcConnector_listen, this);
+   pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+   if (res != 0) {
+      close(this->wakeFds[0]);
+      close(this->wakeFds[1]);
+      goto fail;
+   }
+
+   return this;
+
+fail:
+   (void) ProcConnector_send(fd, PROC_CN_MCAST_IGNORE);
+   close(fd);
+   pthread_mutex_destroy(&this->lock);
+   Hashtable_delete(this->taken);
+   Hashtable_delete(this->tasks);
+   free(this);
+   return NULL;
+}
+
+static void ProcConnector_freeSnapshot(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   ProcConnectorTask* task = value;
+   free(task->snapshot);
+   task->snapshot = NULL;
+}
+
+void ProcConnector_delete(ProcConnector* this) {
+   if (!this)
+      return;
+
+   const char quit = 0;
+   while (write(this->wakeFds[1], &quit, sizeof(quit)) < 0 && errno == EINTR)
+      ;
+   pthread_join(this->thread, NULL);
+   close(this->wakeFds[0]);
+   close(this->wakeFds[1]);
+
+   (void) ProcConnector_send(this->fd, PROC_CN_MCAST_IGNORE);
+   close(this->fd);
+   pthread_mutex_destroy(&this->lock);
+
+   Hashtable_foreach(this->tasks, ProcConnector_freeSnapshot, NULL);
+   Hashtable_delete(this->tasks);
+   Hashtable_foreach(this->taken, ProcConnector_freeSnapshot, NULL);
+   Hashtable_delete(this->taken);
+   free(this);
+}
+
+static ProcConnectorTask* ProcConnector_getOrAddTask(ProcConnector* this, pid_t tid, pid_t tgid) {
+   ProcConnectorTask* task = Hashtable_get(this->tasks, (ht_key_t)tid);
+   if (!task) {
+      task = xMalloc(sizeof(ProcConnectorTask));
+      task->tid = tid;
+      task->events = 0;
+      task->snapshot = NULL;
+      Hashtable_put(this->tasks, (ht_key_t)tid, task);
+   }
+   task->tgid = tgid;
+   return task;
+}
+
+static ssize_t ProcConnector_readFile(int dirFd, const char* name, char* buffer, size_t size) {
+   int fd = openat(dirFd, name, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return -1;
+
+   ssize_t total = 0;
+   while ((size_t)total < size) {
+      ssize_t r = read(fd, buffer + total, size - (size_t)total);
+      if (r < 0 && errno == EINTR)
+         continue;
+      if (r <= 0)
+         break;
+      total += r;
+   }
+
+   close(fd);
+   return total;
+}
+
+/* Reads the files of a process that just forked or executed, before it may exit */
+static ProcConnectorSnapshot* ProcConnector_takeSnapshot(pid_t pid) {
+   char path[32];
+   xSnprintf(path, sizeof(path), "%s/%d", PROCDIR, (int)pid);
+
+   int dirFd = open(path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+   if (dirFd < 0)
+      return NULL;
+
+   ProcConnectorSnapshot* snapshot = NULL;
+   char stat[MAX_READ + 1];
+   char cmdline[PROC_CONNECTOR_CMDLINE_SIZE];
+   char comm[sizeof(snapshot->comm)];
+
+   struct stat sb;
+   ssize_t statLen = ProcConnector_readFile(dirFd, "stat", stat, sizeof(stat) - 1);
+   if (statLen <= 0 || fstat(dirFd, &sb) != 0)
+      goto done;
+
+   ssize_t cmdlineLen = ProcConnector_readFile(dirFd, "cmdline", cmdline, sizeof(cmdline));
+   if (cmdlineLen < 0)
+      cmdlineLen = 0;
+
+   ssize_t commLen = ProcConnector_readFile(dirFd, "comm", comm, sizeof(comm) - 1);
+   if (commLen < 0)
+      commLen = 0;
+   if (commLen > 0 && comm[commLen - 1] == '\n')
+      commLen--;
+
+   snapshot = xMalloc(sizeof(ProcConnectorSnapshot) + (size_t)statLen + 1 + (size_t)cmdlineLen);
+   snapshot->uid = sb.st_uid;
+   memcpy(snapshot->comm, comm, (size_t)commLen);
+   snapshot->comm[commLen] = '\0';
+   snapshot->statLen = (size_t)statLen;
+   snapshot->cmdlineLen = (size_t)cmdlineLen;
+   memcpy(snapshot->data, stat, (size_t)statLen);
+   snapshot->data[statLen] = '\0';
+   memcpy(snapshot->data + statLen + 1, cmdline, (size_t)cmdlineLen);
+
+done:
+   close(dirFd);
+   return snapshot;
+}
+
+/* Keeps the latest snapshot that could be read; the one of a reused PID is stale */
+static void ProcConnector_setSnapshot(ProcConnectorTask* task, ProcConnectorSnapshot* snapshot, bool reused) {
+   if (!snapshot && !reused)
+      return;
+
+   free(task->snapshot);
+   task->snapshot = snapshot;
+}
+
+static void ProcConnector_handleEvent(ProcConnector* this, const struct proc_event* ev, ProcConnectorSnapshot* snapshot) {
+   ProcConnectorTask* task;
+
+   switch (ev->what) {
+      case PROC_EVENT_FORK:
+         task = ProcConnector_getOrAddTask(this, ev->event_data.fork.child_pid, ev->event_data.fork.child_tgid);
+         /* A reused PID: anything recorded for the previous owner is stale */
+         task->events = PROC_CONNECTOR_FORK;
+         ProcConnector_setSnapshot(task, snapshot, true);
+         return;
+      case PROC_EVENT_EXEC:
+         task = ProcConnector_getOrAddTask(this, ev->event_data.exec.process_pid, ev->event_data.exec.process_tgid);
+         task->events |= PROC_CONNECTOR_EXEC;
+         ProcConnector_setSnapshot(task, snapshot, false);
+         return;
+      case PROC_EVENT_COMM:
+         task = ProcConnector_getOrAddTask(this, ev->event_data.comm.process_pid, ev->event_data.comm.process_tgid);
+         task->events |= PROC_CONNECTOR_COMM;
+         break;
+      case PROC_EVENT_UID:
+      case PROC_EVENT_GID:
+         task = ProcConnector_getOrAddTask(this, ev->event_data.id.process_pid, ev->event_data.id.process_tgid);
+         task->events |= PROC_CONNECTOR_ID;
+         break;
+      case PROC_EVENT_EXIT:
+         task = ProcConnector_getOrAddTask(this, ev->event_data.exit.process_pid, ev->event_data.exit.process_tgid);
+         task->events |= PROC_CONNECTOR_EXIT;
+         break;
+      default:
+         break;
+   }
+
+   free(snapshot);
+}
+
+/* The process to take a snapshot of for an event, 0 if none */
+static pid_t ProcConnector_snapshotPid(const struct proc_event* ev) {
+   switch (ev->what) {
+      case PROC_EVENT_FORK:
+         if (ev->event_data.fork.child_pid == ev->event_data.fork.child_tgid)
+            return ev->event_data.fork.child_pid;
+         break;
+      case PROC_EVENT_EXEC:
+         if (ev->event_data.exec.process_pid == ev->event_data.exec.process_tgid)
+            return ev->event_data.exec.process_pid;
+         break;
+      default:
+         break;
+   }
+   return 0;
+}
+
+/* Receive all pending events, called by the listener */
+static void ProcConnector_receive(ProcConnector* this) {
+   union {
+      struct nlmsghdr hdr;
+      char buffer[16384];
+   } msg;
+
+   for (;;) {
+      struct sockaddr_nl from;
+      socklen_t fromLen = sizeof(from);
+      ssize_t res = recvfrom(this->fd, &msg, sizeof(msg), 0, (struct sockaddr*)&from, &fromLen);
+      if (res < 0) {
+         if (errno == EINTR)
+            continue;
+         if (errno == ENOBUFS) {
+            /* The socket buffer overflowed; keep reading to resynchronize */
+            pthread_mutex_lock(&this->lock);
+            this->lost = true;
+            pthread_mutex_unlock(&this->lock);
+            continue;
+         }
+         break;
+      }
+
+      /* Only trust messages sent by the kernel */
+      if (fromLen != sizeof(from) || from.nl_pid != 0)
+         continue;
+
+      int len = (int)res;
+      for (struct nlmsghdr* nlh = &msg.hdr; NLMSG_OK(nlh, len); nlh = NLMSG_NEXT(nlh, len)) {
+         if (nlh->nlmsg_type == NLMSG_OVERRUN) {
+            pthread_mutex_lock(&this->lock);
+            this->lost = true;
+            pthread_mutex_unlock(&this->lock);
+            continue;
+         }
+         if (nlh->nlmsg_type == NLMSG_NOOP || nlh->nlmsg_type == NLMSG_ERROR)
+            continue;
+         if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(struct cn_msg)))
+            continue;
+
+         const struct cn_msg* cn = NLMSG_DATA(nlh);
+         if (cn->id.idx != CN_IDX_PROC || cn->id.val != CN_VAL_PROC)
+            continue;
+         if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(struct cn_msg) + cn->len))
+            continue;
+
+         /* The kernel's struct proc_event may be smaller than the one of the headers */
+         struct proc_event ev;
+         memset(&ev, 0, sizeof(ev));
+         memcpy(&ev, cn->data, MINIMUM(cn->len, sizeof(ev)));
+
+         /* Read without holding the lock, the next refresh must not wait for it */
+         pid_t pid = ProcConnector_snapshotPid(&ev);
+         ProcConnectorSnapshot* snapshot = pid > 0 ? ProcConnector_takeSnapshot(pid) : NULL;
+
+         pthread_mutex_lock(&this->lock);
+         ProcConnector_handleEvent(this, &ev, snapshot);
+         pthread_mutex_unlock(&this->lock);
+      }
+   }
+}
+
+static void* ProcConnector_listen(void* data) {
+   ProcConnector* this = data;
+   struct pollfd fds[2] = {
+      { .fd = this->fd, .events = POLLIN },
+      { .fd = this->wakeFds[0], .events = POLLIN },
+   };
+
+   for (;;) {
+      if (poll(fds, ARRAYSIZE(fds), -1) < 0) {
+         if (errno == EINTR)
+            continue;
+         break;
+      }
+
+      if (fds[1].revents)
+         break;
+
+      if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+         pthread_mutex_lock(&this->lock);
+         this->lost = true;
+         pthread_mutex_unlock(&this->lock);
+         if (!(fds[0].revents & POLLIN))
+            break;
+      }
+
+      ProcConnector_receive(this);
+   }
+
+   return NULL;
+}
+
+bool ProcConnector_drain(ProcConnector* this) {
+   ProcConnector_clear(this);
+
+   pthread_mutex_lock(&this->lock);
+   Hashtable* received = this->tasks;
+   this->tasks = this->taken;
+   this->taken = received;
+   bool lost = this->lost;
+   this->lost = false;
+   pthread_mutex_unlock(&this->lock);
+
+   return !lost;
+}
+
+const ProcConnectorTask* ProcConnector_getTask(ProcConnector* this, pid_t tid) {
+   return Hashtable_get(this->taken, (ht_key_t)tid);
+}
+
+typedef struct {
+   ProcConnector_TaskFn fn;
+   void* data;
+} ProcConnector_ForeachArg;
+
+static void ProcConnector_foreachHelper(ATTR_UNUSED ht_key_t key, void* value, void* data) {
+   const ProcConnector_ForeachArg* arg = data;
+   arg->fn(value, arg->data);
+}
+
+void ProcConnector_foreach(ProcConnector* this, ProcConnector_TaskFn fn, void* data) {
+   ProcConnector_ForeachArg arg = { .fn = fn, .data = data };
+   Hashtable_foreach(this->taken, ProcConnector_foreachHelper, &arg);
+}
+
+void ProcConnector_clear(ProcConnector* this) {
+   Hashtable_foreach(this->taken, ProcConnector_freeSnapshot, NULL);
+   Hashtable_clear(this->taken);
+}
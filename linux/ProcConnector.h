@@ -0,0 +1,63 @@
+#ifndef HEADER_ProcConnector
+#define HEADER_ProcConnector
+/*
+htop - linux/ProcConnector.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+
+/* Events seen for a task since the connector was last cleared */
+#define PROC_CONNECTOR_FORK  0x01
+#define PROC_CONNECTOR_EXEC  0x02
+#define PROC_CONNECTOR_COMM  0x04
+#define PROC_CONNECTOR_ID    0x08
+#define PROC_CONNECTOR_EXIT  0x10
+
+/*
+ * Files of a process read as soon as it forked or executed, still telling
+ * what it was once it exited before the next refresh
+ */
+typedef struct ProcConnectorSnapshot_ {
+   uid_t uid;
+   char comm[64];
+   size_t statLen;
+   size_t cmdlineLen;
+   char data[];               /* stat, NUL, then cmdline */
+} ProcConnectorSnapshot;
+
+typedef struct ProcConnectorTask_ {
+   pid_t tid;
+   pid_t tgid;
+   uint32_t events;
+   ProcConnectorSnapshot* snapshot;   /* of main threads only, NULL if gone before it was read */
+} ProcConnectorTask;
+
+typedef void (*ProcConnector_TaskFn)(const ProcConnectorTask* task, void* data);
+
+typedef struct ProcConnector_ ProcConnector;
+
+/*
+ * Starts a thread receiving the events as they arrive.
+ * Returns NULL if the proc connector is not usable (e.g. CAP_NET_ADMIN is missing)
+ */
+ProcConnector* ProcConnector_new(void);
+
+void ProcConnector_delete(ProcConnector* this);
+
+/* Take the events received since the last drain; returns false if some were lost */
+bool ProcConnector_drain(ProcConnector* this);
+
+const ProcConnectorTask* ProcConnector_getTask(ProcConnector* this, pid_t tid);
+
+void ProcConnector_foreach(ProcConnector* this, ProcConnector_TaskFn fn, void* data);
+
+/* Forget the events taken by the last drain */
+void ProcConnector_clear(ProcConnector* this);
+
+#endif /* HEADER_ProcConnector */
@@ -0,0 +1,133 @@
+/*
+htop - linux/ProcFdCache.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcFdCache.h"
+
+#include <assert.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+
+/* Share of RLIMIT_NOFILE the cache may use; the rest is left to everything else */
+#define PROC_FD_CACHE_SHARE 2
+
+/* Below this limit caching is not worth it */
+#define PROC_FD_CACHE_MIN_LIMIT 256
+
+static size_t ProcFdCache_budget(void) {
+   struct rlimit limit;
+   if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+      return 0;
+
+   rlim_t cur = limit.rlim_cur;
+   if (cur == RLIM_INFINITY || cur > (1 << 20))
+      cur = 1 << 20;
+
+   if (cur < PROC_FD_CACHE_MIN_LIMIT)
+      return 0;
+
+   return (size_t)cur / PROC_FD_CACHE_SHARE;
+}
+
+void ProcFdCache_init(ProcFdCache* this) {
+   this->lru.cache = NULL;
+   this->lru.prev = &this->lru;
+   this->lru.next = &this->lru;
+   this->openFds = 0;
+   this->maxFds = ProcFdCache_budget();
+   this->generation = 0;
+}
+
+void ProcFdCache_done(ProcFdCache* this) {
+   while (this->lru.next != &this->lru)
+      ProcFdCacheEntry_release(this->lru.next);
+
+   assert(this->openFds == 0);
+}
+
+void ProcFdCache_newCycle(ProcFdCache* this) {
+   this->generation++;
+}
+
+void ProcFdCacheEntry_init(ProcFdCacheEntry* entry) {
+   entry->cache = NULL;
+   entry->prev = NULL;
+   entry->next = NULL;
+   entry->lastUsed = 0;
+   for (size_t i = 0; i < PROC_FD_SLOTS; i++)
+      entry->fds[i] = -1;
+}
+
+static void ProcFdCache_unlink(ProcFdCacheEntry* entry) {
+   entry->prev->next = entry->next;
+   entry->next->prev = entry->prev;
+   entry->prev = NULL;
+   entry->next = NULL;
+}
+
+static void ProcFdCache_touch(ProcFdCache* this, ProcFdCacheEntry* entry) {
+   entry->lastUsed = this->generation;
+
+   if (this->lru.next == entry)
+      return;
+
+   if (entry->cache)
+      ProcFdCache_unlink(entry);
+
+   entry->cache = this;
+   entry->prev = &this->lru;
+   entry->next = this->lru.next;
+   this->lru.next->prev = entry;
+   this->lru.next = entry;
+}
+
+int ProcFdCache_get(ProcFdCache* this, ProcFdCacheEntry* entry, ProcFdSlot slot) {
+   int fd = entry->fds[slot];
+   if (fd >= 0)
+      ProcFdCache_touch(this, entry);
+
+   return fd;
+}
+
+bool ProcFdCache_put(ProcFdCache* this, ProcFdCacheEntry* entry, ProcFdSlot slot, int fd) {
+   assert(entry->fds[slot] < 0);
+   assert(!entry->cache || entry->cache == this);
+
+   while (this->openFds >= this->maxFds) {
+      /* Only evict tasks not seen in the current cycle, typically ones that went away */
+      ProcFdCacheEntry* victim = this->lru.prev;
+      if (victim == &this->lru || victim == entry || victim->lastUsed == this->generation)
+         return false;
+
+      ProcFdCacheEntry_release(victim);
+   }
+
+   entry->fds[slot] = fd;
+   this->openFds++;
+   ProcFdCache_touch(this, entry);
+   return true;
+}
+
+void ProcFdCacheEntry_release(ProcFdCacheEntry* entry) {
+   ProcFdCache* cache = entry->cache;
+   if (!cache)
+      return;
+
+   for (size_t i = 0; i < PROC_FD_SLOTS; i++) {
+      if (entry->fds[i] >= 0) {
+         close(entry->fds[i]);
+         entry->fds[i] = -1;
+         assert(cache->openFds > 0);
+         cache->openFds--;
+      }
+   }
+
+   ProcFdCache_unlink(entry);
+   entry->cache = NULL;
+}
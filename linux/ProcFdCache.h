@@ -0,0 +1,56 @@
+#ifndef HEADER_ProcFdCache
+#define HEADER_ProcFdCache
+/*
+htop - linux/ProcFdCache.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+typedef enum ProcFdSlot_ {
+   PROC_FD_DIR,         /* /proc/<pid> */
+   PROC_FD_STAT,        /* /proc/<pid>/stat */
+   PROC_FD_TASK_STAT,   /* /proc/<pid>/task/<pid>/stat */
+   PROC_FD_STATM,       /* /proc/<pid>/statm */
+   PROC_FD_SLOTS
+} ProcFdSlot;
+
+/* Descriptors kept open for one task; embedded in LinuxProcess */
+typedef struct ProcFdCacheEntry_ {
+   struct ProcFdCache_* cache;   /* NULL while no descriptor is cached */
+   struct ProcFdCacheEntry_* prev;
+   struct ProcFdCacheEntry_* next;
+   unsigned int lastUsed;
+   int fds[PROC_FD_SLOTS];
+} ProcFdCacheEntry;
+
+typedef struct ProcFdCache_ {
+   ProcFdCacheEntry lru;         /* list head; lru.next is the most recently used entry */
+   size_t openFds;
+   size_t maxFds;
+   unsigned int generation;
+} ProcFdCache;
+
+void ProcFdCache_init(ProcFdCache* this);
+
+void ProcFdCache_done(ProcFdCache* this);
+
+/* Start a new refresh cycle; entries used in the current cycle are never evicted */
+void ProcFdCache_newCycle(ProcFdCache* this);
+
+void ProcFdCacheEntry_init(ProcFdCacheEntry* entry);
+
+/* Returns the cached descriptor of the slot or -1 */
+int ProcFdCache_get(ProcFdCache* this, ProcFdCacheEntry* entry, ProcFdSlot slot);
+
+/* Takes ownership of fd and returns true if it could be cached */
+bool ProcFdCache_put(ProcFdCache* this, ProcFdCacheEntry* entry, ProcFdSlot slot, int fd);
+
+/* Close all descriptors cached for the entry */
+void ProcFdCacheEntry_release(ProcFdCacheEntry* entry);
+
+#endif /* HEADER_ProcFdCache */
@@ -0,0 +1,448 @@
+/*
+htop - linux/ProcOpenFiles.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcOpenFiles.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/stat.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+typedef struct ProcSocket_ {
+   uint64_t inode;
+   const char* type;
+   char name[];
+} ProcSocket;
+
+static const char* const ProcOpenFiles_tcpStates[] = {
+   [1] = "ESTABLISHED",
+   [2] = "SYN_SENT",
+   [3] = "SYN_RECV",
+   [4] = "FIN_WAIT1",
+   [5] = "FIN_WAIT2",
+   [6] = "TIME_WAIT",
+   [7] = "CLOSE",
+   [8] = "CLOSE_WAIT",
+   [9] = "LAST_ACK",
+   [10] = "LISTEN",
+   [11] = "CLOSING",
+};
+
+ProcOpenFiles* ProcOpenFiles_new(pid_t pid) {
+   ProcOpenFiles* this = xCalloc(1, sizeof(ProcOpenFiles));
+   this->pid = pid;
+   this->dirFd = -1;
+   this->fdinfoFd = -1;
+   this->files = Hashtable_new(64, false);
+   this->sockets = Hashtable_new(64, true);
+   return this;
+}
+
+static void ProcOpenFiles_freeFile(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* userData) {
+   ProcOpenFile* file = value;
+   free(file->link);
+   free(file);
+}
+
+static void ProcOpenFiles_stop(ProcOpenFiles* this) {
+   if (this->fdDir) {
+      closedir(this->fdDir);
+      this->fdDir = NULL;
+   }
+   if (this->fdinfoFd >= 0) {
+      close(this->fdinfoFd);
+      this->fdinfoFd = -1;
+   }
+   if (this->dirFd >= 0) {
+      close(this->dirFd);
+      this->dirFd = -1;
+   }
+}
+
+void ProcOpenFiles_delete(ProcOpenFiles* this) {
+   ProcOpenFiles_stop(this);
+   Hashtable_foreach(this->files, ProcOpenFiles_freeFile, NULL);
+   Hashtable_delete(this->files);
+   Hashtable_delete(this->sockets);
+   free(this->current.link);
+   free(this);
+}
+
+bool ProcOpenFiles_start(ProcOpenFiles* this) {
+   ProcOpenFiles_stop(this);
+
+   this->special = 0;
+   this->generation++;
+   Hashtable_clear(this->sockets);
+   this->socketsRead = false;
+
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d", (int)this->pid);
+   this->dirFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (this->dirFd < 0)
+      return false;
+
+   int fdDirFd = openat(this->dirFd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (fdDirFd < 0 || !(this->fdDir = fdopendir(fdDirFd))) {
+      if (fdDirFd >= 0)
+         close(fdDirFd);
+      ProcOpenFiles_stop(this);
+      return false;
+   }
+
+   this->fdinfoFd = openat(this->dirFd, "fdinfo", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   return true;
+}
+
+static void ProcOpenFiles_addSocket(ProcOpenFiles* this, uint64_t inode, const char* type, const char* name) {
+   if (!inode || Hashtable_get(this->sockets, (ht_key_t)inode))
+      return;
+
+   size_t len = strlen(name);
+   ProcSocket* socket = xMalloc(sizeof(ProcSocket) + len + 1);
+   socket->inode = inode;
+   socket->type = type;
+   memcpy(socket->name, name, len + 1);
+   Hashtable_put(this->sockets, (ht_key_t)inode, socket);
+}
+
+/* Addresses are printed by the kernel as 32 bit words in host byte order */
+static void ProcOpenFiles_formatAddress(char* buffer, size_t size, const char* hex, unsigned int port, bool ipv6) {
+   char text[INET6_ADDRSTRLEN] = "";
+   bool any = true;
+
+   if (ipv6) {
+      struct in6_addr addr;
+      for (size_t i = 0; i < 4; i++) {
+         char word[9];
+         memcpy(word, hex + i * 8, 8);
+         word[8] = '\0';
+         uint32_t value = (uint32_t)strtoul(word, NULL, 16);
+         memcpy(addr.s6_addr + i * 4, &value, sizeof(value));
+         any = any && !value;
+      }
+      inet_ntop(AF_INET6, &addr, text, sizeof(text));
+   } else {
+      struct in_addr addr;
+      uint32_t value = (uint32_t)strtoul(hex, NULL, 16);
+      memcpy(&addr.s_addr, &value, sizeof(value));
+      any = !value;
+      inet_ntop(AF_INET, &addr, text, sizeof(text));
+   }
+
+   if (any && !port)
+      xSnprintf(buffer, size, "*:*");
+   else if (any)
+      xSnprintf(buffer, size, "*:%u", port);
+   else if (ipv6)
+      xSnprintf(buffer, size, "[%s]:%u", text, port);
+   else
+      xSnprintf(buffer, size, "%s:%u", text, port);
+}
+
+static void ProcOpenFiles_readInetSockets(ProcOpenFiles* this, const char* table, const char* protocol, bool ipv6) {
+   int fd = openat(this->dirFd, table, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return;
+
+   FILE* fp = fdopen(fd, "r");
+   if (!fp) {
+      close(fd);
+      return;
+   }
+
+   bool tcp = String_eq(protocol, "TCP");
+   const char* type = ipv6 ? "IPv6" : "IPv4";
+
+   char buffer[512];
+   /* skip the header */
+   if (!fgets(buffer, sizeof(buffer), fp)) {
+      fclose(fp);
+      return;
+   }
+
+   while (fgets(buffer, sizeof(buffer), fp)) {
+      char localHex[33], remoteHex[33];
+      unsigned int localPort, remotePort, state;
+      uint64_t inode;
+      if (6 != sscanf(buffer, "%*u: %32[0-9A-Fa-f]:%x %32[0-9A-Fa-f]:%x %x %*s %*s %*s %*u %*u %" SCNu64,
+                      localHex, &localPort, remoteHex, &remotePort, &state, &inode))
+         continue;
+
+      if (strlen(localHex) != (ipv6 ? 32 : 8) || strlen(remoteHex) != strlen(localHex))
+         continue;
+
+      char local[INET6_ADDRSTRLEN + 16];
+      char remote[INET6_ADDRSTRLEN + 16];
+      ProcOpenFiles_formatAddress(local, sizeof(local), localHex, localPort, ipv6);
+      ProcOpenFiles_formatAddress(remote, sizeof(remote), remoteHex, remotePort, ipv6);
+
+      char name[2 * sizeof(local) + 32];
+      bool connected = !String_eq(remote, "*:*");
+      const char* stateName = tcp && state < ARRAYSIZE(ProcOpenFiles_tcpStates) ? ProcOpenFiles_tcpStates[state] : NULL;
+      if (stateName)
+         xSnprintf(name, sizeof(name), "%s %s%s%s (%s)", protocol, local, connected ? "->" : "", connected ? remote : "", stateName);
+      else
+         xSnprintf(name, sizeof(name), "%s %s%s%s", protocol, local, connected ? "->" : "", connected ? remote : "");
+
+      ProcOpenFiles_addSocket(this, inode, type, name);
+   }
+
+   fclose(fp);
+}
+
+static void ProcOpenFiles_readUnixSockets(ProcOpenFiles* this) {
+   int fd = openat(this->dirFd, "net/unix", O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return;
+
+   FILE* fp = fdopen(fd, "r");
+   if (!fp) {
+      close(fd);
+      return;
+   }
+
+   char buffer[PATH_MAX + 128];
+   /* skip the header */
+   if (!fgets(buffer, sizeof(buffer), fp)) {
+      fclose(fp);
+      return;
+   }
+
+   while (fgets(buffer, sizeof(buffer), fp)) {
+      unsigned int type;
+      uint64_t inode;
+      int pathStart = 0;
+      if (2 != sscanf(buffer, "%*x: %*x %*x %*x %x %*x %" SCNu64 " %n", &type, &inode, &pathStart))
+         continue;
+
+      char* path = pathStart ? buffer + pathStart : NULL;
+      if (path) {
+         char* eol = strchr(path, '\n');
+         if (eol)
+            *eol = '\0';
+      }
+
+      const char* typeName;
+      switch (type) {
+         case 1: typeName = "STREAM"; break;
+         case 2: typeName = "DGRAM"; break;
+         case 5: typeName = "SEQPACKET"; break;
+         default: typeName = "UNKNOWN"; break;
+      }
+
+      char name[sizeof(buffer) + 32];
+      if (path && *path)
+         xSnprintf(name, sizeof(name), "%s type=%s", path, typeName);
+      else
+         xSnprintf(name, sizeof(name), "type=%s", typeName);
+
+      ProcOpenFiles_addSocket(this, inode, "unix", name);
+   }
+
+   fclose(fp);
+}
+
+static void ProcOpenFiles_readSockets(ProcOpenFiles* this) {
+   this->socketsRead = true;
+   ProcOpenFiles_readInetSockets(this, "net/tcp", "TCP", false);
+   ProcOpenFiles_readInetSockets(this, "net/tcp6", "TCP", true);
+   ProcOpenFiles_readInetSockets(this, "net/udp", "UDP", false);
+   ProcOpenFiles_readInetSockets(this, "net/udp6", "UDP", true);
+   ProcOpenFiles_readUnixSockets(this);
+}
+
+static const char* ProcOpenFiles_typeName(mode_t mode) {
+   switch (mode & S_IFMT) {
+      case S_IFREG:  return "REG";
+      case S_IFDIR:  return "DIR";
+      case S_IFCHR:  return "CHR";
+      case S_IFBLK:  return "BLK";
+      case S_IFIFO:  return "FIFO";
+      case S_IFSOCK: return "sock";
+      case S_IFLNK:  return "LINK";
+      default:       return "a_inode";
+   }
+}
+
+/* Fill in what stat(2) and fdinfo tell about the file the entry of dirFd links to */
+static void ProcOpenFiles_examine(int dirFd, int fdinfoFd, const char* entry, ProcOpenFile* file) {
+   file->type = "unknown";
+   file->mode = ' ';
+   file->hasDevice = false;
+   file->hasSize = false;
+   file->hasOffset = false;
+   file->inode = 0;
+   file->socket = 0;
+   file->stable = false;
+
+   struct stat sb;
+   if (fstatat(dirFd, entry, &sb, 0) == 0) {
+      file->type = ProcOpenFiles_typeName(sb.st_mode);
+      file->hasDevice = true;
+      file->device = sb.st_dev;
+      file->inode = sb.st_ino;
+      if (S_ISREG(sb.st_mode)) {
+         file->hasSize = true;
+         file->size = sb.st_size;
+      }
+      if (S_ISSOCK(sb.st_mode))
+         file->socket = sb.st_ino;
+      file->stable = S_ISSOCK(sb.st_mode) || S_ISFIFO(sb.st_mode) || String_startsWith(file->link, "anon_inode:");
+   }
+
+   if (fdinfoFd < 0)
+      return;
+
+   char buffer[256];
+   if (xReadfileat(fdinfoFd, entry, buffer, sizeof(buffer)) <= 0)
+      return;
+
+   const char* pos = strstr(buffer, "pos:");
+   if (pos) {
+      file->hasOffset = true;
+      file->offset = strtoull(pos + strlen("pos:"), NULL, 10);
+   }
+
+   const char* flags = strstr(buffer, "flags:");
+   if (flags) {
+      switch (strtoul(flags + strlen("flags:"), NULL, 8) & O_ACCMODE) {
+         case O_RDONLY: file->mode = 'r'; break;
+         case O_WRONLY: file->mode = 'w'; break;
+         case O_RDWR:   file->mode = 'u'; break;
+      }
+   }
+}
+
+static bool ProcOpenFiles_readLink(int dirFd, const char* entry, char* buffer, size_t size) {
+   ssize_t len = readlinkat(dirFd, entry, buffer, size - 1);
+   if (len < 0)
+      return false;
+
+   buffer[len] = '\0';
+   return true;
+}
+
+typedef struct ProcOpenFiles_Stale_ {
+   unsigned int generation;
+   ht_key_t* keys;
+   size_t count;
+   size_t capacity;
+} ProcOpenFiles_Stale;
+
+static void ProcOpenFiles_collectStale(ht_key_t key, void* value, void* userData) {
+   const ProcOpenFile* file = value;
+   ProcOpenFiles_Stale* stale = userData;
+   if (file->generation == stale->generation)
+      return;
+
+   if (stale->count == stale->capacity) {
+      stale->capacity = stale->capacity ? 2 * stale->capacity : 16;
+      stale->keys = xReallocArray(stale->keys, stale->capacity, sizeof(*stale->keys));
+   }
+   stale->keys[stale->count++] = key;
+}
+
+/* Forget the descriptors closed since the previous walk */
+static void ProcOpenFiles_dropStale(ProcOpenFiles* this) {
+   ProcOpenFiles_Stale stale = { .generation = this->generation };
+   Hashtable_foreach(this->files, ProcOpenFiles_collectStale, &stale);
+
+   for (size_t i = 0; i < stale.count; i++)
+      ProcOpenFiles_freeFile(stale.keys[i], Hashtable_remove(this->files, stale.keys[i]), NULL);
+
+   free(stale.keys);
+}
+
+const ProcOpenFile* ProcOpenFiles_next(ProcOpenFiles* this) {
+   static const struct {
+      const char* entry;
+      const char* fd;
+   } specials[] = {
+      { "cwd",  "cwd" },
+      { "root", "rtd" },
+      { "exe",  "txt" },
+   };
+
+   char link[PATH_MAX];
+
+   while (this->dirFd >= 0 && this->special < ARRAYSIZE(specials)) {
+      ProcOpenFile* file = &this->current;
+      const char* entry = specials[this->special].entry;
+      String_safeStrncpy(file->fd, specials[this->special].fd, sizeof(file->fd));
+      this->special++;
+
+      if (!ProcOpenFiles_readLink(this->dirFd, entry, link, sizeof(link)))
+         continue;
+
+      free_and_xStrdup(&file->link, link);
+      ProcOpenFiles_examine(this->dirFd, -1, entry, file);
+      file->name = file->link;
+      return file;
+   }
+
+   if (!this->fdDir)
+      return NULL;
+
+   for (const struct dirent* de; (de = readdir(this->fdDir)); ) {
+      char* end;
+      errno = 0;
+      unsigned long fd = strtoul(de->d_name, &end, 10);
+      if (errno || end == de->d_name || *end || fd > UINT_MAX)
+         continue;
+
+      if (!ProcOpenFiles_readLink(dirfd(this->fdDir), de->d_name, link, sizeof(link)))
+         continue;
+
+      ProcOpenFile* file = Hashtable_get(this->files, (ht_key_t)fd);
+      if (!file) {
+         file = xCalloc(1, sizeof(ProcOpenFile));
+         xSnprintf(file->fd, sizeof(file->fd), "%lu", fd);
+         Hashtable_put(this->files, (ht_key_t)fd, file);
+      }
+
+      if (!file->stable || !file->link || !String_eq(file->link, link)) {
+         free_and_xStrdup(&file->link, link);
+         ProcOpenFiles_examine(dirfd(this->fdDir), this->fdinfoFd, de->d_name, file);
+      }
+      file->generation = this->generation;
+      file->name = file->link;
+
+      if (file->socket) {
+         if (!this->socketsRead)
+            ProcOpenFiles_readSockets(this);
+
+         const ProcSocket* socket = Hashtable_get(this->sockets, (ht_key_t)file->socket);
+         if (socket && socket->inode == file->socket) {
+            file->type = socket->type;
+            file->name = socket->name;
+         } else {
+            file->type = "sock";
+         }
+      }
+
+      return file;
+   }
+
+   ProcOpenFiles_dropStale(this);
+   ProcOpenFiles_stop(this);
+   return NULL;
+}
@@ -0,0 +1,70 @@
+#ifndef HEADER_ProcOpenFiles
+#define HEADER_ProcOpenFiles
+/*
+htop - linux/ProcOpenFiles.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+
+
+/*
+ * Files open in a process, read from /proc/<pid>/fd and fdinfo without
+ * running lsof. Sockets are named from the socket tables of the process'
+ * network namespace, read once per walk when the first socket shows up.
+ * The files of one walk are returned one at a time so callers can show
+ * the first ones while the rest are still read. Sockets, pipes and
+ * anonymous inodes found under the same link as in the previous walk
+ * are not examined again.
+ */
+
+typedef struct ProcOpenFile_ {
+   char fd[12];               /* descriptor number, or cwd, rtd or txt like lsof */
+   const char* type;          /* REG, DIR, CHR, FIFO, IPv4, unix, ... */
+   char mode;                 /* access mode r, w or u; ' ' if unknown */
+   bool hasDevice;
+   dev_t device;
+   bool hasSize;
+   uint64_t size;
+   bool hasOffset;
+   uint64_t offset;
+   uint64_t inode;            /* 0 if unknown */
+   const char* name;          /* valid until the next walk starts */
+
+   char* link;                /* target of the descriptor link */
+   uint64_t socket;           /* inode of a socket, 0 for other files */
+   bool stable;               /* cannot change while link stays the same */
+   unsigned int generation;   /* walk the file was last seen in */
+} ProcOpenFile;
+
+typedef struct ProcOpenFiles_ {
+   pid_t pid;
+   int dirFd;                 /* PROCDIR/<pid> of the current walk, or -1 */
+   int fdinfoFd;              /* PROCDIR/<pid>/fdinfo, or -1 */
+   DIR* fdDir;                /* PROCDIR/<pid>/fd while the walk lasts */
+   unsigned int special;      /* cwd, rtd and txt returned so far */
+   unsigned int generation;
+   ProcOpenFile current;      /* storage of cwd, rtd and txt */
+   Hashtable* files;          /* descriptor -> ProcOpenFile */
+   Hashtable* sockets;        /* socket inode -> ProcSocket */
+   bool socketsRead;
+} ProcOpenFiles;
+
+ProcOpenFiles* ProcOpenFiles_new(pid_t pid);
+
+void ProcOpenFiles_delete(ProcOpenFiles* this);
+
+/* Start over walking the open files; false if they cannot be read */
+bool ProcOpenFiles_start(ProcOpenFiles* this);
+
+/* The next open file of the walk, NULL after the last one */
+const ProcOpenFile* ProcOpenFiles_next(ProcOpenFiles* this);
+
+#endif
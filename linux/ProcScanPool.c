@@ -0,0 +1,446 @@
+/*
+htop - linux/ProcScanPool.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#ifndef HAVE_SCAN_THREADS
+#error Compiling this file requires HAVE_SCAN_THREADS
+#endif
+
+#include "linux/ProcScanPool.h"
+
+#include <assert.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "XUtils.h"
+
+
+/* Large enough for every buffer the serial readers in LinuxProcessTable pass;
+   longer files are read again with a larger one */
+#define PROCSCAN_READ_SIZE 8192
+
+static const struct {
+   uint32_t flag;
+   const char* name;
+} ProcScanPool_files[] = {
+   { PROCSCAN_STAT,    "stat"    },
+   { PROCSCAN_STATM,   "statm"   },
+   { PROCSCAN_STATUS,  "status"  },
+   { PROCSCAN_IO,      "io"      },
+   { PROCSCAN_CGROUP,  "cgroup"  },
+   { PROCSCAN_CMDLINE, "cmdline" },
+   { PROCSCAN_COMM,    "comm"    },
+};
+
+typedef struct ProcScanEntry_ {
+   pid_t tid;
+   unsigned int worker;
+   uint32_t files;
+   size_t offset[ARRAYSIZE(ProcScanPool_files)];
+   ssize_t length[ARRAYSIZE(ProcScanPool_files)];  /* negative errno if reading failed */
+} ProcScanEntry;
+
+typedef struct ProcScanWorker_ {
+   struct ProcScanPool_* pool;
+   pthread_t thread;
+   unsigned int index;
+
+   ProcScanEntry* entries;
+   size_t nEntries;
+   size_t entriesCapacity;
+
+   char* data;
+   size_t dataSize;
+   size_t dataCapacity;
+} ProcScanWorker;
+
+struct ProcScanPool_ {
+   unsigned int threads;     /* as requested */
+   unsigned int nWorkers;    /* actually running, less than requested if thread creation failed */
+   ProcScanWorker* workers;  /* workers[0] is the thread calling ProcScanPool_run */
+
+   pthread_mutex_t lock;
+   pthread_cond_t wakeup;
+   pthread_cond_t done;
+   unsigned int generation;
+   unsigned int busy;
+   bool quit;
+
+   /* Job of the current run, read-only while the workers are busy */
+   int procFd;
+   pid_t* pids;
+   size_t nPids;
+   size_t pidsCapacity;
+   ProcScanPool_SelectFn select;
+   void* selectData;
+
+   Hashtable* index;  /* tid -> ProcScanEntry */
+};
+
+static bool isFileForMainThread(uint32_t files, uint32_t flag) {
+   return (files & PROCSCAN_MAIN_THREAD) && (flag & (PROCSCAN_STAT | PROCSCAN_IO));
+}
+
+/* Keep only the lines of /proc/<pid>/status parsed by LinuxProcessTable_readStatusFile */
+static size_t compactStatus(char* data, size_t length) {
+   static const char* const wanted[] = {
+      "NSpid:",
+      "voluntary_ctxt_switches:",
+      "nonvoluntary_ctxt_switches:",
+      "VxID:",
+      "s_context:",
+   };
+
+   size_t kept = 0;
+   const char* end = data + length;
+   for (char* line = data; line < end; ) {
+      const char* eol = memchr(line, '\n', (size_t)(end - line));
+      size_t lineLen = eol ? (size_t)(eol - line) + 1 : (size_t)(end - line);
+
+      for (size_t i = 0; i < ARRAYSIZE(wanted); i++) {
+         if (String_startsWith(line, wanted[i])) {
+            memmove(data + kept, line, lineLen);
+            kept += lineLen;
+            break;
+         }
+      }
+
+      line += lineLen;
+   }
+
+   data[kept] = '\0';
+   return kept;
+}
+
+static ProcScanEntry* ProcScanWorker_newEntry(ProcScanWorker* this, pid_t tid, uint32_t files) {
+   if (this->nEntries == this->entriesCapacity) {
+      this->entriesCapacity = this->entriesCapacity ? 2 * this->entriesCapacity : 256;
+      this->entries = xReallocArray(this->entries, this->entriesCapacity, sizeof(ProcScanEntry));
+   }
+
+   ProcScanEntry* entry = &this->entries[this->nEntries++];
+   entry->tid = tid;
+   entry->worker = this->index;
+   entry->files = files;
+   return entry;
+}
+
+static void ProcScanWorker_readTask(ProcScanWorker* this, int taskFd, pid_t tid, pid_t tgid) {
+   const ProcScanPool* pool = this->pool;
+
+   uint32_t files = pool->select(pool->selectData, tid, tgid);
+   if (!(files & ~PROCSCAN_MAIN_THREAD))
+      return;
+
+   ProcScanEntry* entry = ProcScanWorker_newEntry(this, tid, files);
+
+   for (size_t i = 0; i < ARRAYSIZE(ProcScanPool_files); i++) {
+      uint32_t flag = ProcScanPool_files[i].flag;
+      if (!(files & flag))
+         continue;
+
+      char path[32];
+      if (isFileForMainThread(files, flag)) {
+         xSnprintf(path, sizeof(path), "task/%d/%s", (int)tid, ProcScanPool_files[i].name);
+      } else {
+         String_safeStrncpy(path, ProcScanPool_files[i].name, sizeof(path));
+      }
+
+      /* Read again with more room while the file fills it, so that status
+         keeps the lines following a long Groups: list before compaction */
+      char* data;
+      ssize_t r;
+      for (size_t size = PROCSCAN_READ_SIZE; ; size *= 2) {
+         if (this->dataCapacity - this->dataSize < size) {
+            this->dataCapacity = MAXIMUM(2 * this->dataCapacity, this->dataSize + size);
+            this->data = xRealloc(this->data, this->dataCapacity);
+         }
+
+         data = this->data + this->dataSize;
+         r = xReadfileat(taskFd, path, data, size);
+         if (r < 0 || (size_t)r < size - 1)
+            break;
+      }
+      if (r >= 0 && flag == PROCSCAN_STATUS)
+         r = (ssize_t)compactStatus(data, (size_t)r);
+
+      entry->offset[i] = this->dataSize;
+      entry->length[i] = r;
+      if (r >= 0)
+         this->dataSize += (size_t)r + 1;
+   }
+}
+
+static void ProcScanWorker_readThreads(ProcScanWorker* this, int pidFd, pid_t tgid) {
+   int taskDirFd = openat(pidFd, "task", O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+   if (taskDirFd < 0)
+      return;
+
+   DIR* dir = fdopendir(taskDirFd);
+   if (!dir) {
+      close(taskDirFd);
+      return;
+   }
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      char* endptr;
+      unsigned long tid = strtoul(entry->d_name, &endptr, 10);
+      if (tid == 0 || tid == ULONG_MAX || *endptr != '\0' || (pid_t)tid == tgid)
+         continue;
+
+      int tidFd = openat(taskDirFd, entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+      if (tidFd < 0)
+         continue;
+
+      ProcScanWorker_readTask(this, tidFd, (pid_t)tid, tgid);
+      close(tidFd);
+   }
+
+   closedir(dir);
+}
+
+static void ProcScanWorker_work(ProcScanWorker* this) {
+   const ProcScanPool* pool = this->pool;
+
+   this->nEntries = 0;
+   this->dataSize = 0;
+
+   /* Interleave the PIDs across the workers, neighbouring PIDs tend to be of similar cost */
+   for (size_t i = this->index; i < pool->nPids; i += pool->nWorkers) {
+      pid_t pid = pool->pids[i];
+
+      char name[16];
+      xSnprintf(name, sizeof(name), "%d", (int)pid);
+
+      int pidFd = openat(pool->procFd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+      if (pidFd < 0)
+         continue;
+
+      ProcScanWorker_readTask(this, pidFd, pid, pid);
+      ProcScanWorker_readThreads(this, pidFd, pid);
+      close(pidFd);
+   }
+}
+
+static void* ProcScanWorker_main(void* arg) {
+   ProcScanWorker* this = arg;
+   ProcScanPool* pool = this->pool;
+   unsigned int seen = 0;
+
+   pthread_mutex_lock(&pool->lock);
+   for (;;) {
+      while (!pool->quit && pool->generation == seen)
+         pthread_cond_wait(&pool->wakeup, &pool->lock);
+
+      if (pool->quit)
+         break;
+
+      seen = pool->generation;
+      pthread_mutex_unlock(&pool->lock);
+
+      ProcScanWorker_work(this);
+
+      pthread_mutex_lock(&pool->lock);
+      if (--pool->busy == 0)
+         pthread_cond_signal(&pool->done);
+   }
+   pthread_mutex_unlock(&pool->lock);
+
+   return NULL;
+}
+
+ProcScanPool* ProcScanPool_new(unsigned int threads) {
+   assert(threads > 0);
+
+   ProcScanPool* this = xCalloc(1, sizeof(ProcScanPool));
+   this->workers = xCalloc(threads, sizeof(ProcScanWorker));
+   this->procFd = -1;
+   this->index = Hashtable_new(0, false);
+
+   pthread_mutex_init(&this->lock, NULL);
+   pthread_cond_init(&this->wakeup, NULL);
+   pthread_cond_init(&this->done, NULL);
+
+   /* Signals are handled by the main thread only; faults are still delivered to the faulting thread */
+   sigset_t blocked;
+   sigset_t previous;
+   sigfillset(&blocked);
+   sigdelset(&blocked, SIGSEGV);
+   sigdelset(&blocked, SIGBUS);
+   sigdelset(&blocked, SIGFPE);
+   sigdelset(&blocked, SIGILL);
+   sigdelset(&blocked, SIGABRT);
+   pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+
+   this->threads = threads;
+   this->workers[0].pool = this;
+   this->workers[0].index = 0;
+   this->nWorkers = 1;
+   for (unsigned int i = 1; i < threads; i++) {
+      ProcScanWorker* worker = &this->workers[i];
+      worker->pool = this;
+      worker->index = i;
+      if (pthread_create(&worker->thread, NULL, ProcScanWorker_main, worker) != 0)
+         break;
+
+      this->nWorkers++;
+   }
+
+   pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+   return this;
+}
+
+void ProcScanPool_delete(ProcScanPool* this) {
+   pthread_mutex_lock(&this->lock);
+   this->quit = true;
+   pthread_cond_broadcast(&this->wakeup);
+   pthread_mutex_unlock(&this->lock);
+
+   for (unsigned int i = 0; i < this->nWorkers; i++) {
+      ProcScanWorker* worker = &this->workers[i];
+      if (i > 0)
+         pthread_join(worker->thread, NULL);
+
+      free(worker->entries);
+      free(worker->data);
+   }
+
+   pthread_cond_destroy(&this->done);
+   pthread_cond_destroy(&this->wakeup);
+   pthread_mutex_destroy(&this->lock);
+
+   Hashtable_delete(this->index);
+   free(this->workers);
+   free(this->pids);
+   free(this);
+}
+
+unsigned int ProcScanPool_threads(const ProcScanPool* this) {
+   return this->threads;
+}
+
+static void ProcScanPool_collectPids(ProcScanPool* this, const char* procDir) {
+   this->nPids = 0;
+
+   DIR* dir = opendir(procDir);
+   if (!dir)
+      return;
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      const char* name = entry->d_name;
+      if (name[0] < '0' || name[0] > '9')
+         continue;
+
+      char* endptr;
+      unsigned long pid = strtoul(name, &endptr, 10);
+      if (pid == 0 || pid == ULONG_MAX || *endptr != '\0')
+         continue;
+
+      if (this->nPids == this->pidsCapacity) {
+         this->pidsCapacity = this->pidsCapacity ? 2 * this->pidsCapacity : 1024;
+         this->pids = xReallocArray(this->pids, this->pidsCapacity, sizeof(pid_t));
+      }
+      this->pids[this->nPids++] = (pid_t)pid;
+   }
+
+   closedir(dir);
+}
+
+void ProcScanPool_run(ProcScanPool* this, const char* procDir, ProcScanPool_SelectFn select, void* data) {
+   ProcScanPool_reset(this);
+
+   this->procFd = open(procDir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (this->procFd < 0)
+      return;
+
+   ProcScanPool_collectPids(this, procDir);
+   this->select = select;
+   this->selectData = data;
+
+   pthread_mutex_lock(&this->lock);
+   this->generation++;
+   this->busy = this->nWorkers - 1;
+   pthread_cond_broadcast(&this->wakeup);
+   pthread_mutex_unlock(&this->lock);
+
+   ProcScanWorker_work(&this->workers[0]);
+
+   pthread_mutex_lock(&this->lock);
+   while (this->busy > 0)
+      pthread_cond_wait(&this->done, &this->lock);
+   pthread_mutex_unlock(&this->lock);
+
+   close(this->procFd);
+   this->procFd = -1;
+
+   /* Single-threaded merge of the per-worker results */
+   size_t total = 0;
+   for (unsigned int i = 0; i < this->nWorkers; i++)
+      total += this->workers[i].nEntries;
+
+   Hashtable_setSize(this->index, 2 * total);
+   for (unsigned int i = 0; i < this->nWorkers; i++) {
+      ProcScanWorker* worker = &this->workers[i];
+      for (size_t j = 0; j < worker->nEntries; j++)
+         Hashtable_put(this->index, (ht_key_t)worker->entries[j].tid, &worker->entries[j]);
+   }
+}
+
+void ProcScanPool_reset(ProcScanPool* this) {
+   Hashtable_clear(this->index);
+}
+
+bool ProcScanPool_read(ProcScanPool* this, pid_t tid, const char* path, char* buffer, size_t count, ssize_t* result) {
+   const ProcScanEntry* entry = Hashtable_get(this->index, (ht_key_t)tid);
+   if (!entry)
+      return false;
+
+   bool forMainThread = String_startsWith(path, "task/");
+   const char* name = forMainThread ? strrchr(path, '/') + 1 : path;
+
+   for (size_t i = 0; i < ARRAYSIZE(ProcScanPool_files); i++) {
+      uint32_t flag = ProcScanPool_files[i].flag;
+      if (!String_eq(name, ProcScanPool_files[i].name))
+         continue;
+
+      if (!(entry->files & flag) || forMainThread != isFileForMainThread(entry->files, flag))
+         return false;
+
+      if (!count) {
+         *result = -EINVAL;
+         return true;
+      }
+
+      if (entry->length[i] < 0) {
+         buffer[0] = '\0';
+         *result = entry->length[i];
+         return true;
+      }
+
+      const char* data = this->workers[entry->worker].data + entry->offset[i];
+      size_t length = MINIMUM((size_t)entry->length[i], count - 1);
+      memcpy(buffer, data, length);
+      buffer[length] = '\0';
+      *result = (ssize_t)length;
+      return true;
+   }
+
+   return false;
+}
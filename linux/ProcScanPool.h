@@ -0,0 +1,49 @@
+#ifndef HEADER_ProcScanPool
+#define HEADER_ProcScanPool
+/*
+htop - linux/ProcScanPool.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+
+/* Per-task files a worker may prefetch; names are relative to /proc/<tid> */
+#define PROCSCAN_STAT         0x00000001
+#define PROCSCAN_STATM        0x00000002
+#define PROCSCAN_STATUS       0x00000004
+#define PROCSCAN_IO           0x00000008
+#define PROCSCAN_CGROUP       0x00000010
+#define PROCSCAN_CMDLINE      0x00000020
+#define PROCSCAN_COMM         0x00000040
+
+/* Read stat and io of the main thread from task/<pid>/ instead of <pid>/ */
+#define PROCSCAN_MAIN_THREAD  0x80000000
+
+/* Called concurrently from the worker threads; must not modify any shared state */
+typedef uint32_t (*ProcScanPool_SelectFn)(void* data, pid_t tid, pid_t tgid);
+
+typedef struct ProcScanPool_ ProcScanPool;
+
+ProcScanPool* ProcScanPool_new(unsigned int threads);
+
+void ProcScanPool_delete(ProcScanPool* this);
+
+unsigned int ProcScanPool_threads(const ProcScanPool* this);
+
+/* Prefetch the files selected for every task below procDir; blocks until all workers are done */
+void ProcScanPool_run(ProcScanPool* this, const char* procDir, ProcScanPool_SelectFn select, void* data);
+
+/* Drop all prefetched data of the last run */
+void ProcScanPool_reset(ProcScanPool* this);
+
+/* Behaves like xReadfileat(procFd, path, ...) on the prefetched data of the task;
+   returns false if the file was not prefetched for the task */
+bool ProcScanPool_read(ProcScanPool* this, pid_t tid, const char* path, char* buffer, size_t count, ssize_t* result);
+
+#endif /* HEADER_ProcScanPool */
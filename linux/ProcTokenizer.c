@@ -0,0 +1,75 @@
+/*
+htop - linux/ProcTokenizer.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcTokenizer.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PROCTOKENIZER_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PROCTOKENIZER_NEON
+#endif
+
+
+const char* ProcTokenizer_implementation(void) {
+#if defined(PROCTOKENIZER_SSE2)
+   return "SSE2";
+#elif defined(PROCTOKENIZER_NEON)
+   return "NEON";
+#else
+   return "scalar";
+#endif
+}
+
+/* Append the positions of the bits set in mask, each standing for step bytes */
+static inline size_t ProcTokenizer_addMask(uint64_t mask, unsigned int step, uint32_t base, uint32_t* positions, size_t count, size_t max) {
+   while (mask && count < max) {
+      unsigned int bit = (unsigned int)__builtin_ctzll(mask);
+      positions[count++] = base + bit / step;
+      mask &= mask - 1;
+   }
+
+   return count;
+}
+
+size_t ProcTokenizer_split(const char* data, size_t len, char sep, uint32_t* positions, size_t max) {
+   size_t count = 0;
+   size_t i = 0;
+
+#if defined(PROCTOKENIZER_SSE2)
+   const __m128i needle = _mm_set1_epi8(sep);
+   for (; i + 16 <= len && count < max; i += 16) {
+      __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(data + i));
+      uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+      count = ProcTokenizer_addMask(mask, 1, (uint32_t)i, positions, count, max);
+   }
+#elif defined(PROCTOKENIZER_NEON)
+   const uint8x16_t needle = vdupq_n_u8((uint8_t)sep);
+   for (; i + 16 <= len && count < max; i += 16) {
+      uint8x16_t eq = vceqq_u8(vld1q_u8((const uint8_t*)data + i), needle);
+      /* Narrow to four bits per byte, there is no movemask */
+      uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+      count = ProcTokenizer_addMask(mask & 0x8888888888888888ULL, 4, (uint32_t)i, positions, count, max);
+   }
+#endif
+
+   while (i < len && count < max) {
+      const char* hit = memchr(data + i, sep, len - i);
+      if (!hit)
+         break;
+
+      positions[count++] = (uint32_t)(hit - data);
+      i = (size_t)(hit - data) + 1;
+   }
+
+   return count;
+}
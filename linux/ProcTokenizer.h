@@ -0,0 +1,83 @@
+#ifndef HEADER_ProcTokenizer
+#define HEADER_ProcTokenizer
+/*
+htop - linux/ProcTokenizer.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * Helpers for splitting and converting the fields of procfs files like
+ * /proc/<pid>/stat and /proc/<pid>/maps. Separators are searched for with
+ * SSE2 or NEON where available, falling back to memchr.
+ */
+
+/* Name of the separator search implementation built in */
+const char* ProcTokenizer_implementation(void);
+
+/*
+ * Store the offsets of up to max occurrences of sep within data[0, len)
+ * into positions and return their number
+ */
+size_t ProcTokenizer_split(const char* data, size_t len, char sep, uint32_t* positions, size_t max);
+
+/*
+ * Convert the decimal number at the start of str[0, len), stopping at the
+ * first non-digit like fast_strtoull_dec; stores the number of digits
+ * consumed into *used
+ */
+static inline uint64_t ProcTokenizer_parseDec(const char* str, size_t len, size_t* used) {
+   uint64_t result = 0;
+   size_t i;
+
+   for (i = 0; i < len && str[i] >= '0' && str[i] <= '9'; i++)
+      result = result * 10 + (uint64_t)(str[i] - '0');
+
+   if (used)
+      *used = i;
+
+   return result;
+}
+
+static inline int64_t ProcTokenizer_parseSignedDec(const char* str, size_t len) {
+   if (len > 0 && str[0] == '-')
+      return -(int64_t)ProcTokenizer_parseDec(str + 1, len - 1, NULL);
+
+   return (int64_t)ProcTokenizer_parseDec(str, len, NULL);
+}
+
+static inline int ProcTokenizer_hexValue(unsigned char c) {
+   if (c >= '0' && c <= '9')
+      return c - '0';
+
+   c |= 0x20;
+   if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+
+   return -1;
+}
+
+/*
+ * Convert the hexadecimal number filling all of str[0, len); the field
+ * boundaries are expected to be known, e.g. from ProcTokenizer_split
+ */
+static inline uint64_t ProcTokenizer_parseHex(const char* str, size_t len) {
+   uint64_t result = 0;
+
+   for (size_t i = 0; i < len; i++) {
+      int nibble = ProcTokenizer_hexValue((unsigned char)str[i]);
+      if (nibble < 0)
+         break;
+
+      result = (result << 4) | (uint64_t)nibble;
+   }
+
+   return result;
+}
+
+#endif /* HEADER_ProcTokenizer */
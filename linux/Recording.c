@@ -0,0 +1,1296 @@
+/*
+htop - linux/Recording.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/Recording.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "CRT.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Platform.h"
+#include "Process.h"
+#include "Row.h"
+#include "RowField.h"
+#include "Settings.h"
+#include "StringPool.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+#include "linux/LinuxProcess.h"
+
+
+#define RECORDING_MAGIC "htoprec"
+#define RECORDING_VERSION 1
+#define RECORDING_KEYFRAME_INTERVAL 60
+
+#define RECORDING_ALIGN(n_) (((n_) + 7) & ~(size_t)7)
+
+typedef struct RecordingFileHeader_ {
+   char magic[8];
+   uint32_t version;
+   uint32_t keyframeInterval;
+} RecordingFileHeader;
+
+typedef enum RecordingRecordType_ {
+   RECORDING_FRAME = 1,
+   RECORDING_KEYFRAME = 2,
+} RecordingRecordType;
+
+typedef struct RecordingRecordHeader_ {
+   uint32_t type;
+   uint32_t length;
+} RecordingRecordHeader;
+
+typedef enum RecordingFieldKind_ {
+   RECORDING_INT,
+   RECORDING_UINT,
+   RECORDING_BOOL,
+   RECORDING_FLOAT,
+   RECORDING_DOUBLE,
+   /* Strings, stored as the index into the strings defined since the last keyframe */
+   RECORDING_STRING,
+   RECORDING_POOLED,      /* shared through the StringPool */
+   RECORDING_CMDLINE,
+   RECORDING_COMM,
+   RECORDING_EXE,
+   RECORDING_USER,
+} RecordingFieldKind;
+
+typedef struct RecordingField_ {
+   size_t offset;
+   size_t size;
+   RecordingFieldKind kind;
+} RecordingField;
+
+#define RECORDING_FIELD(kind_, member_) { offsetof(LinuxProcess, member_), sizeof(((LinuxProcess*)NULL)->member_), kind_ }
+
+/*
+ * Part of the file format: fields are only ever appended. The ones changing
+ * most often come first, keeping the bitmap of changed fields short.
+ * Strings come last, so they are applied after the numbers they relate to.
+ */
+static const RecordingField Recording_fields[] = {
+   RECORDING_FIELD(RECORDING_UINT, super.time),
+   RECORDING_FIELD(RECORDING_UINT, utime),
+   RECORDING_FIELD(RECORDING_UINT, stime),
+   RECORDING_FIELD(RECORDING_FLOAT, super.percent_cpu),
+   RECORDING_FIELD(RECORDING_FLOAT, super.percent_mem),
+   RECORDING_FIELD(RECORDING_INT, super.m_resident),
+   RECORDING_FIELD(RECORDING_INT, super.state),
+   RECORDING_FIELD(RECORDING_INT, super.processor),
+   RECORDING_FIELD(RECORDING_UINT, super.minflt),
+   RECORDING_FIELD(RECORDING_UINT, super.majflt),
+   RECORDING_FIELD(RECORDING_INT, super.m_virt),
+   RECORDING_FIELD(RECORDING_INT, m_share),
+   RECORDING_FIELD(RECORDING_UINT, io_rchar),
+   RECORDING_FIELD(RECORDING_UINT, io_wchar),
+   RECORDING_FIELD(RECORDING_UINT, io_syscr),
+   RECORDING_FIELD(RECORDING_UINT, io_syscw),
+   RECORDING_FIELD(RECORDING_UINT, io_read_bytes),
+   RECORDING_FIELD(RECORDING_UINT, io_write_bytes),
+   RECORDING_FIELD(RECORDING_UINT, io_cancelled_write_bytes),
+   RECORDING_FIELD(RECORDING_DOUBLE, io_rate_read_bps),
+   RECORDING_FIELD(RECORDING_DOUBLE, io_rate_write_bps),
+   RECORDING_FIELD(RECORDING_UINT, ctxt_diff),
+   RECORDING_FIELD(RECORDING_INT, super.nlwp),
+   RECORDING_FIELD(RECORDING_FLOAT, gpu_percent),
+   RECORDING_FIELD(RECORDING_UINT, cminflt),
+   RECORDING_FIELD(RECORDING_UINT, cmajflt),
+   RECORDING_FIELD(RECORDING_UINT, cutime),
+   RECORDING_FIELD(RECORDING_UINT, cstime),
+   RECORDING_FIELD(RECORDING_INT, m_priv),
+   RECORDING_FIELD(RECORDING_INT, m_pss),
+   RECORDING_FIELD(RECORDING_INT, m_swap),
+   RECORDING_FIELD(RECORDING_INT, m_psswp),
+   RECORDING_FIELD(RECORDING_INT, m_trs),
+   RECORDING_FIELD(RECORDING_INT, m_drs),
+   RECORDING_FIELD(RECORDING_INT, m_lrs),
+   RECORDING_FIELD(RECORDING_INT, super.priority),
+   RECORDING_FIELD(RECORDING_INT, super.nice),
+   RECORDING_FIELD(RECORDING_INT, super.scheduling_policy),
+   RECORDING_FIELD(RECORDING_INT, ioPriority),
+   RECORDING_FIELD(RECORDING_UINT, oom),
+   RECORDING_FIELD(RECORDING_INT, autogroup_id),
+   RECORDING_FIELD(RECORDING_INT, autogroup_nice),
+   RECORDING_FIELD(RECORDING_UINT, flags),
+   RECORDING_FIELD(RECORDING_INT, super.super.parent),
+   RECORDING_FIELD(RECORDING_INT, super.super.group),
+   RECORDING_FIELD(RECORDING_INT, super.pgrp),
+   RECORDING_FIELD(RECORDING_INT, super.session),
+   RECORDING_FIELD(RECORDING_INT, super.tpgid),
+   RECORDING_FIELD(RECORDING_UINT, super.tty_nr),
+   RECORDING_FIELD(RECORDING_UINT, super.st_uid),
+   RECORDING_FIELD(RECORDING_INT, super.starttime_ctime),
+   RECORDING_FIELD(RECORDING_UINT, starttime),
+   RECORDING_FIELD(RECORDING_BOOL, super.isKernelThread),
+   RECORDING_FIELD(RECORDING_BOOL, super.isUserlandThread),
+   RECORDING_FIELD(RECORDING_INT, super.isRunningInContainer),
+   RECORDING_FIELD(RECORDING_INT, super.elevated_priv),
+   RECORDING_FIELD(RECORDING_BOOL, super.procExeDeleted),
+   RECORDING_FIELD(RECORDING_BOOL, super.usesDeletedLib),
+   RECORDING_FIELD(RECORDING_INT, super.cmdlineBasenameStart),
+   RECORDING_FIELD(RECORDING_INT, super.cmdlineBasenameEnd),
+   RECORDING_FIELD(RECORDING_CMDLINE, super.cmdline),
+   RECORDING_FIELD(RECORDING_COMM, super.procComm),
+   RECORDING_FIELD(RECORDING_EXE, super.procExe),
+   RECORDING_FIELD(RECORDING_USER, super.user),
+   RECORDING_FIELD(RECORDING_STRING, super.tty_name),
+   RECORDING_FIELD(RECORDING_POOLED, super.procCwd),
+   RECORDING_FIELD(RECORDING_POOLED, cgroup),
+   RECORDING_FIELD(RECORDING_POOLED, cgroup_short),
+   RECORDING_FIELD(RECORDING_POOLED, container_short),
+   RECORDING_FIELD(RECORDING_POOLED, secattr),
+};
+
+#define RECORDING_FIELD_COUNT ARRAYSIZE(Recording_fields)
+#define RECORDING_BITMAP_WORDS 2
+
+static const size_t Recording_cpuPeriods[] = {
+   offsetof(CPUData, totalPeriod),
+   offsetof(CPUData, userPeriod),
+   offsetof(CPUData, systemPeriod),
+   offsetof(CPUData, systemAllPeriod),
+   offsetof(CPUData, idleAllPeriod),
+   offsetof(CPUData, idlePeriod),
+   offsetof(CPUData, nicePeriod),
+   offsetof(CPUData, ioWaitPeriod),
+   offsetof(CPUData, irqPeriod),
+   offsetof(CPUData, softIrqPeriod),
+   offsetof(CPUData, stealPeriod),
+   offsetof(CPUData, guestPeriod),
+};
+
+#define RECORDING_CPU_PERIODS ARRAYSIZE(Recording_cpuPeriods)
+
+/* Last values written or read for a task */
+typedef struct RecordingProcess_ {
+   uint64_t values[RECORDING_FIELD_COUNT];
+   /* Fields read but not yet applied to the process table */
+   uint64_t changed[RECORDING_BITMAP_WORDS];
+   unsigned int generation;
+} RecordingProcess;
+
+typedef struct RecordingCPU_ {
+   bool online;
+   unsigned long long int periods[RECORDING_CPU_PERIODS];
+   double frequency;
+} RecordingCPU;
+
+typedef struct RecordingMachine_ {
+   uint64_t timestampMs;
+   memory_t totalMem;
+   memory_t usedMem;
+   memory_t buffersMem;
+   memory_t cachedMem;
+   memory_t sharedMem;
+   memory_t availableMem;
+   memory_t totalSwap;
+   memory_t usedSwap;
+   memory_t cachedSwap;
+   unsigned int activeCPUs;
+   unsigned int runningTasks;
+   unsigned int cpuCount;
+   RecordingCPU* cpus;
+   size_t cpuCapacity;
+   double load[3];
+   int uptime;
+} RecordingMachine;
+
+typedef struct RecordingString_ {
+   uint64_t hash;
+   uint32_t id;
+   char* value;
+} RecordingString;
+
+typedef struct RecordingBuffer_ {
+   unsigned char* data;
+   size_t size;
+   size_t capacity;
+} RecordingBuffer;
+
+typedef struct RecordingReader_ {
+   const unsigned char* pos;
+   const unsigned char* end;
+   bool error;
+} RecordingReader;
+
+typedef struct RecordingKeyframe_ {
+   size_t frame;
+   size_t offset;
+} RecordingKeyframe;
+
+struct Recording_ {
+   RecordingMode mode;
+   unsigned int keyframeInterval;
+   Hashtable* processes;
+
+   /* Recording */
+   int fd;
+   bool failed;
+   size_t written;
+   unsigned int generation;
+   RecordingBuffer out;
+   RecordingString* pool;
+   size_t poolSize;
+   size_t poolCount;
+   uint32_t nextStringId;
+   uint32_t writtenStrings;
+   ht_key_t* removed;
+   size_t removedCount;
+   size_t removedCapacity;
+
+   /* Replaying */
+   const unsigned char* map;
+   size_t mapSize;
+   RecordingKeyframe* keyframes;
+   size_t keyframeCount;
+   /* Keyframe to decode from for each multiple of the keyframe interval */
+   size_t* slots;
+   size_t frameCount;
+   size_t frame;
+   size_t next;
+   size_t position;
+   const char** strings;
+   size_t stringCount;
+   size_t stringCapacity;
+   RecordingMachine machine;
+};
+
+static RecordingMode Recording_mode = RECORDING_OFF;
+static const char* Recording_path;
+
+/* Answers the Platform_ functions without access to the machine */
+static const Recording* Recording_replaying;
+
+void Recording_configure(RecordingMode mode, const char* path) {
+   Recording_mode = mode;
+   Recording_path = path;
+}
+
+RecordingMode Recording_configuredMode(void) {
+   return Recording_mode;
+}
+
+static unsigned char* RecordingBuffer_reserve(RecordingBuffer* this, size_t len) {
+   if (this->capacity - this->size < len) {
+      size_t capacity = MAXIMUM(MAXIMUM(this->capacity * 2, this->size + len), (size_t)4096);
+      this->data = xRealloc(this->data, capacity);
+      this->capacity = capacity;
+   }
+
+   return this->data + this->size;
+}
+
+static void RecordingBuffer_putBytes(RecordingBuffer* this, const void* data, size_t len) {
+   memcpy(RecordingBuffer_reserve(this, len), data, len);
+   this->size += len;
+}
+
+static void RecordingBuffer_putVarint(RecordingBuffer* this, uint64_t value) {
+   unsigned char* out = RecordingBuffer_reserve(this, 10);
+   size_t n = 0;
+
+   while (value >= 0x80) {
+      out[n++] = (unsigned char)(value | 0x80);
+      value >>= 7;
+   }
+   out[n++] = (unsigned char)value;
+
+   this->size += n;
+}
+
+/* A varint spanning both words */
+static void RecordingBuffer_putBitmap(RecordingBuffer* this, const uint64_t bits[RECORDING_BITMAP_WORDS]) {
+   uint64_t lo = bits[0];
+   uint64_t hi = bits[1];
+
+   do {
+      unsigned char byte = lo & 0x7F;
+      lo = (lo >> 7) | (hi << 57);
+      hi >>= 7;
+      if (lo || hi)
+         byte |= 0x80;
+      RecordingBuffer_putBytes(this, &byte, 1);
+   } while (lo || hi);
+}
+
+static uint64_t RecordingReader_varint(RecordingReader* this) {
+   uint64_t value = 0;
+
+   for (unsigned int shift = 0; shift < 64 && this->pos < this->end; shift += 7) {
+      unsigned char byte = *this->pos++;
+      value |= (uint64_t)(byte & 0x7F) << shift;
+      if (!(byte & 0x80))
+         return value;
+   }
+
+   this->error = true;
+   return 0;
+}
+
+static void RecordingReader_bytes(RecordingReader* this, void* data, size_t len) {
+   if ((size_t)(this->end - this->pos) < len) {
+      this->error = true;
+      memset(data, 0, len);
+      return;
+   }
+
+   memcpy(data, this->pos, len);
+   this->pos += len;
+}
+
+static void RecordingReader_bitmap(RecordingReader* this, uint64_t bits[RECORDING_BITMAP_WORDS]) {
+   bits[0] = 0;
+   bits[1] = 0;
+
+   for (unsigned int shift = 0; shift < 64 * RECORDING_BITMAP_WORDS && this->pos < this->end; shift += 7) {
+      unsigned char byte = *this->pos++;
+      uint64_t group = byte & 0x7F;
+
+      if (shift < 64) {
+         bits[0] |= group << shift;
+         if (shift > 57)
+            bits[1] |= group >> (64 - shift);
+      } else {
+         bits[1] |= group << (shift - 64);
+      }
+
+      if (!(byte & 0x80))
+         return;
+   }
+
+   this->error = true;
+}
+
+static inline uint64_t Recording_zigzag(uint64_t delta) {
+   return (int64_t)delta < 0 ? ~(delta << 1) : delta << 1;
+}
+
+static inline uint64_t Recording_unzigzag(uint64_t value) {
+   return (value & 1) ? ~(value >> 1) : value >> 1;
+}
+
+static inline bool Recording_isString(const RecordingField* field) {
+   return field->kind >= RECORDING_STRING;
+}
+
+/* Fixed point with 0 standing for NAN */
+static uint64_t Recording_fromDouble(double value, double scale) {
+   if (isnan(value) || value < 0.0)
+      return 0;
+
+   return (uint64_t)llround(value * scale) + 1;
+}
+
+static double Recording_toDouble(uint64_t value, double scale) {
+   return value ? (double)(value - 1) / scale : NAN;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Recording                                                              */
+
+static uint64_t Recording_hash(const char* str) {
+   uint64_t hash = 0xcbf29ce484222325ULL;
+
+   for (const unsigned char* c = (const unsigned char*)str; *c; c++) {
+      hash ^= *c;
+      hash *= 0x100000001b3ULL;
+   }
+
+   return hash;
+}
+
+static void Recording_resetPool(Recording* this) {
+   for (size_t i = 0; i < this->poolSize; i++)
+      free(this->pool[i].value);
+
+   if (this->pool)
+      memset(this->pool, 0, this->poolSize * sizeof(RecordingString));
+
+   this->poolCount = 0;
+   this->nextStringId = 1;
+   this->writtenStrings = 1;
+}
+
+static void Recording_growPool(Recording* this) {
+   size_t size = this->poolSize ? this->poolSize * 2 : 256;
+   RecordingString* pool = xCalloc(size, sizeof(RecordingString));
+
+   for (size_t i = 0; i < this->poolSize; i++) {
+      const RecordingString* old = &this->pool[i];
+      if (!old->value)
+         continue;
+
+      size_t j = old->hash & (size - 1);
+      while (pool[j].value)
+         j = (j + 1) & (size - 1);
+      pool[j] = *old;
+   }
+
+   free(this->pool);
+   this->pool = pool;
+   this->poolSize = size;
+}
+
+/* Id of the string since the last keyframe, 0 for NULL */
+static uint32_t Recording_intern(Recording* this, const char* str) {
+   if (!str)
+      return 0;
+
+   if (this->poolCount * 2 >= this->poolSize)
+      Recording_growPool(this);
+
+   uint64_t hash = Recording_hash(str);
+   size_t mask = this->poolSize - 1;
+
+   for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+      RecordingString* slot = &this->pool[i];
+
+      if (!slot->value) {
+         slot->hash = hash;
+         slot->id = this->nextStringId++;
+         slot->value = xStrdup(str);
+         this->poolCount++;
+         return slot->id;
+      }
+
+      if (slot->hash == hash && String_eq(slot->value, str))
+         return slot->id;
+   }
+}
+
+static uint64_t Recording_getField(Recording* this, const LinuxProcess* lp, const RecordingField* field, const char** string) {
+   const char* at = (const char*)lp + field->offset;
+
+   if (Recording_isString(field)) {
+      memcpy(string, at, sizeof(*string));
+      return Recording_intern(this, *string);
+   }
+
+   if (field->kind == RECORDING_INT) {
+      switch (field->size) {
+         case 1: { int8_t v; memcpy(&v, at, 1); return (uint64_t)(int64_t)v; }
+         case 2: { int16_t v; memcpy(&v, at, 2); return (uint64_t)(int64_t)v; }
+         case 4: { int32_t v; memcpy(&v, at, 4); return (uint64_t)(int64_t)v; }
+         default: break;
+      }
+   } else {
+      switch (field->size) {
+         case 1: { uint8_t v; memcpy(&v, at, 1); return v; }
+         case 2: { uint16_t v; memcpy(&v, at, 2); return v; }
+         case 4: { uint32_t v; memcpy(&v, at, 4); return v; }
+         default: break;
+      }
+   }
+
+   assert(field->size == 8);
+   uint64_t v;
+   memcpy(&v, at, sizeof(v));
+   return v;
+}
+
+static void Recording_putValue(Recording* this, const RecordingField* field, uint64_t value, uint64_t previous, const char* string) {
+   RecordingBuffer* out = &this->out;
+
+   switch (field->kind) {
+      case RECORDING_FLOAT: {
+         uint32_t bits = (uint32_t)value;
+         RecordingBuffer_putBytes(out, &bits, sizeof(bits));
+         break;
+      }
+      case RECORDING_DOUBLE:
+         RecordingBuffer_putBytes(out, &value, sizeof(value));
+         break;
+      case RECORDING_INT:
+      case RECORDING_UINT:
+      case RECORDING_BOOL:
+         RecordingBuffer_putVarint(out, Recording_zigzag(value - previous));
+         break;
+      default:
+         /* Strings are defined where they are first used */
+         RecordingBuffer_putVarint(out, value);
+         if (value >= this->writtenStrings) {
+            assert(value == this->writtenStrings);
+            size_t len = strlen(string);
+            RecordingBuffer_putVarint(out, len);
+            RecordingBuffer_putBytes(out, string, len + 1);
+            this->writtenStrings++;
+         }
+         break;
+   }
+}
+
+static void Recording_putMachine(RecordingBuffer* out, const LinuxMachine* lhost) {
+   const Machine* host = &lhost->super;
+
+   RecordingBuffer_putVarint(out, host->realtimeMs);
+   RecordingBuffer_putVarint(out, host->existingCPUs);
+
+   RecordingBuffer_putVarint(out, host->totalMem);
+   RecordingBuffer_putVarint(out, host->usedMem);
+   RecordingBuffer_putVarint(out, host->buffersMem);
+   RecordingBuffer_putVarint(out, host->cachedMem);
+   RecordingBuffer_putVarint(out, host->sharedMem);
+   RecordingBuffer_putVarint(out, host->availableMem);
+   RecordingBuffer_putVarint(out, host->totalSwap);
+   RecordingBuffer_putVarint(out, host->usedSwap);
+   RecordingBuffer_putVarint(out, host->cachedSwap);
+   RecordingBuffer_putVarint(out, host->activeCPUs);
+   RecordingBuffer_putVarint(out, lhost->runningTasks);
+
+   for (unsigned int i = 0; i <= host->existingCPUs; i++) {
+      const CPUData* cpu = &lhost->cpuData[i];
+
+      RecordingBuffer_putVarint(out, cpu->online);
+      for (size_t p = 0; p < RECORDING_CPU_PERIODS; p++) {
+         unsigned long long int period;
+         memcpy(&period, (const char*)cpu + Recording_cpuPeriods[p], sizeof(period));
+         RecordingBuffer_putVarint(out, period);
+      }
+      RecordingBuffer_putVarint(out, Recording_fromDouble(cpu->frequency, 1.0));
+   }
+
+   double load[3];
+   Platform_getLoadAverage(&load[0], &load[1], &load[2]);
+   for (size_t i = 0; i < ARRAYSIZE(load); i++)
+      RecordingBuffer_putVarint(out, Recording_fromDouble(load[i], 100.0));
+
+   RecordingBuffer_putVarint(out, (uint64_t)MAXIMUM(Platform_getUptime(), 0));
+}
+
+static void Recording_putUint32(RecordingBuffer* out, size_t at, uint32_t value) {
+   memcpy(out->data + at, &value, sizeof(value));
+}
+
+static void Recording_collectRemoved(ht_key_t key, void* value, void* data) {
+   Recording* this = data;
+   const RecordingProcess* entry = value;
+
+   if (entry->generation == this->generation)
+      return;
+
+   if (this->removedCount == this->removedCapacity) {
+      this->removedCapacity = this->removedCapacity ? this->removedCapacity * 2 : 64;
+      this->removed = xReallocArray(this->removed, this->removedCapacity, sizeof(ht_key_t));
+   }
+   this->removed[this->removedCount++] = key;
+}
+
+void Recording_writeFrame(Recording* this, const LinuxMachine* host, const ProcessTable* pt) {
+   assert(this->mode == RECORDING_WRITE);
+
+   if (this->failed)
+      return;
+
+   const bool keyframe = this->written % this->keyframeInterval == 0;
+   if (keyframe) {
+      Hashtable_clear(this->processes);
+      Recording_resetPool(this);
+   }
+
+   RecordingBuffer* out = &this->out;
+   out->size = 0;
+   RecordingBuffer_reserve(out, sizeof(RecordingRecordHeader));
+   out->size = sizeof(RecordingRecordHeader);
+
+   Recording_putMachine(out, host);
+
+   /* Tasks with changes, their number being filled in afterwards */
+   size_t countAt = out->size;
+   uint32_t count = 0;
+   RecordingBuffer_reserve(out, sizeof(count));
+   out->size += sizeof(count);
+
+   this->generation++;
+
+   const Vector* rows = pt->super.rows;
+   for (int i = 0; i < Vector_size(rows); i++) {
+      const Row* row = (const Row*) Vector_get(rows, i);
+      if (!row->updated)
+         continue;
+
+      const LinuxProcess* lp = (const LinuxProcess*) row;
+      ht_key_t pid = (ht_key_t) row->id;
+
+      RecordingProcess* entry = Hashtable_get(this->processes, pid);
+      const bool added = !entry;
+      if (added) {
+         entry = xCalloc(1, sizeof(RecordingProcess));
+         Hashtable_put(this->processes, pid, entry);
+      }
+      entry->generation = this->generation;
+
+      uint64_t values[RECORDING_FIELD_COUNT];
+      const char* strings[RECORDING_FIELD_COUNT];
+      uint64_t changed[RECORDING_BITMAP_WORDS] = { 0, 0 };
+
+      for (size_t f = 0; f < RECORDING_FIELD_COUNT; f++) {
+         strings[f] = NULL;
+         values[f] = Recording_getField(this, lp, &Recording_fields[f], &strings[f]);
+         if (values[f] != entry->values[f])
+            changed[f / 64] |= 1ULL << (f % 64);
+      }
+
+      if (!added && !changed[0] && !changed[1])
+         continue;
+
+      RecordingBuffer_putVarint(out, pid);
+      RecordingBuffer_putBitmap(out, changed);
+      for (size_t f = 0; f < RECORDING_FIELD_COUNT; f++) {
+         if (!(changed[f / 64] & (1ULL << (f % 64))))
+            continue;
+
+         Recording_putValue(this, &Recording_fields[f], values[f], entry->values[f], strings[f]);
+         entry->values[f] = values[f];
+      }
+      count++;
+   }
+   Recording_putUint32(out, countAt, count);
+
+   /* Tasks gone since the previous sample */
+   this->removedCount = 0;
+   Hashtable_foreach(this->processes, Recording_collectRemoved, this);
+
+   uint32_t removed = (uint32_t)this->removedCount;
+   RecordingBuffer_putBytes(out, &removed, sizeof(removed));
+   for (size_t i = 0; i < this->removedCount; i++) {
+      RecordingBuffer_putVarint(out, this->removed[i]);
+      Hashtable_remove(this->processes, this->removed[i]);
+   }
+
+   RecordingRecordHeader header = {
+      .type = keyframe ? RECORDING_KEYFRAME : RECORDING_FRAME,
+      .length = (uint32_t)(out->size - sizeof(header)),
+   };
+   memcpy(out->data, &header, sizeof(header));
+
+   size_t padding = RECORDING_ALIGN(out->size) - out->size;
+   memset(RecordingBuffer_reserve(out, padding), 0, padding);
+   out->size += padding;
+
+   /* One write per sample; on failure, e.g. a full disk, recording stops */
+   if (full_write(this->fd, out->data, out->size) < 0) {
+      this->failed = true;
+      return;
+   }
+
+   this->written++;
+}
+
+/* ---------------------------------------------------------------------- */
+/* File layout                                                            */
+
+static bool Recording_checkHeader(const unsigned char* map, size_t size, unsigned int* keyframeInterval) {
+   RecordingFileHeader header;
+
+   if (size < sizeof(header))
+      return false;
+
+   memcpy(&header, map, sizeof(header));
+   if (memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != RECORDING_VERSION ||
+       header.keyframeInterval == 0)
+      return false;
+
+   *keyframeInterval = header.keyframeInterval;
+   return true;
+}
+
+/*
+ * Walk the records, returning the end of the last complete one. With an
+ * index to fill, remember where each keyframe starts.
+ */
+static size_t Recording_scan(Recording* this, const unsigned char* map, size_t size, bool index) {
+   size_t pos = sizeof(RecordingFileHeader);
+   size_t capacity = 0;
+
+   while (size - pos >= sizeof(RecordingRecordHeader)) {
+      RecordingRecordHeader header;
+      memcpy(&header, map + pos, sizeof(header));
+
+      if (RECORDING_ALIGN(header.length) > size - pos - sizeof(header))
+         break;
+
+      if (index && (header.type == RECORDING_FRAME || header.type == RECORDING_KEYFRAME)) {
+         if (header.type == RECORDING_KEYFRAME) {
+            if (this->keyframeCount == capacity) {
+               capacity = capacity ? capacity * 2 : 64;
+               this->keyframes = xReallocArray(this->keyframes, capacity, sizeof(RecordingKeyframe));
+            }
+            this->keyframes[this->keyframeCount++] = (RecordingKeyframe) { .frame = this->frameCount, .offset = pos };
+         }
+
+         /* Samples before the first keyframe cannot be decoded */
+         if (this->keyframeCount)
+            this->frameCount++;
+      }
+
+      pos += sizeof(header) + RECORDING_ALIGN(header.length);
+   }
+
+   return pos;
+}
+
+static void Recording_openWrite(Recording* this) {
+   this->fd = open(Recording_path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+   if (this->fd < 0)
+      CRT_fatalError("Cannot open recording file");
+
+   struct stat sb;
+   if (fstat(this->fd, &sb) != 0)
+      CRT_fatalError("Cannot stat recording file");
+
+   if (sb.st_size == 0) {
+      RecordingFileHeader header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+      header.version = RECORDING_VERSION;
+      header.keyframeInterval = RECORDING_KEYFRAME_INTERVAL;
+
+      if (full_write(this->fd, &header, sizeof(header)) != (ssize_t)sizeof(header))
+         CRT_fatalError("Cannot write recording file");
+
+      this->keyframeInterval = RECORDING_KEYFRAME_INTERVAL;
+      return;
+   }
+
+   /* Append to an earlier recording, dropping a sample cut short by a crash */
+   size_t size = (size_t)sb.st_size;
+   void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+   if (map == MAP_FAILED)
+      CRT_fatalError("Cannot map recording file");
+
+   if (!Recording_checkHeader(map, size, &this->keyframeInterval)) {
+      errno = EINVAL;
+      CRT_fatalError("Cannot append to recording file");
+   }
+
+   size_t end = Recording_scan(this, map, size, false);
+   munmap(map, size);
+
+   if (end < size && ftruncate(this->fd, (off_t)end) != 0)
+      CRT_fatalError("Cannot truncate recording file");
+}
+
+static void Recording_openReplay(Recording* this, LinuxMachine* host) {
+   int fd = open(Recording_path, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      CRT_fatalError("Cannot open recording file");
+
+   struct stat sb;
+   if (fstat(fd, &sb) != 0)
+      CRT_fatalError("Cannot stat recording file");
+
+   this->fd = -1;
+   this->mapSize = (size_t)sb.st_size;
+   void* map = this->mapSize ? mmap(NULL, this->mapSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+   close(fd);
+
+   errno = EINVAL;
+   if (map == MAP_FAILED || !Recording_checkHeader(map, this->mapSize, &this->keyframeInterval))
+      CRT_fatalError("Cannot replay recording file");
+   this->map = map;
+
+   Recording_scan(this, this->map, this->mapSize, true);
+   if (!this->frameCount) {
+      errno = ENODATA;
+      CRT_fatalError("Cannot replay recording file");
+   }
+
+   size_t slotCount = (this->frameCount + this->keyframeInterval - 1) / this->keyframeInterval;
+   this->slots = xCalloc(slotCount, sizeof(size_t));
+   for (size_t s = 0, k = 0; s < slotCount; s++) {
+      while (k + 1 < this->keyframeCount && this->keyframes[k + 1].frame <= s * this->keyframeInterval)
+         k++;
+      this->slots[s] = k;
+   }
+
+   /* The CPU meters are set up for the CPUs of the recorded machine */
+   RecordingReader reader = {
+      .pos = this->map + this->keyframes[0].offset + sizeof(RecordingRecordHeader),
+      .end = this->map + this->mapSize,
+      .error = false,
+   };
+   (void) RecordingReader_varint(&reader);
+   uint64_t recordedCPUs = RecordingReader_varint(&reader);
+   unsigned int cpus = (unsigned int) CLAMP(recordedCPUs, 1, 65536);
+
+   host->super.existingCPUs = cpus;
+   host->super.activeCPUs = cpus;
+   host->cpuData = xCalloc(cpus + 1, sizeof(CPUData));
+   for (unsigned int i = 0; i <= cpus; i++)
+      host->cpuData[i].online = true;
+
+   /* String 0 stands for NULL */
+   this->stringCapacity = 256;
+   this->strings = xCalloc(this->stringCapacity, sizeof(const char*));
+   this->stringCount = 1;
+
+   this->frame = SIZE_MAX;
+   this->next = 0;
+   Recording_replaying = this;
+}
+
+Recording* Recording_open(LinuxMachine* host) {
+   if (Recording_mode == RECORDING_OFF)
+      return NULL;
+
+   assert(RECORDING_FIELD_COUNT <= 64 * RECORDING_BITMAP_WORDS);
+
+   Recording* this = xCalloc(1, sizeof(Recording));
+   this->mode = Recording_mode;
+   this->processes = Hashtable_new(256, true);
+   this->nextStringId = 1;
+   this->writtenStrings = 1;
+
+   if (this->mode == RECORDING_WRITE)
+      Recording_openWrite(this);
+   else
+      Recording_openReplay(this, host);
+
+   return this;
+}
+
+void Recording_delete(Recording* this) {
+   if (!this)
+      return;
+
+   if (this->mode == RECORDING_WRITE) {
+      close(this->fd);
+      Recording_resetPool(this);
+   } else {
+      munmap((void*)(uintptr_t)this->map, this->mapSize);
+   }
+
+   if (Recording_replaying == this)
+      Recording_replaying = NULL;
+
+   Hashtable_delete(this->processes);
+   free(this->out.data);
+   free(this->pool);
+   free(this->removed);
+   free(this->keyframes);
+   free(this->slots);
+   free(this->strings);
+   free(this->machine.cpus);
+   free(this);
+}
+
+bool Recording_isReplay(const Recording* this) {
+   return this->mode == RECORDING_REPLAY;
+}
+
+unsigned int Recording_keyframeInterval(const Recording* this) {
+   return this->keyframeInterval;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Replaying                                                              */
+
+static uint64_t Recording_readString(Recording* this, RecordingReader* reader) {
+   uint64_t id = RecordingReader_varint(reader);
+
+   if (id == this->stringCount) {
+      uint64_t len = RecordingReader_varint(reader);
+      if (reader->error || len >= (uint64_t)(reader->end - reader->pos) || reader->pos[len] != '\0') {
+         reader->error = true;
+         return 0;
+      }
+
+      if (this->stringCount == this->stringCapacity) {
+         this->stringCapacity = this->stringCapacity ? this->stringCapacity * 2 : 256;
+         this->strings = xReallocArray(this->strings, this->stringCapacity, sizeof(const char*));
+      }
+
+      /* Strings are used right from the mapped file */
+      this->strings[this->stringCount++] = (const char*)reader->pos;
+      reader->pos += len + 1;
+   } else if (id > this->stringCount) {
+      reader->error = true;
+      return 0;
+   }
+
+   return id;
+}
+
+static uint64_t Recording_readValue(Recording* this, RecordingReader* reader, const RecordingField* field, uint64_t previous) {
+   switch (field->kind) {
+      case RECORDING_FLOAT: {
+         uint32_t bits;
+         RecordingReader_bytes(reader, &bits, sizeof(bits));
+         return bits;
+      }
+      case RECORDING_DOUBLE: {
+         uint64_t bits;
+         RecordingReader_bytes(reader, &bits, sizeof(bits));
+         return bits;
+      }
+      case RECORDING_INT:
+      case RECORDING_UINT:
+      case RECORDING_BOOL:
+         return previous + Recording_unzigzag(RecordingReader_varint(reader));
+      default:
+         return Recording_readString(this, reader);
+   }
+}
+
+static void Recording_readMachine(Recording* this, RecordingReader* reader) {
+   RecordingMachine* m = &this->machine;
+
+   m->timestampMs = RecordingReader_varint(reader);
+   uint64_t cpuCount = RecordingReader_varint(reader);
+   m->cpuCount = (unsigned int) MINIMUM(cpuCount, 65536);
+
+   m->totalMem = RecordingReader_varint(reader);
+   m->usedMem = RecordingReader_varint(reader);
+   m->buffersMem = RecordingReader_varint(reader);
+   m->cachedMem = RecordingReader_varint(reader);
+   m->sharedMem = RecordingReader_varint(reader);
+   m->availableMem = RecordingReader_varint(reader);
+   m->totalSwap = RecordingReader_varint(reader);
+   m->usedSwap = RecordingReader_varint(reader);
+   m->cachedSwap = RecordingReader_varint(reader);
+   m->activeCPUs = (unsigned int) RecordingReader_varint(reader);
+   m->runningTasks = (unsigned int) RecordingReader_varint(reader);
+
+   if (m->cpuCount + 1 > m->cpuCapacity) {
+      m->cpuCapacity = m->cpuCount + 1;
+      m->cpus = xReallocArray(m->cpus, m->cpuCapacity, sizeof(RecordingCPU));
+   }
+
+   for (unsigned int i = 0; i <= m->cpuCount && !reader->error; i++) {
+      RecordingCPU* cpu = &m->cpus[i];
+
+      cpu->online = RecordingReader_varint(reader) != 0;
+      for (size_t p = 0; p < RECORDING_CPU_PERIODS; p++)
+         cpu->periods[p] = RecordingReader_varint(reader);
+      cpu->frequency = Recording_toDouble(RecordingReader_varint(reader), 1.0);
+   }
+
+   for (size_t i = 0; i < ARRAYSIZE(m->load); i++)
+      m->load[i] = Recording_toDouble(RecordingReader_varint(reader), 100.0);
+
+   uint64_t uptime = RecordingReader_varint(reader);
+   m->uptime = (int) MINIMUM(uptime, INT_MAX);
+}
+
+static bool Recording_readRecord(Recording* this) {
+   while (this->mapSize - this->position >= sizeof(RecordingRecordHeader)) {
+      RecordingRecordHeader header;
+      memcpy(&header, this->map + this->position, sizeof(header));
+
+      RecordingReader reader = {
+         .pos = this->map + this->position + sizeof(header),
+         .end = this->map + this->position + sizeof(header) + header.length,
+         .error = false,
+      };
+      this->position += sizeof(header) + RECORDING_ALIGN(header.length);
+
+      if (header.type != RECORDING_FRAME && header.type != RECORDING_KEYFRAME)
+         continue;
+
+      if (header.type == RECORDING_KEYFRAME) {
+         Hashtable_clear(this->processes);
+         this->stringCount = 1;
+      }
+
+      Recording_readMachine(this, &reader);
+
+      uint32_t count;
+      RecordingReader_bytes(&reader, &count, sizeof(count));
+      for (uint32_t i = 0; i < count && !reader.error; i++) {
+         uint64_t pid = RecordingReader_varint(&reader);
+         if (pid == 0 || pid > INT_MAX) {
+            reader.error = true;
+            break;
+         }
+
+         uint64_t changed[RECORDING_BITMAP_WORDS];
+         RecordingReader_bitmap(&reader, changed);
+
+         RecordingProcess* entry = Hashtable_get(this->processes, (ht_key_t)pid);
+         if (!entry) {
+            entry = xCalloc(1, sizeof(RecordingProcess));
+            /* The row may still hold values of an earlier task */
+            memset(entry->changed, 0xFF, sizeof(entry->changed));
+            Hashtable_put(this->processes, (ht_key_t)pid, entry);
+         }
+
+         for (size_t f = 0; f < RECORDING_FIELD_COUNT; f++) {
+            if (!(changed[f / 64] & (1ULL << (f % 64))))
+               continue;
+
+            entry->values[f] = Recording_readValue(this, &reader, &Recording_fields[f], entry->values[f]);
+            entry->changed[f / 64] |= 1ULL << (f % 64);
+         }
+      }
+
+      RecordingReader_bytes(&reader, &count, sizeof(count));
+      for (uint32_t i = 0; i < count && !reader.error; i++)
+         Hashtable_remove(this->processes, (ht_key_t)RecordingReader_varint(&reader));
+
+      return !reader.error;
+   }
+
+   return false;
+}
+
+static void Recording_applyMachine(const Recording* this, LinuxMachine* lhost) {
+   Machine* host = &lhost->super;
+   const RecordingMachine* m = &this->machine;
+
+   host->realtimeMs = m->timestampMs;
+   host->realtime.tv_sec = (time_t)(m->timestampMs / 1000);
+   host->realtime.tv_usec = (suseconds_t)(m->timestampMs % 1000 * 1000);
+
+   host->totalMem = m->totalMem;
+   host->usedMem = m->usedMem;
+   host->buffersMem = m->buffersMem;
+   host->cachedMem = m->cachedMem;
+   host->sharedMem = m->sharedMem;
+   host->availableMem = m->availableMem;
+   host->totalSwap = m->totalSwap;
+   host->usedSwap = m->usedSwap;
+   host->cachedSwap = m->cachedSwap;
+   host->activeCPUs = CLAMP(m->activeCPUs, 1, host->existingCPUs);
+   lhost->runningTasks = m->runningTasks;
+
+   unsigned int cpus = MINIMUM(m->cpuCount, host->existingCPUs);
+   for (unsigned int i = 0; i <= cpus; i++) {
+      CPUData* cpu = &lhost->cpuData[i];
+      const RecordingCPU* recorded = &m->cpus[i];
+
+      cpu->online = i == 0 || recorded->online;
+      for (size_t p = 0; p < RECORDING_CPU_PERIODS; p++)
+         memcpy((char*)cpu + Recording_cpuPeriods[p], &recorded->periods[p], sizeof(recorded->periods[p]));
+      cpu->frequency = recorded->frequency;
+   }
+}
+
+static void Recording_updateCmdline(Process* proc, const char* cmdline) {
+   if (!cmdline || !cmdline[0]) {
+      Process_updateCmdline(proc, NULL, 0, 0);
+      return;
+   }
+
+   /* The recorded basename offsets were applied before */
+   int len = (int)strlen(cmdline);
+   int start = proc->cmdlineBasenameStart;
+   int end = proc->cmdlineBasenameEnd;
+   if (start < 0 || end > len || start >= end) {
+      start = 0;
+      end = len;
+   }
+
+   Process_updateCmdline(proc, cmdline, start, end);
+}
+
+static void Recording_setField(const Recording* this, LinuxProcess* lp, const RecordingField* field, uint64_t value) {
+   char* at = (char*)lp + field->offset;
+   Process* proc = &lp->super;
+   const char* str = value < this->stringCount ? this->strings[value] : NULL;
+
+   switch (field->kind) {
+      case RECORDING_FLOAT: {
+         float v;
+         uint32_t bits = (uint32_t)value;
+         memcpy(&v, &bits, sizeof(v));
+         /* Values no sample could hold come from a damaged file */
+         if (!(fabsf(v) < 1e15F))
+            v = NAN;
+         memcpy(at, &v, sizeof(v));
+         break;
+      }
+      case RECORDING_DOUBLE: {
+         double v;
+         memcpy(&v, &value, sizeof(v));
+         if (!(fabs(v) < 1e15))
+            v = NAN;
+         memcpy(at, &v, sizeof(v));
+         break;
+      }
+      case RECORDING_INT:
+      case RECORDING_UINT:
+         switch (field->size) {
+            case 1: { uint8_t v = (uint8_t)value; memcpy(at, &v, 1); break; }
+            case 2: { uint16_t v = (uint16_t)value; memcpy(at, &v, 2); break; }
+            case 4: { uint32_t v = (uint32_t)value; memcpy(at, &v, 4); break; }
+            default: memcpy(at, &value, sizeof(value)); break;
+         }
+         break;
+      case RECORDING_BOOL: {
+         bool v = value != 0;
+         memcpy(at, &v, sizeof(v));
+         break;
+      }
+      case RECORDING_STRING: {
+         char* old;
+         memcpy(&old, at, sizeof(old));
+         free(old);
+         char* copy = str ? xStrdup(str) : NULL;
+         memcpy(at, &copy, sizeof(copy));
+         break;
+      }
+      case RECORDING_POOLED: {
+         const char* shared;
+         memcpy(&shared, at, sizeof(shared));
+         StringPool_replace(&shared, str);
+         memcpy(at, &shared, sizeof(shared));
+         break;
+      }
+      case RECORDING_CMDLINE:
+         Recording_updateCmdline(proc, str);
+         break;
+      case RECORDING_COMM:
+         Process_updateComm(proc, str);
+         break;
+      case RECORDING_EXE:
+         Process_updateExe(proc, str);
+         break;
+      case RECORDING_USER:
+         /* Like the names owned by the UsersTable, these live as long as the mapping */
+         memcpy(at, &str, sizeof(str));
+         break;
+   }
+}
+
+typedef struct RecordingApply_ {
+   const Recording* recording;
+   ProcessTable* pt;
+} RecordingApply;
+
+static void Recording_applyProcess(ht_key_t pid, void* value, void* data) {
+   const RecordingApply* apply = data;
+   RecordingProcess* entry = value;
+   ProcessTable* pt = apply->pt;
+   const Settings* settings = pt->super.host->settings;
+
+   bool preExisting;
+   Process* proc = ProcessTable_getProcess(pt, (pid_t)pid, &preExisting, LinuxProcess_new);
+   LinuxProcess* lp = (LinuxProcess*) proc;
+
+   if (!preExisting)
+      memset(entry->changed, 0xFF, sizeof(entry->changed));
+
+   time_t starttime = proc->starttime_ctime;
+   bool changed = false;
+   for (size_t f = 0; f < RECORDING_FIELD_COUNT; f++) {
+      if (entry->changed[f / 64] & (1ULL << (f % 64))) {
+         Recording_setField(apply->recording, lp, &Recording_fields[f], entry->values[f]);
+         changed = true;
+      }
+   }
+   memset(entry->changed, 0, sizeof(entry->changed));
+
+   if (changed)
+      Row_markDirty(&proc->super);
+
+   if (!preExisting || proc->starttime_ctime != starttime)
+      Process_fillStarttimeBuffer(proc);
+
+   Process_updateCPUFieldWidths(proc->percent_cpu);
+   if (lp->cgroup) {
+      Row_updateFieldWidth(CGROUP, strlen(lp->cgroup));
+      Row_updateFieldWidth(CCGROUP, strlen(lp->cgroup_short ? lp->cgroup_short : lp->cgroup));
+      Row_updateFieldWidth(CONTAINER, lp->container_short ? strlen(lp->container_short) : strlen("N/A"));
+   }
+
+   proc->super.updated = true;
+
+   if (settings->hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
+      proc->super.show = false;
+   } else {
+      if (Process_isKernelThread(proc)) {
+         pt->kernelThreads++;
+      } else if (Process_isUserlandThread(proc)) {
+         pt->userlandThreads++;
+      }
+
+      proc->super.show = ! ((settings->hideKernelThreads && Process_isKernelThread(proc)) || (settings->hideUserlandThreads && Process_isUserlandThread(proc)));
+      pt->totalTasks++;
+   }
+
+   if (!preExisting)
+      ProcessTable_add(pt, proc);
+}
+
+void Recording_readFrame(Recording* this, LinuxMachine* host, ProcessTable* pt) {
+   assert(this->mode == RECORDING_REPLAY);
+
+   size_t target = MINIMUM(this->next, this->frameCount - 1);
+
+   if (target != this->frame) {
+      size_t current;
+
+      if (this->frame == SIZE_MAX || target < this->frame || target - this->frame > this->keyframeInterval) {
+         const RecordingKeyframe* keyframe = &this->keyframes[this->slots[target / this->keyframeInterval]];
+         this->position = keyframe->offset;
+         current = keyframe->frame;
+      } else {
+         current = this->frame + 1;
+      }
+
+      for (;;) {
+         if (!Recording_readRecord(this)) {
+            /* Stop at the last sample that could be read */
+            this->frameCount = MAXIMUM(current, (size_t)1);
+            break;
+         }
+         if (current == target)
+            break;
+         current++;
+      }
+
+      this->frame = MINIMUM(current, this->frameCount - 1);
+   }
+
+   this->next = this->frame + 1;
+
+   Recording_applyMachine(this, host);
+
+   RecordingApply apply = { .recording = this, .pt = pt };
+   Hashtable_foreach(this->processes, Recording_applyProcess, &apply);
+   pt->runningTasks = this->machine.runningTasks;
+}
+
+void Recording_step(Recording* this, long frames) {
+   if (this->mode != RECORDING_REPLAY)
+      return;
+
+   long current = this->frame == SIZE_MAX ? 0 : (long)this->frame;
+   this->next = (size_t) CLAMP(current + frames, 0L, (long)this->frameCount - 1);
+}
+
+bool Recording_getLoadAverage(double* one, double* five, double* fifteen) {
+   if (!Recording_replaying)
+      return false;
+
+   *one = Recording_replaying->machine.load[0];
+   *five = Recording_replaying->machine.load[1];
+   *fifteen = Recording_replaying->machine.load[2];
+   return true;
+}
+
+bool Recording_getUptime(int* uptime) {
+   if (!Recording_replaying)
+      return false;
+
+   *uptime = Recording_replaying->machine.uptime;
+   return true;
+}
@@ -0,0 +1,64 @@
+#ifndef HEADER_Recording
+#define HEADER_Recording
+/*
+htop - linux/Recording.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ProcessTable.h"
+
+
+/*
+ * Recording files start with a RecordingFileHeader, followed by records of
+ * one sample each, aligned to 8 bytes. A record holds the machine values
+ * and the processes that changed since the previous sample as varints;
+ * unchanged fields are left out and strings are stored once, in the
+ * sample first using them. Every keyframe interval a self-contained
+ * keyframe resets all of this, so replay can seek to any sample by
+ * decoding from the keyframe before it.
+ */
+
+struct LinuxMachine_;
+
+typedef enum RecordingMode_ {
+   RECORDING_OFF,
+   RECORDING_WRITE,
+   RECORDING_REPLAY,
+} RecordingMode;
+
+typedef struct Recording_ Recording;
+
+/* Select the file to append samples to or to replay, before creating the machine */
+void Recording_configure(RecordingMode mode, const char* path);
+
+RecordingMode Recording_configuredMode(void);
+
+/* Opens the configured recording, NULL if there is none; failures are fatal */
+Recording* Recording_open(struct LinuxMachine_* host);
+
+void Recording_delete(Recording* this);
+
+bool Recording_isReplay(const Recording* this);
+
+/* Append the current sample of the machine and its processes */
+void Recording_writeFrame(Recording* this, const struct LinuxMachine_* host, const ProcessTable* pt);
+
+/* Load the next recorded sample into the machine and the process table */
+void Recording_readFrame(Recording* this, struct LinuxMachine_* host, ProcessTable* pt);
+
+/* Move the sample loaded next by the given number of samples, relative to the current one */
+void Recording_step(Recording* this, long frames);
+
+unsigned int Recording_keyframeInterval(const Recording* this);
+
+/* Values of the replayed sample, false if not replaying */
+bool Recording_getLoadAverage(double* one, double* five, double* fifteen);
+
+bool Recording_getUptime(int* uptime);
+
+#endif /* HEADER_Recording */
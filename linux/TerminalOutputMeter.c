@@ -0,0 +1,96 @@
+/*
+htop - TerminalOutputMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/TerminalOutputMeter.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "CRT.h"
+#include "Object.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+static const int TerminalOutputMeter_attributes[] = {
+   METER_VALUE,
+};
+
+static bool haveSample = false;
+static uint64_t lastWritten;
+static uint64_t lastFrames;
+
+/*
+ * Bytes written by htop so far. Apart from a recording being written and
+ * settings being saved on exit, all of it is terminal output.
+ */
+static bool TerminalOutputMeter_readWritten(uint64_t* written) {
+   char buffer[512];
+   ssize_t r = xReadfile(PROCDIR "/self/io", buffer, sizeof(buffer));
+   if (r < 0)
+      return false;
+
+   const char* line = strstr(buffer, "wchar:");
+   if (!line)
+      return false;
+
+   char* end;
+   unsigned long long value = strtoull(line + strlen("wchar:"), &end, 10);
+   if (end == line + strlen("wchar:"))
+      return false;
+
+   *written = value;
+   return true;
+}
+
+static void TerminalOutputMeter_updateValues(Meter* this) {
+   uint64_t written;
+   if (!TerminalOutputMeter_readWritten(&written)) {
+      haveSample = false;
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
+      return;
+   }
+
+   uint64_t frames = CRT_frameCount;
+
+   if (!haveSample || written < lastWritten) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "...");
+   } else if (frames == lastFrames) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no frames");
+   } else {
+      uint64_t count = frames - lastFrames;
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%"PRIu64" B/frame over %"PRIu64" frame%s",
+         (written - lastWritten) / count, count, count == 1 ? "" : "s");
+   }
+
+   haveSample = true;
+   lastWritten = written;
+   lastFrames = frames;
+}
+
+const MeterClass TerminalOutputMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+   },
+   .updateValues = TerminalOutputMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 0,
+   .total = 0.0,
+   .attributes = TerminalOutputMeter_attributes,
+   .name = "TerminalOutput",
+   .uiName = "Terminal output",
+   .description = "Bytes written to the terminal per screen update, for debugging",
+   .caption = "Terminal: "
+};
@@ -0,0 +1,15 @@
+#ifndef HEADER_TerminalOutputMeter
+#define HEADER_TerminalOutputMeter
+/*
+htop - TerminalOutputMeter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+extern const MeterClass TerminalOutputMeter_class;
+
+#endif /* HEADER_TerminalOutputMeter */
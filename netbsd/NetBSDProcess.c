@@ -272,6 +272,7 @@ const ProcessClass NetBSDProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = NetBSDProcess_rowWriteField
    },
    .compareByKey = NetBSDProcess_compareByKey
@@ -264,6 +264,7 @@ const ProcessClass OpenBSDProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = OpenBSDProcess_rowWriteField
    },
    .compareByKey = OpenBSDProcess_compareByKey
@@ -304,6 +304,7 @@ const ProcessClass PCPProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = PCPProcess_rowWriteField,
    },
    .compareByKey = PCPProcess_compareByKey,
@@ -292,7 +292,9 @@ static void PCPProcessTable_readSecattrData(PCPProcess* pp, int pid, int offset)
 }
 
 static void PCPProcessTable_readCwd(PCPProcess* pp, int pid, int offset) {
-   pp->super.procCwd = setString(PCP_PROC_CWD, pid, offset, pp->super.procCwd);
+   char* cwd = setString(PCP_PROC_CWD, pid, offset, NULL);
+   Process_updateCwd(&pp->super, cwd);
+   free(cwd);
 }
 
 static void PCPProcessTable_updateUsername(Process* process, int pid, int offset, UsersTable* users) {
@@ -35,6 +35,7 @@ in the source distribution for its full text.
 #include "Meter.h"
 #include "NetworkIOMeter.h"
 #include "ProcessTable.h"
+#include "SelfMeter.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -118,6 +119,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &NetworkIOMeter_class,
    &SysArchMeter_class,
    &FileDescriptorMeter_class,
+   &SelfMeter_class,
    &BlankMeter_class,
    &DynamicMeter_class,
    NULL
@@ -0,0 +1,202 @@
+#!/bin/sh
+
+# Generate a synthetic procfs tree for benchmarking the Linux scan.
+#
+# Build htop against it with
+#    ./configure --with-proc=DIR && make
+# and time the refreshes with
+#    ./htop --output=csv --timings -n 20 -d 1 >/dev/null
+
+set -e
+
+processes=1000
+threads=4
+maps=64
+cgroups=16
+
+usage() {
+   echo "Usage: $0 [-p PROCESSES] [-t THREADS] [-m MAPS] [-c CGROUPS] DIR"
+   echo "   -p PROCESSES   number of processes (default $processes)"
+   echo "   -t THREADS     threads per process, main thread included (default $threads)"
+   echo "   -m MAPS        lines of /proc/PID/maps per process (default $maps)"
+   echo "   -c CGROUPS     number of distinct cgroups (default $cgroups)"
+   exit 1
+}
+
+while getopts "p:t:m:c:h" opt; do
+   case "$opt" in
+      p) processes=$OPTARG ;;
+      t) threads=$OPTARG ;;
+      m) maps=$OPTARG ;;
+      c) cgroups=$OPTARG ;;
+      *) usage ;;
+   esac
+done
+shift $((OPTIND - 1))
+
+[ $# -eq 1 ] || usage
+dir=$1
+
+if [ -e "$dir" ] && [ -n "$(ls -A "$dir")" ]; then
+   echo "$0: $dir exists and is not empty" >&2
+   exit 1
+fi
+
+mkdir -p "$dir/sys/kernel" "$dir/sys/fs" "$dir/net" "$dir/tty"
+
+# Machine wide files
+awk -v dir="$dir" -v processes="$processes" -v threads="$threads" '
+BEGIN {
+   cpus = 4
+   f = dir "/stat"
+   printf "cpu  %d 0 %d %d 0 0 0 0 0 0\n", cpus * 500000, cpus * 100000, cpus * 4000000 > f
+   for (c = 0; c < cpus; c++)
+      printf "cpu%d 500000 0 100000 4000000 0 0 0 0 0 0\n", c > f
+   printf "ctxt 1000000\nbtime 1700000000\nprocesses %d\nprocs_running 1\nprocs_blocked 0\n", processes > f
+   close(f)
+
+   f = dir "/cpuinfo"
+   for (c = 0; c < cpus; c++)
+      printf "processor\t: %d\nmodel name\t: Synthetic CPU\ncpu MHz\t\t: 2000.000\n\n", c > f
+   close(f)
+
+   f = dir "/meminfo"
+   printf "MemTotal:       16384000 kB\nMemFree:         8192000 kB\nMemAvailable:   12288000 kB\n" > f
+   printf "Buffers:          102400 kB\nCached:          2048000 kB\nSwapCached:            0 kB\n" > f
+   printf "SwapTotal:       2097152 kB\nSwapFree:        2097152 kB\nShmem:             65536 kB\n" > f
+   printf "SReclaimable:     131072 kB\n" > f
+   close(f)
+
+   printf "1000.00 3500.00\n" > (dir "/uptime")
+   printf "0.50 0.40 0.30 1/%d %d\n", processes * threads, processes + 1 > (dir "/loadavg")
+   printf "4194304\n" > (dir "/sys/kernel/pid_max")
+   printf "1024\t0\t1048576\n" > (dir "/sys/fs/file-nr")
+   f = dir "/diskstats"
+   printf "   7       0 loop0 50 0 400 10 0 0 0 0 0 20 10 0 0 0 0 0 0\n" > f
+   printf "   8       0 sda 1000 0 80000 500 2000 0 160000 1000 0 1500 1500 0 0 0 0 0 0\n" > f
+   printf "   8       1 sda1 900 0 72000 450 1800 0 144000 900 0 1350 1350 0 0 0 0 0 0\n" > f
+   printf "   8       2 sda2 100 0 8000 50 200 0 16000 100 0 150 150 0 0 0 0 0 0\n" > f
+   printf " 259       0 nvme0n1 5000 0 400000 900 8000 0 640000 2000 2 2500 2900 0 0 0 0 100 20\n" > f
+   printf " 259       1 nvme0n1p1 5000 0 400000 900 8000 0 640000 2000 2 2500 2900 0 0 0 0 0 0\n" > f
+   printf " 253       0 dm-0 5000 0 400000 900 8000 0 640000 2000 0 2500 2900 0 0 0 0 0 0\n" > f
+   close(f)
+
+   f = dir "/net/dev"
+   printf "Inter-|   Receive                                                |  Transmit\n" > f
+   printf " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed\n" > f
+   printf "    lo:  100000    1000    0    0    0     0          0         0   100000    1000    0    0    0     0       0          0\n" > f
+   printf "  eth0: 5000000   40000    0    0    0     0          0         0  2000000   20000    0    0    0     0       0          0\n" > f
+   printf " wlan0: 3000000   25000    0    0    0     0          0         0  1000000   12000    0    0    0     0       0          0\n" > f
+   close(f)
+
+   printf "" > (dir "/tty/drivers")
+}'
+
+# Directories of the processes and their threads, PIDs from 1
+awk -v dir="$dir" -v processes="$processes" -v threads="$threads" '
+BEGIN {
+   for (p = 0; p < processes; p++) {
+      pid = 1 + p * threads
+      for (t = 0; t < threads; t++)
+         print dir "/" pid "/task/" (pid + t)
+   }
+}' | xargs mkdir -p
+
+# Per process and per thread files; threads get the same files as their process
+awk -v dir="$dir" -v processes="$processes" -v threads="$threads" -v maps="$maps" -v cgroups="$cgroups" '
+function write(path, comm, pid, tgid, ppid,   f) {
+   f = path "/stat"
+   printf "%d (%s) %s %d %d %d 0 -1 4194560 %d 0 %d 0 %d %d 0 0 20 0 %d 0 %d %d %d 18446744073709551615 0 0 0 0 0 0 0 0 0 0 0 0 17 %d 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+          pid, comm, (pid % 97 == 0) ? "R" : "S", ppid, tgid, tgid, pid * 7 % 10000, pid % 13,
+          pid * 31 % 100000, pid * 11 % 50000, threads, 1000 + pid % 500000,
+          (1000 + pid % 4000) * 4096, 500 + pid % 3000, pid % 4 > f
+   close(f)
+
+   f = path "/statm"
+   printf "%d %d %d %d 0 %d 0\n", 1000 + pid % 4000, 500 + pid % 3000, 200 + pid % 500, 100, 300 + pid % 1000 > f
+   close(f)
+
+   f = path "/status"
+   printf "Name:\t%s\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t%d\nNgid:\t0\nPid:\t%d\nPPid:\t%d\n", comm, tgid, pid, ppid > f
+   printf "Uid:\t0\t0\t0\t0\nGid:\t0\t0\t0\t0\nNSpid:\t%d\nVmRSS:\t%d kB\nVmSwap:\t0 kB\nThreads:\t%d\n", pid, (500 + pid % 3000) * 4, threads > f
+   printf "voluntary_ctxt_switches:\t%d\nnonvoluntary_ctxt_switches:\t%d\n", pid * 3 % 10000, pid % 100 > f
+   close(f)
+
+   f = path "/cmdline"
+   printf "/usr/bin/%s%c--worker%c%d%c", comm, 0, 0, pid, 0 > f
+   close(f)
+
+   f = path "/comm"
+   printf "%s\n", comm > f
+   close(f)
+
+   f = path "/io"
+   printf "rchar: %d\nwchar: %d\nsyscr: %d\nsyscw: %d\nread_bytes: %d\nwrite_bytes: %d\ncancelled_write_bytes: 0\n",
+          pid * 4096, pid * 1024, pid * 4, pid, pid * 512, pid * 256 > f
+   close(f)
+
+   f = path "/cgroup"
+   printf "0::/system.slice/service-%d.service\n", int((tgid - 1) / threads) % cgroups > f
+   close(f)
+
+   printf "0\n" > (path "/oom_score")
+   close(path "/oom_score")
+}
+function writeMaps(path, comm,   f, m, start) {
+   f = path "/maps"
+   for (m = 0; m < maps; m++) {
+      start = 4194304 + m * 65536
+      printf "%08x-%08x r-xp 00000000 08:01 %d                     /usr/lib/lib%s-%d.so\n", start, start + 65536, 1000 + m, comm, m > f
+   }
+   close(f)
+}
+BEGIN {
+   for (p = 0; p < processes; p++) {
+      pid = 1 + p * threads
+      ppid = p == 0 ? 0 : 1 + int((p - 1) / 8) * threads
+      comm = "proc" p
+      write(dir "/" pid, comm, pid, pid, ppid)
+      writeMaps(dir "/" pid, comm)
+      for (t = 0; t < threads; t++)
+         write(dir "/" pid "/task/" (pid + t), comm, pid + t, pid, ppid)
+   }
+}'
+
+# The unified cgroup hierarchy of the processes, mounted as seen by process 1
+mkdir -p "$dir/cgroup/system.slice"
+awk -v dir="$dir" -v root="$(cd "$dir" && pwd)/cgroup" -v processes="$processes" -v threads="$threads" -v cgroups="$cgroups" '
+function write(path, procs, n,   f) {
+   f = path "/cpu.stat"
+   printf "usage_usec %d\nuser_usec %d\nsystem_usec %d\n", n * 3000000, n * 2000000, n * 1000000 > f
+   close(f)
+   f = path "/io.stat"
+   printf "8:0 rbytes=%d wbytes=%d rios=%d wios=%d dbytes=0 dios=0\n", n * 524288, n * 262144, n * 128, n * 64 > f
+   close(f)
+   f = path "/memory.pressure"
+   printf "some avg10=%.2f avg60=0.00 avg300=0.00 total=%d\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n", (n % 7) / 4, n * 1000 > f
+   close(f)
+   printf "%s", procs > (path "/cgroup.procs")
+   close(path "/cgroup.procs")
+}
+BEGIN {
+   printf "30 1 0:26 / %s rw,nosuid,nodev,noexec,relatime shared:4 - cgroup2 cgroup2 rw,nsdelegate\n", root > (dir "/1/mountinfo")
+
+   for (p = 0; p < processes; p++) {
+      pid = 1 + p * threads
+      members[p % cgroups] = members[p % cgroups] pid "\n"
+      count[p % cgroups]++
+   }
+   for (c = 0; c < cgroups; c++) {
+      path = dir "/cgroup/system.slice/service-" c ".service"
+      system("mkdir -p \"" path "\"")
+      write(path, members[c], count[c])
+      printf "%d\n", count[c] * 1048576 > (path "/memory.current")
+      close(path "/memory.current")
+   }
+   write(dir "/cgroup/system.slice", "", processes)
+   printf "%d\n", processes * 1048576 > (dir "/cgroup/system.slice/memory.current")
+   write(dir "/cgroup", "", processes)
+}'
+
+# The process scanning is itself process 1
+ln -s 1 "$dir/self"
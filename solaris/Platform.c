@@ -27,6 +27,7 @@ in the source distribution for its full text.
 #include "CPUMeter.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "SelfMeter.h"
 #include "SwapMeter.h"
 #include "TasksMeter.h"
 #include "LoadAverageMeter.h"
@@ -130,6 +131,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs8Meter_class,
    &ZfsArcMeter_class,
    &ZfsCompressedArcMeter_class,
+   &SelfMeter_class,
    &BlankMeter_class,
    NULL
 };
@@ -142,6 +142,7 @@ const ProcessClass SolarisProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = SolarisProcess_rowWriteField
    },
    .compareByKey = SolarisProcess_compareByKey
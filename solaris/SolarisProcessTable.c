@@ -85,7 +85,7 @@ static void SolarisProcessTable_updateCwd(pid_t pid, Process* proc) {
       return;
 
    target[ret] = '\0';
-   free_and_xStrdup(&proc->procCwd, target);
+   Process_updateCwd(proc, target);
 }
 
 /* Taken from: https://docs.oracle.com/cd/E19253-01/817-6223/6mlkidlom/index.html#tbl-sched-state */
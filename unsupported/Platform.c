@@ -22,6 +22,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "SelfMeter.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
 #include "TasksMeter.h"
@@ -72,6 +73,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
    &FileDescriptorMeter_class,
+   &SelfMeter_class,
    &BlankMeter_class,
    NULL
 };
@@ -106,6 +106,7 @@ const ProcessClass UnsupportedProcess_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
       .sortKeyString = Process_rowGetSortKey,
+      .machineValue = Process_rowMachineValue,
       .writeField = UnsupportedProcess_rowWriteField
    },
    .compareByKey = UnsupportedProcess_compareByKey